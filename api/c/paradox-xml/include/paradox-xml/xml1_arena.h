@@ -0,0 +1,32 @@
+#ifndef PARADOX_SOFTWARE_C_HEADER_XML1_ARENA
+#define PARADOX_SOFTWARE_C_HEADER_XML1_ARENA
+
+#include <paradox-xml/defines.h>
+
+// Chunked bump allocator. Every node and string of a parsed document is carved
+// out of the arena owned by that document and released together with it.
+typedef struct paradox_xml1_arena_chunk
+{
+    struct paradox_xml1_arena_chunk* next;
+    paradox_uint64_t used;
+    paradox_uint64_t capacity;
+
+} paradox_xml1_arena_chunk;
+
+typedef struct paradox_xml1_arena
+{
+    paradox_xml1_arena_chunk* chunks;
+    paradox_uint64_t next_capacity;
+
+} paradox_xml1_arena;
+
+PARADOX_XML_API void paradox_xml1_arena_init(paradox_xml1_arena* arena);
+// Returns 8-byte aligned storage that lives until the arena is freed, or NULL when out of memory.
+PARADOX_XML_API void* paradox_xml1_arena_alloc(paradox_xml1_arena* arena, const paradox_uint64_t size);
+// Copies length bytes of string into the arena and terminates the copy with '\0'.
+PARADOX_XML_API paradox_str_t paradox_xml1_arena_strndup(paradox_xml1_arena* arena, const char* string, const paradox_uint64_t length);
+// Hands every chunk of other over to arena, which releases them together with its own. other is left empty.
+PARADOX_XML_API void paradox_xml1_arena_merge(paradox_xml1_arena* arena, paradox_xml1_arena* other);
+PARADOX_XML_API void paradox_xml1_arena_free(paradox_xml1_arena* arena);
+
+#endif
@@ -1,13 +1,31 @@
 #ifndef PARADOX_SOFTWARE_C_HEADER_XML1_ATTRIBUTE
 #define PARADOX_SOFTWARE_C_HEADER_XML1_ATTRIBUTE
 
-#include <paradox-xml/defines.h>
+#include <paradox-xml/xml1_symbol.h>
 
 typedef struct paradox_xml1_attribute
 {
-    paradox_str_t tag;
-    paradox_str_t value;
-    
+    paradox_xml1_slice tag;
+    // Id of tag in the symbol table of the document.
+    paradox_uint32_t symbol;
+    // Points into the input, with the references of the value written out as in the input while references is set.
+    // paradox_get_xml1_attribute_value decodes them.
+    paradox_xml1_slice value;
+    paradox_bool8_t references;
+    struct paradox_xml1_attribute* next;
+
 } paradox_xml1_attribute;
 
-#endif
\ No newline at end of file
+// Attributes an element is searched one by one for. An element with more gets an attribute index.
+#define PARADOX_XML1_ATTRIBUTE_LINEAR_MAX 8
+
+// The attributes of an element hashed by symbol into a power of two of slots, at most half of them in use.
+typedef struct paradox_xml1_attribute_index
+{
+    paradox_xml1_attribute** slots;
+    // Slots less one.
+    paradox_uint64_t mask;
+
+} paradox_xml1_attribute_index;
+
+#endif
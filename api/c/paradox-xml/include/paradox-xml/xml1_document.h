@@ -2,10 +2,39 @@
 #define PARADOX_SOFTWARE_C_HEADER_XML1_DOCUMENT
 
 #include <paradox-xml/xml1_element.h>
+#include <paradox-xml/xml1_arena.h>
 
+// General and parameter entities declared by the document type declaration of a document.
+typedef struct paradox_xml1_entity_table paradox_xml1_entity_table;
+
+// Names and values slice into the parsed input, which has to outlive the document.
 typedef struct paradox_xml1_document {
     paradox_xml1_element* root;
     paradox_str_t error;
+    // Owns the document itself together with all of its elements, attributes and strings.
+    paradox_xml1_arena arena;
+    // Interns the names of the elements and attributes. The table of the options when they gave one,
+    // or else one of the document's own that goes with it.
+    paradox_xml1_symbol_table* symbols;
+    paradox_bool8_t owns_symbols;
+    // Entities declared by the document type declaration, NULL when the document has none. Elements parsed
+    // from the replacement text of an entity slice into the table, which goes with the document, and attribute
+    // values that refer to entities are expanded from it when they are first read.
+    paradox_xml1_entity_table* entities;
+    // Read-only view of the file the document was parsed from, unmapped together with the document.
+    const void* mapping;
+    paradox_uint64_t mapping_length;
 } paradox_xml1_document;
 
-#endif
\ No newline at end of file
+// The attribute of element, which belongs to document, named by the length bytes of name, or NULL when there is none.
+PARADOX_XML_API const paradox_xml1_attribute* paradox_find_xml1_attribute_by_name(const paradox_xml1_document* document, const paradox_xml1_element* element, const char* name, const paradox_uint64_t length);
+// Store the value of attribute or element, which belong to document, into value with its references decoded.
+// They are decoded when the value is first read, into the arena of the document, and later reads return the same
+// slice. Reading values of one document from several threads at once has to be serialized. Return PARADOX_FALSE
+// when the arena is out of memory.
+PARADOX_XML_API paradox_bool8_t paradox_get_xml1_attribute_value(paradox_xml1_document* document, paradox_xml1_attribute* attribute, paradox_xml1_slice* value);
+PARADOX_XML_API paradox_bool8_t paradox_get_xml1_element_value(paradox_xml1_document* document, paradox_xml1_element* element, paradox_xml1_slice* value);
+// Releases the document and everything allocated from its arena.
+PARADOX_XML_API void paradox_free_xml1_document(paradox_xml1_document* document);
+
+#endif
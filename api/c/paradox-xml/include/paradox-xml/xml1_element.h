@@ -5,11 +5,28 @@
 
 typedef struct paradox_xml1_element
 {
-    paradox_str_t tag;
-    paradox_str_t value;
+    paradox_xml1_slice tag;
+    // Id of tag in the symbol table of the document.
+    paradox_uint32_t symbol;
+    paradox_uint32_t attribute_count;
+    // Character data, CDATA sections and references of the content, empty when there are none. Pieces that follow
+    // each other point into the input; anything else is copied into the arena. While references is set, they are
+    // still written out as in the input and paradox_get_xml1_element_value decodes them.
+    paradox_xml1_slice value;
+    paradox_bool8_t references;
+    // First child element; the remaining children are chained through next.
     struct paradox_xml1_element* children;
+    // First attribute in document order; the remaining ones are chained through next.
     paradox_xml1_attribute* attributes;
+    // NULL for an element with up to PARADOX_XML1_ATTRIBUTE_LINEAR_MAX attributes.
+    paradox_xml1_attribute_index* attribute_index;
+    struct paradox_xml1_element* parent;
+    struct paradox_xml1_element* next;
 
 } paradox_xml1_element;
 
-#endif
\ No newline at end of file
+// The attribute of element whose name has symbol, or NULL when there is none. Costs one probe of the attribute
+// index, or a scan of no more than PARADOX_XML1_ATTRIBUTE_LINEAR_MAX attributes when the element has none.
+PARADOX_XML_API const paradox_xml1_attribute* paradox_find_xml1_attribute(const paradox_xml1_element* element, const paradox_uint32_t symbol);
+
+#endif
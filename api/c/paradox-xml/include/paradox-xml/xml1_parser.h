@@ -2,18 +2,130 @@
 #define PARADOX_SOFTWARE_C_HEADER_XML1_PARSER
 
 #include <paradox-xml/xml1_document.h>
+#include <paradox-xml/xml1_tape.h>
+#include <paradox-xml/xml1_sax.h>
 
 typedef enum paradox_xml1_parser_errno_t {
     PARADOX_XML1_PARSER_SUCCESS,
     PARADOX_XML1_PARSER_NULL_DOCUMENT,
     PARADOX_XML1_PARSER_INVALID_DOCUMENT,
-    PARADOX_XML1_PARSER_NULL_INDEX
+    PARADOX_XML1_PARSER_NULL_INDEX,
+    PARADOX_XML1_PARSER_OUT_OF_MEMORY,
+    PARADOX_XML1_PARSER_FILE_ERROR,
+    PARADOX_XML1_PARSER_ABORTED,
+    // The entity references of the document expanded beyond the budgets of the options.
+    PARADOX_XML1_PARSER_ENTITY_LIMIT
 } paradox_xml1_parser_errno_t;
 
+// Engines of the *_with_options entry points.
+typedef enum paradox_xml1_parse_mode_t {
+    // Recursive descent straight over the input.
+    PARADOX_XML1_PARSE_MODE_RECURSIVE,
+    // A first vectorized pass indexes the characters that delimit markup over the whole input and a
+    // second one walks that index to build the tree or emit the events. Implies validate_input.
+    // Documents with a document type declaration are parsed by the recursive descent instead.
+    // It pays off with a vector kernel set; over the scalar one it runs about as fast as recursive descent.
+    PARADOX_XML1_PARSE_MODE_INDEXED
+} paradox_xml1_parse_mode_t;
+
+// Budgets on the expansion of entity references that zero-initialized options select: the depth entities may be
+// nested to while they are expanded, and the bytes all expansions of a document may add up to.
+#define PARADOX_XML1_PARSER_ENTITY_DEPTH 32
+#define PARADOX_XML1_PARSER_ENTITY_BYTES ((paradox_uint64_t)16 * 1024 * 1024)
+
+// Threads that parse batches of documents, kept alive from one batch to the next.
+typedef struct paradox_xml1_parser_pool paradox_xml1_parser_pool;
+
+// Options of the *_with_options entry points. A NULL pointer or a zero-initialized struct selects the defaults.
+typedef struct paradox_xml1_parser_options
+{
+    // Validates the whole input as UTF-8 made of Char, which also rejects every RestrictedChar, in one
+    // vectorized pass before parsing. The productions then skip their per-character validity checks.
+    paradox_bool8_t validate_input;
+    paradox_xml1_parse_mode_t mode;
+    // Threads paradox_parse_xml1_document_with_options splits the content of the root element across in the
+    // recursive mode, the calling thread included; 0 and 1 keep the whole parse on the calling thread. Only
+    // roots with at least 256 KiB of content per thread are split. Events are always parsed on the calling thread.
+    paradox_uint32_t threads;
+    // Pool paradox_parse_xml1_documents spreads a batch over. Without one, a batch is parsed on threads started
+    // for the call when threads is above 1, or else on the calling thread. Documents of a batch are never split.
+    paradox_xml1_parser_pool* pool;
+    // Symbol table the names of the documents are interned into, so that they share their ids. Without one,
+    // every document and tape interns its names into a table of its own.
+    paradox_xml1_symbol_table* symbols;
+    // Budgets on the expansion of the entities a document declares, against documents whose references expand
+    // exponentially. Every entity is expanded once and its replacement cached, but every reference still counts
+    // the bytes it expands to. 0 selects PARADOX_XML1_PARSER_ENTITY_DEPTH and PARADOX_XML1_PARSER_ENTITY_BYTES.
+    paradox_uint32_t entity_depth;
+    paradox_uint64_t entity_bytes;
+    // Checks the elements against the element type declarations of the document type declaration while the tree is
+    // built or the events are emitted, each child element with one transition of the automaton the content model of
+    // its parent was compiled to. [VC: Root Element Type][VC: Element Valid] Elements of an undeclared type are rejected
+    // unless the document type declaration has declarations that are not read. Documents without one are not checked.
+    paradox_bool8_t validate;
+
+} paradox_xml1_parser_options;
+
+// Outcome of one document of a batch: the document, or NULL and the error it was rejected with.
+typedef struct paradox_xml1_parser_output
+{
+    paradox_xml1_document* document;
+    paradox_xml1_parser_errno_t result;
+
+} paradox_xml1_parser_output;
+
+// Kernel sets of the vectorized scanners, in the order they are preferred in.
+typedef enum paradox_xml1_kernel_t {
+    PARADOX_XML1_KERNEL_SCALAR,
+    PARADOX_XML1_KERNEL_SSE2,
+    PARADOX_XML1_KERNEL_SSE42,
+    PARADOX_XML1_KERNEL_AVX2,
+    PARADOX_XML1_KERNEL_AVX512BW
+} paradox_xml1_kernel_t;
+
+// The kernel set selected for this CPU when the library was loaded, and a printable name for one.
+PARADOX_XML_API paradox_xml1_kernel_t paradox_get_xml1_kernel(void);
+// Selects kernel instead, which tests and benchmarks use to compare the kernel sets. Returns PARADOX_FALSE
+// and keeps the selection when the CPU does not support kernel. Not to be called while a parse runs.
+PARADOX_XML_API paradox_bool8_t paradox_set_xml1_kernel(const paradox_xml1_kernel_t kernel);
+PARADOX_XML_API paradox_str_t paradox_get_xml1_kernel_name(const paradox_xml1_kernel_t kernel);
+
 // Document
 
 // [1] document ::= ( prolog element Misc* ) - ( Char* RestrictedChar Char* )
+// Builds the element tree into an arena owned by the document; release it with paradox_free_xml1_document.
+// Names and values of the tree slice into xml_string, so it has to outlive the document.
 PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_document(paradox_str_t xml_string, paradox_xml1_document** document);
+// Parses exactly length bytes of data, which need not be terminated; the bytes have to outlive the document.
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_document_n(const char* data, const paradox_uint64_t length, paradox_xml1_document** document);
+// Maps the file at path read-only and parses straight from the mapping, which the document keeps alive.
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_file(paradox_str_t path, paradox_xml1_document** document);
+// Parses the document without building a tree and reports its markup through handler instead.
+// Events are emitted as soon as their markup is recognized, so a document found invalid later
+// still produces the events up to that point. Returns PARADOX_XML1_PARSER_ABORTED when a callback stops the parse.
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_events(paradox_str_t xml_string, const paradox_xml1_sax_handler* handler);
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_events_n(const char* data, const paradox_uint64_t length, const paradox_xml1_sax_handler* handler);
+// paradox_parse_xml1_document_n and paradox_parse_xml1_events_n under options.
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_document_with_options(const char* data, const paradox_uint64_t length, const paradox_xml1_parser_options* options, paradox_xml1_document** document);
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_events_with_options(const char* data, const paradox_uint64_t length, const paradox_xml1_parser_options* options, const paradox_xml1_sax_handler* handler);
+// Builds the elements into a tape rather than a tree, from the same parse as the events; release it with
+// paradox_free_xml1_tape. The options apply as they do to the events, so the tape is never split across threads.
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_tape_n(const char* data, const paradox_uint64_t length, paradox_xml1_tape** tape);
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_tape_with_options(const char* data, const paradox_uint64_t length, const paradox_xml1_parser_options* options, paradox_xml1_tape** tape);
+// Parses count documents, each from the bytes an input slices, into the output at the same position. The workers
+// take the documents off the front of their own share of the batch and steal from the back of the others' once
+// theirs is done. Returns PARADOX_XML1_PARSER_SUCCESS when all of them parsed, or the error of the first that did not.
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_documents(const paradox_xml1_slice* inputs, const paradox_uint64_t count, paradox_xml1_parser_output* outputs, const paradox_xml1_parser_options* options);
+// Starts a pool of threads workers for paradox_parse_xml1_documents, the thread that submits a batch included.
+// Batches submitted from several threads at once run one after the other.
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_create_xml1_parser_pool(const paradox_uint32_t threads, paradox_xml1_parser_pool** pool);
+PARADOX_XML_API void paradox_free_xml1_parser_pool(paradox_xml1_parser_pool* pool);
+// Creates a symbol table to share between documents through the options. Documents may be parsed into it from several
+// threads at once, and it may be read from meanwhile: names it holds are found without a lock, only new names are added
+// under one. It keeps its own copies of the names, so it may outlive the documents and their inputs, but they must not
+// outlive it.
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_create_xml1_symbol_table(paradox_xml1_symbol_table** table);
+PARADOX_XML_API void paradox_free_xml1_symbol_table(paradox_xml1_symbol_table* table);
 
 // Character Range
 
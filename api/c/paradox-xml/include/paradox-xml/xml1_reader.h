@@ -0,0 +1,52 @@
+#ifndef PARADOX_SOFTWARE_C_HEADER_XML1_READER
+#define PARADOX_SOFTWARE_C_HEADER_XML1_READER
+
+#include <paradox-xml/xml1_parser.h>
+
+typedef enum paradox_xml1_token_t {
+    PARADOX_XML1_TOKEN_NONE,
+    PARADOX_XML1_TOKEN_START_ELEMENT,
+    PARADOX_XML1_TOKEN_END_ELEMENT,
+    PARADOX_XML1_TOKEN_TEXT,
+    PARADOX_XML1_TOKEN_CDATA,
+    PARADOX_XML1_TOKEN_PROCESSING_INSTRUCTION,
+    PARADOX_XML1_TOKEN_COMMENT,
+    PARADOX_XML1_TOKEN_END_DOCUMENT,
+    PARADOX_XML1_TOKEN_ERROR
+} paradox_xml1_token_t;
+
+// Pull parser walking a document one token at a time. The input has to outlive the reader,
+// slices returned by the accessors stay valid until the next call to paradox_next_xml1_token.
+typedef struct paradox_xml1_reader paradox_xml1_reader;
+
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_create_xml1_reader(const char* data, const paradox_uint64_t length, paradox_xml1_reader** reader);
+// A streaming reader starts out empty and is fed the document chunk by chunk. It keeps the input
+// from the start of the current token on, so slices are also invalidated by the next feed.
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_create_xml1_stream_reader(paradox_xml1_reader** reader);
+// Appends length bytes of data, final marks the last chunk.
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_feed_xml1_reader(paradox_xml1_reader* reader, const char* data, const paradox_uint64_t length, const paradox_bool8_t final);
+PARADOX_XML_API void paradox_free_xml1_reader(paradox_xml1_reader* reader);
+
+// Advances to the next token. An empty element is reported as a start followed by an end,
+// whitespace outside of the root element is skipped. After PARADOX_XML1_TOKEN_ERROR the reader
+// keeps returning it and paradox_get_xml1_reader_error tells why. A streaming reader returns
+// PARADOX_XML1_TOKEN_NONE when it needs the next chunk, and may split text into several tokens.
+// The replacement text of an entity that holds markup is read in place of the reference to it, so
+// text is split where it starts and ends. A reference to an entity that is not read is a text token
+// of its own that keeps the reference as written, like the value of an element does.
+PARADOX_XML_API paradox_xml1_token_t paradox_next_xml1_token(paradox_xml1_reader* reader);
+// Called on a start element, advances to its matching end element without reporting what lies between.
+PARADOX_XML_API paradox_xml1_token_t paradox_skip_xml1_subtree(paradox_xml1_reader* reader);
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_get_xml1_reader_error(const paradox_xml1_reader* reader);
+// Number of elements currently open, including the one of a start element token.
+PARADOX_XML_API paradox_uint64_t paradox_get_xml1_reader_depth(const paradox_xml1_reader* reader);
+
+// Element name of a start or end element, target of a processing instruction.
+PARADOX_XML_API paradox_xml1_slice paradox_get_xml1_reader_name(const paradox_xml1_reader* reader);
+// Decoded text, CDATA content, comment content or processing instruction data.
+PARADOX_XML_API paradox_xml1_slice paradox_get_xml1_reader_text(const paradox_xml1_reader* reader);
+PARADOX_XML_API paradox_uint64_t paradox_get_xml1_reader_attribute_count(const paradox_xml1_reader* reader);
+// Name and decoded value of the attribute at position index of a start element.
+PARADOX_XML_API paradox_bool8_t paradox_get_xml1_reader_attribute(const paradox_xml1_reader* reader, const paradox_uint64_t index, paradox_xml1_slice* name, paradox_xml1_slice* value);
+
+#endif
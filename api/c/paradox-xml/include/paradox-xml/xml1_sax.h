@@ -0,0 +1,27 @@
+#ifndef PARADOX_SOFTWARE_C_HEADER_XML1_SAX
+#define PARADOX_SOFTWARE_C_HEADER_XML1_SAX
+
+#include <paradox-xml/defines.h>
+#include <paradox-xml/xml1_slice.h>
+
+// Callbacks of an event parse, any of which may be NULL. Returning PARADOX_FALSE stops the parse.
+// Slices point into the input, except for decoded references, attribute values holding
+// references and what entities expand to, which are only valid for the duration of the callback.
+typedef struct paradox_xml1_sax_handler
+{
+    void* user_data;
+    paradox_bool8_t (*start_element)(void* user_data, paradox_xml1_slice name);
+    // Follows start_element once per attribute, with references in the value decoded.
+    paradox_bool8_t (*attribute)(void* user_data, paradox_xml1_slice name, paradox_xml1_slice value);
+    paradox_bool8_t (*end_element)(void* user_data, paradox_xml1_slice name);
+    // Called with the character data of the content piece by piece, in document order: a CharData run, a run of
+    // adjacent References decoded together, or the text an entity expands to. Consecutive calls may continue the same
+    // text, so a handler that needs it whole concatenates the pieces up to the next event of another kind.
+    paradox_bool8_t (*char_data)(void* user_data, paradox_xml1_slice text);
+    paradox_bool8_t (*cdata)(void* user_data, paradox_xml1_slice text);
+    paradox_bool8_t (*processing_instruction)(void* user_data, paradox_xml1_slice target, paradox_xml1_slice data);
+    paradox_bool8_t (*comment)(void* user_data, paradox_xml1_slice text);
+
+} paradox_xml1_sax_handler;
+
+#endif
@@ -0,0 +1,15 @@
+#ifndef PARADOX_SOFTWARE_C_HEADER_XML1_SLICE
+#define PARADOX_SOFTWARE_C_HEADER_XML1_SLICE
+
+#include <paradox-xml/defines.h>
+
+// Non-terminated view of length bytes. Slices either point into the parsed
+// input or into the arena of the document when a copy had to be materialized.
+typedef struct paradox_xml1_slice
+{
+    const char* data;
+    paradox_uint64_t length;
+
+} paradox_xml1_slice;
+
+#endif
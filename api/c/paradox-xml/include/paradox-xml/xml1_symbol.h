@@ -0,0 +1,18 @@
+#ifndef PARADOX_SOFTWARE_C_HEADER_XML1_SYMBOL
+#define PARADOX_SOFTWARE_C_HEADER_XML1_SYMBOL
+
+#include <paradox-xml/xml1_slice.h>
+
+// Id of no name, also returned for names a table does not hold.
+#define PARADOX_XML1_SYMBOL_NONE ((paradox_uint32_t)0xFFFFFFFF)
+
+// Interns the element and attribute names of parsed documents: every distinct name is hashed into the table
+// once and gets a dense 32-bit id, so elements and attributes of the same name carry the same symbol.
+typedef struct paradox_xml1_symbol_table paradox_xml1_symbol_table;
+
+// Id of the name of length bytes, or PARADOX_XML1_SYMBOL_NONE when no document put it into the table.
+PARADOX_XML_API paradox_uint32_t paradox_find_xml1_symbol(const paradox_xml1_symbol_table* table, const char* name, const paradox_uint64_t length);
+// Name of symbol, empty for an id the table has not handed out.
+PARADOX_XML_API paradox_xml1_slice paradox_get_xml1_symbol_name(const paradox_xml1_symbol_table* table, const paradox_uint32_t symbol);
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef PARADOX_SOFTWARE_C_HEADER_XML1_TAPE
+#define PARADOX_SOFTWARE_C_HEADER_XML1_TAPE
+
+#include <paradox-xml/xml1_symbol.h>
+#include <paradox-xml/xml1_arena.h>
+
+// Index of no node, for the links a node does not have.
+#define PARADOX_XML1_TAPE_NONE ((paradox_uint32_t)0xFFFFFFFF)
+
+typedef struct paradox_xml1_tape_node
+{
+    paradox_xml1_slice tag;
+    // Text of the element with its references already decoded. The value of a paradox_xml1_element holds the same
+    // text with its references as written until paradox_get_xml1_element_value decodes them.
+    paradox_xml1_slice value;
+    paradox_uint32_t parent;
+    paradox_uint32_t first_child;
+    paradox_uint32_t next_sibling;
+    // The attributes of the node are attribute_count entries of the attribute array from attribute_start on.
+    paradox_uint32_t attribute_start;
+    paradox_uint32_t attribute_count;
+    // Id of tag in the symbol table of the tape.
+    paradox_uint32_t symbol;
+
+} paradox_xml1_tape_node;
+
+typedef struct paradox_xml1_tape_attribute
+{
+    paradox_xml1_slice tag;
+    paradox_xml1_slice value;
+    paradox_uint32_t symbol;
+
+} paradox_xml1_tape_attribute;
+
+// The elements of a document in one array, in document order with the root at index 0, linked by 32-bit
+// indices instead of pointers. A subtree is a contiguous run of nodes, so walking it streams through memory.
+// Names and values slice into the parsed input, which has to outlive the tape, unless an entity replaced them.
+typedef struct paradox_xml1_tape {
+    paradox_xml1_tape_node* nodes;
+    paradox_uint64_t node_count;
+    paradox_xml1_tape_attribute* attributes;
+    paradox_uint64_t attribute_count;
+    // Owns the tape itself together with the values that had to be decoded and what entities replaced.
+    paradox_xml1_arena arena;
+    // Interns the names like the symbol table of a document.
+    paradox_xml1_symbol_table* symbols;
+    paradox_bool8_t owns_symbols;
+} paradox_xml1_tape;
+
+// Releases the tape, its arrays and everything allocated from its arena.
+PARADOX_XML_API void paradox_free_xml1_tape(paradox_xml1_tape* tape);
+
+#endif
@@ -0,0 +1,103 @@
+#include <paradox-xml/xml1_arena.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PARADOX_XML1_ARENA_ALIGNMENT 8
+#define PARADOX_XML1_ARENA_MIN_CHUNK 4096
+#define PARADOX_XML1_ARENA_MAX_CHUNK (1024 * 1024)
+#define PARADOX_XML1_ARENA_HEADER ((sizeof(paradox_xml1_arena_chunk) + 15) & ~(paradox_uint64_t)15)
+
+static paradox_xml1_arena_chunk* paradox_xml1_arena_new_chunk(const paradox_uint64_t capacity)
+{
+    paradox_xml1_arena_chunk* chunk = malloc(PARADOX_XML1_ARENA_HEADER + capacity);
+    if(NULL == chunk) return NULL;
+    chunk->next = NULL;
+    chunk->used = 0;
+    chunk->capacity = capacity;
+    return chunk;
+}
+
+PARADOX_XML_API void paradox_xml1_arena_init(paradox_xml1_arena* arena)
+{
+    if(NULL == arena) return;
+    arena->chunks = NULL;
+    arena->next_capacity = PARADOX_XML1_ARENA_MIN_CHUNK;
+}
+
+PARADOX_XML_API void* paradox_xml1_arena_alloc(paradox_xml1_arena* arena, const paradox_uint64_t size)
+{
+    if(NULL == arena) return NULL;
+    const paradox_uint64_t aligned_size = (size + (PARADOX_XML1_ARENA_ALIGNMENT - 1)) & ~(paradox_uint64_t)(PARADOX_XML1_ARENA_ALIGNMENT - 1);
+
+    paradox_xml1_arena_chunk* chunk = arena->chunks;
+    if(NULL != chunk && chunk->capacity - chunk->used >= aligned_size)
+    {
+        void* memory = (char*)chunk + PARADOX_XML1_ARENA_HEADER + chunk->used;
+        chunk->used += aligned_size;
+        return memory;
+    }
+
+    // Oversized requests get a chunk of their own behind the current one,
+    // so the remaining space of the current chunk is not thrown away.
+    if(aligned_size > arena->next_capacity / 2)
+    {
+        paradox_xml1_arena_chunk* large = paradox_xml1_arena_new_chunk(aligned_size);
+        if(NULL == large) return NULL;
+        large->used = aligned_size;
+        if(NULL != chunk)
+        {
+            large->next = chunk->next;
+            chunk->next = large;
+        }
+        else arena->chunks = large;
+        return (char*)large + PARADOX_XML1_ARENA_HEADER;
+    }
+
+    paradox_xml1_arena_chunk* fresh = paradox_xml1_arena_new_chunk(arena->next_capacity);
+    if(NULL == fresh) return NULL;
+    fresh->next = chunk;
+    fresh->used = aligned_size;
+    arena->chunks = fresh;
+    if(arena->next_capacity < PARADOX_XML1_ARENA_MAX_CHUNK) arena->next_capacity *= 2;
+    return (char*)fresh + PARADOX_XML1_ARENA_HEADER;
+}
+
+PARADOX_XML_API paradox_str_t paradox_xml1_arena_strndup(paradox_xml1_arena* arena, const char* string, const paradox_uint64_t length)
+{
+    if(NULL == string) return NULL;
+    char* copy = paradox_xml1_arena_alloc(arena, length + 1);
+    if(NULL == copy) return NULL;
+    memcpy(copy, string, length);
+    copy[length] = '\0';
+    return copy;
+}
+
+PARADOX_XML_API void paradox_xml1_arena_merge(paradox_xml1_arena* arena, paradox_xml1_arena* other)
+{
+    if(NULL == arena || NULL == other || NULL == other->chunks) return;
+    paradox_xml1_arena_chunk* last = other->chunks;
+    while(NULL != last->next) last = last->next;
+    // The chunks go behind the current one, which keeps serving the allocations of arena.
+    if(NULL != arena->chunks)
+    {
+        last->next = arena->chunks->next;
+        arena->chunks->next = other->chunks;
+    }
+    else arena->chunks = other->chunks;
+    other->chunks = NULL;
+    other->next_capacity = PARADOX_XML1_ARENA_MIN_CHUNK;
+}
+
+PARADOX_XML_API void paradox_xml1_arena_free(paradox_xml1_arena* arena)
+{
+    if(NULL == arena) return;
+    paradox_xml1_arena_chunk* chunk = arena->chunks;
+    while(NULL != chunk)
+    {
+        paradox_xml1_arena_chunk* next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    arena->chunks = NULL;
+    arena->next_capacity = PARADOX_XML1_ARENA_MIN_CHUNK;
+}
@@ -0,0 +1,12 @@
+#ifndef PARADOX_SOFTWARE_C_HEADER_XML1_ATTRIBUTE_INDEX
+#define PARADOX_SOFTWARE_C_HEADER_XML1_ATTRIBUTE_INDEX
+
+#include <paradox-xml/xml1_element.h>
+#include <paradox-xml/xml1_arena.h>
+
+// Counts attribute, which has just been linked at the end of the attributes of element, and indexes it once the
+// element has more than PARADOX_XML1_ATTRIBUTE_LINEAR_MAX. The index is carved out of arena and rebuilt twice as
+// large when it fills up. Returns PARADOX_FALSE when out of memory.
+paradox_bool8_t paradox_xml1_attribute_index_add(paradox_xml1_arena* arena, paradox_xml1_element* element, paradox_xml1_attribute* attribute);
+
+#endif
@@ -0,0 +1,126 @@
+#ifndef PARADOX_SOFTWARE_C_HEADER_XML1_CHARACTERS
+#define PARADOX_SOFTWARE_C_HEADER_XML1_CHARACTERS
+
+#include <paradox-xml/defines.h>
+#include <stddef.h>
+
+// Character classes of the productions [2] Char, [2a] RestrictedChar, [3] S, [4] NameStartChar,
+// [4a] NameChar and [13] PubidChar, looked up together for a code point.
+#define PARADOX_XML1_CHARACTER_CHAR 0x01
+#define PARADOX_XML1_CHARACTER_RESTRICTED 0x02
+#define PARADOX_XML1_CHARACTER_NAME_START 0x04
+#define PARADOX_XML1_CHARACTER_NAME 0x08
+#define PARADOX_XML1_CHARACTER_PUBID 0x10
+#define PARADOX_XML1_CHARACTER_SPACE 0x20
+
+#define PARADOX_XML1_CHARACTER_BLOCKS 11
+
+// Code points are split into blocks of 256. The index maps each block to one of the distinct
+// blocks of classes, the first of which covers [#x0-#xFF] and serves ASCII directly.
+extern const paradox_uint8_t paradox_xml1_character_blocks[PARADOX_XML1_CHARACTER_BLOCKS][256];
+extern const paradox_uint8_t paradox_xml1_character_index[0x1100];
+
+static inline paradox_uint8_t paradox_xml1_classify(const paradox_uint32_t code)
+{
+    if(code < 0x80) return paradox_xml1_character_blocks[0][code];
+    if(code > 0x10FFFF) return 0;
+    return paradox_xml1_character_blocks[paradox_xml1_character_index[code >> 8]][code & 0xFF];
+}
+
+// Decodes the UTF-8 sequence at the start of available bytes. num_bytes is 0 for '\0', malformed
+// or truncated sequences, and continuation bytes are only read while the previous ones were valid.
+static inline paradox_uint32_t paradox_xml1_decode_utf8(const unsigned char* bytes, const paradox_uint64_t available, size_t* num_bytes)
+{
+    *num_bytes = 0;
+    if(0 == available) return 0;
+    const unsigned char lead = bytes[0];
+    if(lead < 0x80)
+    {
+        if(lead) *num_bytes = 1;
+        return lead;
+    }
+    size_t width;
+    paradox_uint32_t code;
+    paradox_uint32_t minimum;
+    if(0xC2 <= lead && lead <= 0xDF)
+    {
+        width = 2;
+        code = lead & 0x1F;
+        minimum = 0x80;
+    }
+    else if(0xE0 == (lead & 0xF0))
+    {
+        width = 3;
+        code = lead & 0x0F;
+        minimum = 0x800;
+    }
+    else if(0xF0 <= lead && lead <= 0xF4)
+    {
+        width = 4;
+        code = lead & 0x07;
+        minimum = 0x10000;
+    }
+    else return 0;
+    if(available < width) return 0;
+    for(size_t i = 1; i < width; i++)
+    {
+        if(0x80 != (bytes[i] & 0xC0)) return 0;
+        code = (code << 6) | (bytes[i] & 0x3F);
+    }
+    if(code < minimum || code > 0x10FFFF || (0xD800 <= code && code <= 0xDFFF)) return 0;
+    *num_bytes = width;
+    return code;
+}
+
+// Decodes a sequence already known to be well-formed, as after paradox_xml1_validate.
+static inline paradox_uint32_t paradox_xml1_decode_utf8_unchecked(const unsigned char* bytes, size_t* num_bytes)
+{
+    const unsigned char lead = bytes[0];
+    if(lead < 0x80)
+    {
+        *num_bytes = 0 != lead;
+        return lead;
+    }
+    if(lead < 0xE0)
+    {
+        *num_bytes = 2;
+        return ((paradox_uint32_t)(lead & 0x1F) << 6) | (bytes[1] & 0x3F);
+    }
+    if(lead < 0xF0)
+    {
+        *num_bytes = 3;
+        return ((paradox_uint32_t)(lead & 0x0F) << 12) | ((paradox_uint32_t)(bytes[1] & 0x3F) << 6) | (bytes[2] & 0x3F);
+    }
+    *num_bytes = 4;
+    return ((paradox_uint32_t)(lead & 0x07) << 18) | ((paradox_uint32_t)(bytes[1] & 0x3F) << 12) | ((paradox_uint32_t)(bytes[2] & 0x3F) << 6) | (bytes[3] & 0x3F);
+}
+
+// Encodes code, a code point up to 0x10FFFF, into output, which must hold 4 bytes. Returns the bytes written.
+static inline paradox_uint64_t paradox_xml1_encode_utf8(const paradox_uint32_t code, char* output)
+{
+    if(code < 0x80)
+    {
+        output[0] = (char)code;
+        return 1;
+    }
+    if(code < 0x800)
+    {
+        output[0] = (char)(0xC0 | (code >> 6));
+        output[1] = (char)(0x80 | (code & 0x3F));
+        return 2;
+    }
+    if(code < 0x10000)
+    {
+        output[0] = (char)(0xE0 | (code >> 12));
+        output[1] = (char)(0x80 | ((code >> 6) & 0x3F));
+        output[2] = (char)(0x80 | (code & 0x3F));
+        return 3;
+    }
+    output[0] = (char)(0xF0 | (code >> 18));
+    output[1] = (char)(0x80 | ((code >> 12) & 0x3F));
+    output[2] = (char)(0x80 | ((code >> 6) & 0x3F));
+    output[3] = (char)(0x80 | (code & 0x3F));
+    return 4;
+}
+
+#endif
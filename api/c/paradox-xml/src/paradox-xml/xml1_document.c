@@ -1 +1,80 @@
-#include <paradox-xml/xml1_document.h>
\ No newline at end of file
+#include <paradox-xml/xml1_document.h>
+#include "xml1_symbols.h"
+#include "xml1_entities.h"
+#include "xml1_references.h"
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+#endif
+
+PARADOX_XML_API const paradox_xml1_attribute* paradox_find_xml1_attribute_by_name(const paradox_xml1_document* document, const paradox_xml1_element* element, const char* name, const paradox_uint64_t length)
+{
+    if(NULL == document || NULL == element) return NULL;
+    const paradox_uint32_t symbol = paradox_find_xml1_symbol(document->symbols, name, length);
+    return PARADOX_XML1_SYMBOL_NONE != symbol ? paradox_find_xml1_attribute(element, symbol) : NULL;
+}
+
+// Replaces the references of value with their replacement, decoded into arena.
+static paradox_bool8_t paradox_xml1_document_decode(paradox_xml1_arena* arena, paradox_xml1_slice* value, paradox_bool8_t* references)
+{
+    if(PARADOX_FALSE == *references) return PARADOX_TRUE;
+    char* decoded = paradox_xml1_arena_alloc(arena, value->length);
+    if(NULL == decoded) return PARADOX_FALSE;
+    value->length = paradox_xml1_decode_value(value->data, value->length, decoded);
+    value->data = decoded;
+    *references = PARADOX_FALSE;
+    return PARADOX_TRUE;
+}
+
+// Replaces the references of value, an attribute value that may refer to the entities of document, with their
+// replacement, expanded into the arena of document. Expanding an entity may add bytes where decoding cannot.
+static paradox_bool8_t paradox_xml1_document_expand(paradox_xml1_document* document, paradox_xml1_slice* value, paradox_bool8_t* references)
+{
+    if(PARADOX_FALSE == *references) return PARADOX_TRUE;
+    const paradox_uint64_t length = paradox_xml1_entities_expand_value(document->entities, value->data, value->length, NULL);
+    char* expanded = paradox_xml1_arena_alloc(&document->arena, length);
+    if(NULL == expanded) return PARADOX_FALSE;
+    value->length = paradox_xml1_entities_expand_value(document->entities, value->data, value->length, expanded);
+    value->data = expanded;
+    *references = PARADOX_FALSE;
+    return PARADOX_TRUE;
+}
+
+PARADOX_XML_API paradox_bool8_t paradox_get_xml1_attribute_value(paradox_xml1_document* document, paradox_xml1_attribute* attribute, paradox_xml1_slice* value)
+{
+    if(NULL == document || NULL == attribute || NULL == value) return PARADOX_FALSE;
+    const paradox_bool8_t decoded = NULL != document->entities
+        ?   paradox_xml1_document_expand(document, &attribute->value, &attribute->references)
+        :   paradox_xml1_document_decode(&document->arena, &attribute->value, &attribute->references);
+    if(PARADOX_FALSE == decoded) return PARADOX_FALSE;
+    *value = attribute->value;
+    return PARADOX_TRUE;
+}
+
+PARADOX_XML_API paradox_bool8_t paradox_get_xml1_element_value(paradox_xml1_document* document, paradox_xml1_element* element, paradox_xml1_slice* value)
+{
+    if(NULL == document || NULL == element || NULL == value) return PARADOX_FALSE;
+    if(PARADOX_FALSE == paradox_xml1_document_decode(&document->arena, &element->value, &element->references)) return PARADOX_FALSE;
+    *value = element->value;
+    return PARADOX_TRUE;
+}
+
+PARADOX_XML_API void paradox_free_xml1_document(paradox_xml1_document* document)
+{
+    if(NULL == document) return;
+    if(PARADOX_TRUE == document->owns_symbols) paradox_xml1_symbols_free(document->symbols);
+    paradox_xml1_entities_free(document->entities);
+    const void* mapping = document->mapping;
+    const paradox_uint64_t mapping_length = document->mapping_length;
+    // The document lives inside its own arena, so copy the arena out before releasing it.
+    paradox_xml1_arena arena = document->arena;
+    paradox_xml1_arena_free(&arena);
+    if(NULL == mapping) return;
+#ifdef _WIN32
+    (void)mapping_length;
+    UnmapViewOfFile(mapping);
+#else
+    munmap((void*)mapping, (size_t)mapping_length);
+#endif
+}
@@ -1,2 +1,57 @@
 #include <paradox-xml/xml1_element.h>
+#include "xml1_attribute_index.h"
 
+// Symbols are dense ids, so a multiply spreads neighbouring ones over the slots.
+static inline paradox_uint64_t paradox_xml1_attribute_index_slot(const paradox_uint32_t symbol, const paradox_uint64_t mask)
+{
+    return ((paradox_uint64_t)symbol * 0x9E3779B97F4A7C15ULL >> 32) & mask;
+}
+
+static void paradox_xml1_attribute_index_put(paradox_xml1_attribute_index* index, paradox_xml1_attribute* attribute)
+{
+    paradox_uint64_t slot = paradox_xml1_attribute_index_slot(attribute->symbol, index->mask);
+    while(NULL != index->slots[slot]) slot = (slot + 1) & index->mask;
+    index->slots[slot] = attribute;
+}
+
+paradox_bool8_t paradox_xml1_attribute_index_add(paradox_xml1_arena* arena, paradox_xml1_element* element, paradox_xml1_attribute* attribute)
+{
+    element->attribute_count++;
+    if(element->attribute_count <= PARADOX_XML1_ATTRIBUTE_LINEAR_MAX) return PARADOX_TRUE;
+    paradox_xml1_attribute_index* index = element->attribute_index;
+    if(NULL != index && element->attribute_count * 2 <= index->mask + 1)
+    {
+        paradox_xml1_attribute_index_put(index, attribute);
+        return PARADOX_TRUE;
+    }
+
+    // The first index and every one that outgrew the last are built from the list, which already holds attribute.
+    paradox_uint64_t slots = NULL != index ? (index->mask + 1) * 2 : 4 * PARADOX_XML1_ATTRIBUTE_LINEAR_MAX;
+    index = paradox_xml1_arena_alloc(arena, sizeof(paradox_xml1_attribute_index) + slots * sizeof(paradox_xml1_attribute*));
+    if(NULL == index) return PARADOX_FALSE;
+    index->slots = (paradox_xml1_attribute**)(index + 1);
+    index->mask = slots - 1;
+    for(paradox_uint64_t slot = 0; slot < slots; slot++) index->slots[slot] = NULL;
+    for(paradox_xml1_attribute* indexed = element->attributes; NULL != indexed; indexed = indexed->next) paradox_xml1_attribute_index_put(index, indexed);
+    element->attribute_index = index;
+    return PARADOX_TRUE;
+}
+
+PARADOX_XML_API const paradox_xml1_attribute* paradox_find_xml1_attribute(const paradox_xml1_element* element, const paradox_uint32_t symbol)
+{
+    if(NULL == element) return NULL;
+    const paradox_xml1_attribute_index* index = element->attribute_index;
+    if(NULL == index)
+    {
+        for(const paradox_xml1_attribute* attribute = element->attributes; NULL != attribute; attribute = attribute->next)
+        {
+            if(attribute->symbol == symbol) return attribute;
+        }
+        return NULL;
+    }
+    for(paradox_uint64_t slot = paradox_xml1_attribute_index_slot(symbol, index->mask);; slot = (slot + 1) & index->mask)
+    {
+        const paradox_xml1_attribute* attribute = index->slots[slot];
+        if(NULL == attribute || attribute->symbol == symbol) return attribute;
+    }
+}
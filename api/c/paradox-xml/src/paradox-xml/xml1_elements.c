@@ -0,0 +1,331 @@
+#include "xml1_elements.h"
+#include "xml1_symbols.h"
+#include "xml1_scanner.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Slot of the element type named name: the one holding its id plus one, or the empty one it would be put into.
+static inline paradox_uint64_t paradox_xml1_elements_slot(const paradox_xml1_element_table* table, const char* name, const paradox_uint64_t length, const paradox_uint64_t hash)
+{
+    const paradox_uint64_t mask = table->slot_count - 1;
+    for(paradox_uint64_t slot = hash & mask;; slot = (slot + 1) & mask)
+    {
+        const paradox_uint32_t entry = table->slots[slot];
+        if(0 == entry) return slot;
+        const paradox_xml1_element_type* type = &table->types[entry - 1];
+        if(type->hash == hash && type->name.length == length && PARADOX_TRUE == paradox_xml1_symbols_equal(type->name.data, name, length)) return slot;
+    }
+}
+
+// Doubles the slots once they are half full.
+static paradox_bool8_t paradox_xml1_elements_rehash(paradox_xml1_element_table* table)
+{
+    const paradox_uint64_t slot_count = table->slot_count ? table->slot_count * 2 : 16;
+    paradox_uint32_t* slots = calloc(slot_count, sizeof(paradox_uint32_t));
+    if(NULL == slots) return PARADOX_FALSE;
+    free(table->slots);
+    table->slots = slots;
+    table->slot_count = slot_count;
+    for(paradox_uint64_t i = 0; i < table->count; i++)
+    {
+        const paradox_xml1_element_type* type = &table->types[i];
+        table->slots[paradox_xml1_elements_slot(table, type->name.data, type->name.length, type->hash)] = (paradox_uint32_t)i + 1;
+    }
+    return PARADOX_TRUE;
+}
+
+paradox_xml1_element_table* paradox_xml1_elements_create(void)
+{
+    paradox_xml1_element_table* table = calloc(1, sizeof(paradox_xml1_element_table));
+    if(NULL == table) return NULL;
+    paradox_xml1_arena_init(&table->arena);
+    table->root = PARADOX_XML1_ELEMENTS_NONE;
+    return table;
+}
+
+void paradox_xml1_elements_free(paradox_xml1_element_table* table)
+{
+    if(NULL == table) return;
+    paradox_xml1_arena_free(&table->arena);
+    free(table->types);
+    free(table->slots);
+    free(table->accepting);
+    free(table->keys);
+    free(table->targets);
+    free(table->particles);
+    free(table);
+}
+
+paradox_uint32_t paradox_xml1_elements_intern(paradox_xml1_element_table* table, const char* name, const paradox_uint64_t length)
+{
+    const paradox_uint64_t hash = paradox_xml1_symbols_hash(name, length);
+    paradox_uint64_t slot = 0;
+    if(0 != table->slot_count)
+    {
+        slot = paradox_xml1_elements_slot(table, name, length, hash);
+        if(0 != table->slots[slot]) return table->slots[slot] - 1;
+    }
+    if(table->count >= PARADOX_XML1_ELEMENTS_NONE - 1) return PARADOX_XML1_ELEMENTS_NONE;
+    if(table->count == table->capacity)
+    {
+        const paradox_uint64_t capacity = table->capacity ? table->capacity * 2 : 16;
+        paradox_xml1_element_type* types = realloc(table->types, capacity * sizeof(paradox_xml1_element_type));
+        if(NULL == types) return PARADOX_XML1_ELEMENTS_NONE;
+        table->types = types;
+        table->capacity = capacity;
+    }
+    if((table->count + 1) * 2 > table->slot_count)
+    {
+        if(PARADOX_FALSE == paradox_xml1_elements_rehash(table)) return PARADOX_XML1_ELEMENTS_NONE;
+        slot = paradox_xml1_elements_slot(table, name, length, hash);
+    }
+
+    paradox_xml1_element_type* type = &table->types[table->count];
+    memset(type, 0, sizeof(paradox_xml1_element_type));
+    type->name.data = paradox_xml1_arena_strndup(&table->arena, name, length);
+    if(NULL == type->name.data) return PARADOX_XML1_ELEMENTS_NONE;
+    type->name.length = length;
+    type->hash = hash;
+    type->start = PARADOX_XML1_ELEMENTS_NONE;
+    table->slots[slot] = (paradox_uint32_t)++table->count;
+    return (paradox_uint32_t)table->count - 1;
+}
+
+paradox_uint32_t paradox_xml1_elements_find(const paradox_xml1_element_table* table, const char* name, const paradox_uint64_t length)
+{
+    if(0 == table->slot_count) return PARADOX_XML1_ELEMENTS_NONE;
+    const paradox_uint64_t slot = paradox_xml1_elements_slot(table, name, length, paradox_xml1_symbols_hash(name, length));
+    return 0 != table->slots[slot] ? table->slots[slot] - 1 : PARADOX_XML1_ELEMENTS_NONE;
+}
+
+paradox_uint32_t paradox_xml1_elements_add_particle(paradox_xml1_element_table* table, const paradox_xml1_particle_t kind, const paradox_uint32_t type)
+{
+    if(table->particle_count >= PARADOX_XML1_ELEMENTS_NONE - 1) return PARADOX_XML1_ELEMENTS_NONE;
+    if(table->particle_count == table->particle_capacity)
+    {
+        const paradox_uint64_t capacity = table->particle_capacity ? table->particle_capacity * 2 : 16;
+        paradox_xml1_particle* particles = realloc(table->particles, capacity * sizeof(paradox_xml1_particle));
+        if(NULL == particles) return PARADOX_XML1_ELEMENTS_NONE;
+        table->particles = particles;
+        table->particle_capacity = capacity;
+    }
+    paradox_xml1_particle* particle = &table->particles[table->particle_count];
+    particle->kind = kind;
+    particle->occurrence = '\0';
+    particle->type = type;
+    particle->first = PARADOX_XML1_ELEMENTS_NONE;
+    particle->next = PARADOX_XML1_ELEMENTS_NONE;
+    return (paradox_uint32_t)table->particle_count++;
+}
+
+// Appends count states that do not accept yet and returns the first, or PARADOX_XML1_ELEMENTS_NONE when out of memory.
+static paradox_uint32_t paradox_xml1_elements_add_states(paradox_xml1_element_table* table, const paradox_uint64_t count)
+{
+    if(count >= PARADOX_XML1_ELEMENTS_NONE - table->state_count) return PARADOX_XML1_ELEMENTS_NONE;
+    if(table->state_count + count > table->state_capacity)
+    {
+        paradox_uint64_t capacity = table->state_capacity ? table->state_capacity : 16;
+        while(capacity < table->state_count + count) capacity *= 2;
+        paradox_bool8_t* accepting = realloc(table->accepting, capacity * sizeof(paradox_bool8_t));
+        if(NULL == accepting) return PARADOX_XML1_ELEMENTS_NONE;
+        table->accepting = accepting;
+        table->state_capacity = capacity;
+    }
+    memset(table->accepting + table->state_count, PARADOX_FALSE, count * sizeof(paradox_bool8_t));
+    const paradox_uint32_t first = (paradox_uint32_t)table->state_count;
+    table->state_count += count;
+    return first;
+}
+
+// Doubles the transition slots once they are half full. Free slots hold PARADOX_XML1_ELEMENTS_NO_KEY.
+static paradox_bool8_t paradox_xml1_elements_rehash_transitions(paradox_xml1_element_table* table)
+{
+    const paradox_uint64_t slot_count = table->transition_slot_count ? table->transition_slot_count * 2 : 64;
+    paradox_uint64_t* keys = malloc(slot_count * sizeof(paradox_uint64_t));
+    paradox_uint32_t* targets = malloc(slot_count * sizeof(paradox_uint32_t));
+    if(NULL == keys || NULL == targets)
+    {
+        free(keys);
+        free(targets);
+        return PARADOX_FALSE;
+    }
+    memset(keys, 0xFF, slot_count * sizeof(paradox_uint64_t));
+    const paradox_uint64_t mask = slot_count - 1;
+    for(paradox_uint64_t i = 0; i < table->transition_slot_count; i++)
+    {
+        if(PARADOX_XML1_ELEMENTS_NO_KEY == table->keys[i]) continue;
+        paradox_uint64_t slot = paradox_xml1_elements_transition_slot(table->keys[i], mask);
+        while(PARADOX_XML1_ELEMENTS_NO_KEY != keys[slot]) slot = (slot + 1) & mask;
+        keys[slot] = table->keys[i];
+        targets[slot] = table->targets[i];
+    }
+    free(table->keys);
+    free(table->targets);
+    table->keys = keys;
+    table->targets = targets;
+    table->transition_slot_count = slot_count;
+    return PARADOX_TRUE;
+}
+
+// Adds the transition from state on type to target, unless state already has one on type, which a deterministic
+// automaton cannot have.
+static paradox_xml1_parser_errno_t paradox_xml1_elements_add_transition(paradox_xml1_element_table* table, const paradox_uint32_t state, const paradox_uint32_t type, const paradox_uint32_t target)
+{
+    if((table->transition_count + 1) * 2 > table->transition_slot_count && PARADOX_FALSE == paradox_xml1_elements_rehash_transitions(table)) return PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+    const paradox_uint64_t key = ((paradox_uint64_t)state << 32) | type;
+    const paradox_uint64_t mask = table->transition_slot_count - 1;
+    paradox_uint64_t slot = paradox_xml1_elements_transition_slot(key, mask);
+    for(; PARADOX_XML1_ELEMENTS_NO_KEY != table->keys[slot]; slot = (slot + 1) & mask)
+    {
+        if(key == table->keys[slot]) return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+    }
+    table->keys[slot] = key;
+    table->targets[slot] = target;
+    table->transition_count++;
+    return PARADOX_XML1_PARSER_SUCCESS;
+}
+
+// Adds the transitions from state to the state of every position of the words-long set positions, each on the type
+// of its name.
+static paradox_xml1_parser_errno_t paradox_xml1_elements_add_transitions(paradox_xml1_element_table* table, const paradox_uint32_t state, const paradox_uint64_t* positions, const paradox_uint64_t words, const paradox_uint32_t* types, const paradox_uint32_t first_state)
+{
+    for(paradox_uint64_t word = 0; word < words; word++)
+    {
+        for(paradox_uint64_t bits = positions[word]; 0 != bits; bits &= bits - 1)
+        {
+            const paradox_uint64_t position = word * 64 + paradox_xml1_scanner_first_bit(bits);
+            const paradox_xml1_parser_errno_t result = paradox_xml1_elements_add_transition(table, state, types[position], first_state + (paradox_uint32_t)position);
+            if(PARADOX_XML1_PARSER_SUCCESS != result) return result;
+        }
+    }
+    return PARADOX_XML1_PARSER_SUCCESS;
+}
+
+// ORs the words-long set from into every follow set of a position of the set last.
+static inline void paradox_xml1_elements_follow(paradox_uint64_t* follow, const paradox_uint64_t* last, const paradox_uint64_t* from, const paradox_uint64_t words)
+{
+    for(paradox_uint64_t word = 0; word < words; word++)
+    {
+        for(paradox_uint64_t bits = last[word]; 0 != bits; bits &= bits - 1)
+        {
+            paradox_uint64_t* set = follow + (word * 64 + paradox_xml1_scanner_first_bit(bits)) * words;
+            for(paradox_uint64_t i = 0; i < words; i++) set[i] |= from[i];
+        }
+    }
+}
+
+// The position automaton of the children content model held by the particles. Every name is a position. Walking the
+// particles backwards meets the particles of a group before the group, so each gets whether it matches nothing, the
+// positions it may start and end with, and what may follow each position inside it, from those it holds.
+static paradox_xml1_parser_errno_t paradox_xml1_elements_compile_children(paradox_xml1_element_table* table, paradox_xml1_element_type* type)
+{
+    const paradox_xml1_particle* particles = table->particles;
+    const paradox_uint64_t count = table->particle_count;
+    paradox_uint64_t positions = 0;
+    for(paradox_uint64_t i = 0; i < count; i++) if(PARADOX_XML1_PARTICLE_NAME == particles[i].kind) positions++;
+    const paradox_uint64_t words = (positions + 63) / 64;
+
+    paradox_xml1_parser_errno_t result = PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+    paradox_uint32_t* position_of = malloc(count * sizeof(paradox_uint32_t));
+    paradox_uint32_t* types = malloc(positions * sizeof(paradox_uint32_t));
+    paradox_bool8_t* nullable = malloc(count * sizeof(paradox_bool8_t));
+    paradox_uint64_t* first = calloc(count * words, sizeof(paradox_uint64_t));
+    paradox_uint64_t* last = calloc(count * words, sizeof(paradox_uint64_t));
+    paradox_uint64_t* follow = calloc(positions * words, sizeof(paradox_uint64_t));
+    if(NULL == position_of || NULL == types || NULL == nullable || NULL == first || NULL == last || NULL == follow) goto FREE;
+
+    for(paradox_uint64_t i = 0, position = 0; i < count; i++)
+    {
+        if(PARADOX_XML1_PARTICLE_NAME != particles[i].kind) continue;
+        position_of[i] = (paradox_uint32_t)position;
+        types[position++] = particles[i].type;
+    }
+    for(paradox_uint64_t i = count; i-- > 0;)
+    {
+        const paradox_xml1_particle* particle = &particles[i];
+        paradox_uint64_t* particle_first = first + i * words;
+        paradox_uint64_t* particle_last = last + i * words;
+        if(PARADOX_XML1_PARTICLE_NAME == particle->kind)
+        {
+            nullable[i] = PARADOX_FALSE;
+            particle_first[position_of[i] / 64] |= (paradox_uint64_t)1 << (position_of[i] % 64);
+            particle_last[position_of[i] / 64] |= (paradox_uint64_t)1 << (position_of[i] % 64);
+        }
+        else if(PARADOX_XML1_PARTICLE_CHOICE == particle->kind)
+        {
+            nullable[i] = PARADOX_FALSE;
+            for(paradox_uint32_t child = particle->first; PARADOX_XML1_ELEMENTS_NONE != child; child = particles[child].next)
+            {
+                if(PARADOX_TRUE == nullable[child]) nullable[i] = PARADOX_TRUE;
+                for(paradox_uint64_t word = 0; word < words; word++)
+                {
+                    particle_first[word] |= first[child * words + word];
+                    particle_last[word] |= last[child * words + word];
+                }
+            }
+        }
+        else
+        {
+            // The last positions of the particles so far may be followed by the first of the next one, and stay last
+            // as long as the particles after them match nothing.
+            nullable[i] = PARADOX_TRUE;
+            for(paradox_uint32_t child = particle->first; PARADOX_XML1_ELEMENTS_NONE != child; child = particles[child].next)
+            {
+                paradox_xml1_elements_follow(follow, particle_last, first + child * words, words);
+                for(paradox_uint64_t word = 0; word < words; word++)
+                {
+                    if(PARADOX_TRUE == nullable[i]) particle_first[word] |= first[child * words + word];
+                    particle_last[word] = (PARADOX_TRUE == nullable[child] ? particle_last[word] : 0) | last[child * words + word];
+                }
+                if(PARADOX_FALSE == nullable[child]) nullable[i] = PARADOX_FALSE;
+            }
+        }
+        if('?' == particle->occurrence || '*' == particle->occurrence) nullable[i] = PARADOX_TRUE;
+        if('*' == particle->occurrence || '+' == particle->occurrence) paradox_xml1_elements_follow(follow, particle_last, particle_first, words);
+    }
+
+    // The start state, then one state per position, which accepts when the position may end the content.
+    type->start = paradox_xml1_elements_add_states(table, positions + 1);
+    if(PARADOX_XML1_ELEMENTS_NONE == type->start) goto FREE;
+    table->accepting[type->start] = nullable[0];
+    for(paradox_uint64_t position = 0; position < positions; position++)
+    {
+        if(0 != (last[position / 64] & ((paradox_uint64_t)1 << (position % 64)))) table->accepting[type->start + 1 + position] = PARADOX_TRUE;
+    }
+    result = paradox_xml1_elements_add_transitions(table, type->start, first, words, types, type->start + 1);
+    for(paradox_uint64_t position = 0; PARADOX_XML1_PARSER_SUCCESS == result && position < positions; position++)
+    {
+        result = paradox_xml1_elements_add_transitions(table, type->start + 1 + (paradox_uint32_t)position, follow + position * words, words, types, type->start + 1);
+    }
+
+    FREE:
+    free(position_of);
+    free(types);
+    free(nullable);
+    free(first);
+    free(last);
+    free(follow);
+    return result;
+}
+
+paradox_xml1_parser_errno_t paradox_xml1_elements_compile(paradox_xml1_element_table* table, const paradox_uint32_t type, const paradox_xml1_content_t content)
+{
+    paradox_xml1_element_type* declared = &table->types[type];
+    paradox_xml1_parser_errno_t result = PARADOX_XML1_PARSER_SUCCESS;
+    declared->declared = PARADOX_TRUE;
+    declared->content = content;
+    if(PARADOX_XML1_CONTENT_MIXED == content)
+    {
+        // (#PCDATA | Name)* is a single accepting state that takes every name it lists.
+        declared->start = paradox_xml1_elements_add_states(table, 1);
+        if(PARADOX_XML1_ELEMENTS_NONE == declared->start) result = PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+        else table->accepting[declared->start] = PARADOX_TRUE;
+        for(paradox_uint64_t i = 0; PARADOX_XML1_PARSER_SUCCESS == result && i < table->particle_count; i++)
+        {
+            result = paradox_xml1_elements_add_transition(table, declared->start, table->particles[i].type, declared->start);
+        }
+    }
+    else if(PARADOX_XML1_CONTENT_CHILDREN == content) result = paradox_xml1_elements_compile_children(table, declared);
+    table->particle_count = 0;
+    return result;
+}
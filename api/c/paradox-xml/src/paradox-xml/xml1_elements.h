@@ -0,0 +1,118 @@
+#ifndef PARADOX_SOFTWARE_C_HEADER_XML1_ELEMENTS
+#define PARADOX_SOFTWARE_C_HEADER_XML1_ELEMENTS
+
+#include <paradox-xml/xml1_parser.h>
+#include <paradox-xml/xml1_arena.h>
+
+// Id of no element type and no state, for names nothing declared and for transitions an automaton does not have.
+#define PARADOX_XML1_ELEMENTS_NONE ((paradox_uint32_t)0xFFFFFFFF)
+// Key of the transition from no state on no type, which marks a free slot of the transitions.
+#define PARADOX_XML1_ELEMENTS_NO_KEY ((paradox_uint64_t)0xFFFFFFFFFFFFFFFF)
+
+typedef enum paradox_xml1_content_t {
+    PARADOX_XML1_CONTENT_EMPTY,
+    PARADOX_XML1_CONTENT_ANY,
+    PARADOX_XML1_CONTENT_MIXED,
+    PARADOX_XML1_CONTENT_CHILDREN
+} paradox_xml1_content_t;
+
+typedef struct paradox_xml1_element_type
+{
+    paradox_xml1_slice name;
+    paradox_uint64_t hash;
+    // Set by the elementdecl of the type. Types that are only named by content models or the doctypedecl have none.
+    paradox_bool8_t declared;
+    paradox_xml1_content_t content;
+    // State the automaton of a Mixed or children content model starts the content of an element in.
+    paradox_uint32_t start;
+
+} paradox_xml1_element_type;
+
+typedef enum paradox_xml1_particle_t {
+    PARADOX_XML1_PARTICLE_NAME,
+    PARADOX_XML1_PARTICLE_SEQUENCE,
+    PARADOX_XML1_PARTICLE_CHOICE
+} paradox_xml1_particle_t;
+
+// A cp of a content model. Every group comes ahead of the particles it holds, which are linked in the order they are written.
+typedef struct paradox_xml1_particle
+{
+    paradox_xml1_particle_t kind;
+    // '?', '*', '+', or '\0' for a particle that occurs once.
+    paradox_char8_t occurrence;
+    // Element type of a name.
+    paradox_uint32_t type;
+    // The first particle of a group and the particle after this one in its own group, or PARADOX_XML1_ELEMENTS_NONE.
+    paradox_uint32_t first;
+    paradox_uint32_t next;
+
+} paradox_xml1_particle;
+
+typedef struct paradox_xml1_element_table
+{
+    // Element types in the order they were first named.
+    paradox_xml1_element_type* types;
+    paradox_uint64_t count;
+    paradox_uint64_t capacity;
+    // Open addressing over the hashes of the names, like the entity table.
+    paradox_uint32_t* slots;
+    paradox_uint64_t slot_count;
+    // States of the automata of all content models and whether each of them may end the content of an element.
+    paradox_bool8_t* accepting;
+    paradox_uint64_t state_count;
+    paradox_uint64_t state_capacity;
+    // Transitions of all automata, open addressing over the state they leave and the element type they take.
+    // A key holds both, a target the state the transition enters.
+    paradox_uint64_t* keys;
+    paradox_uint32_t* targets;
+    paradox_uint64_t transition_count;
+    paradox_uint64_t transition_slot_count;
+    // Particles of the content model being declared, which paradox_xml1_elements_compile consumes.
+    paradox_xml1_particle* particles;
+    paradox_uint64_t particle_count;
+    paradox_uint64_t particle_capacity;
+    // Copies of the names.
+    paradox_xml1_arena arena;
+    // Type named by the doctypedecl. [VC: Root Element Type]
+    paradox_uint32_t root;
+
+} paradox_xml1_element_table;
+
+// Returns NULL when out of memory.
+paradox_xml1_element_table* paradox_xml1_elements_create(void);
+void paradox_xml1_elements_free(paradox_xml1_element_table* table);
+// Id of the element type named by the length bytes of name, added undeclared when it is new.
+// Returns PARADOX_XML1_ELEMENTS_NONE when out of memory.
+paradox_uint32_t paradox_xml1_elements_intern(paradox_xml1_element_table* table, const char* name, const paradox_uint64_t length);
+// Id of the element type named by the length bytes of name, or PARADOX_XML1_ELEMENTS_NONE when nothing named it.
+paradox_uint32_t paradox_xml1_elements_find(const paradox_xml1_element_table* table, const char* name, const paradox_uint64_t length);
+// Appends a particle that occurs once and holds nothing yet. Returns its index, or PARADOX_XML1_ELEMENTS_NONE when out of memory.
+paradox_uint32_t paradox_xml1_elements_add_particle(paradox_xml1_element_table* table, const paradox_xml1_particle_t kind, const paradox_uint32_t type);
+// Declares type with content and compiles the particles into its automaton: the names of a Mixed content model, or
+// the cp of a children content model starting with its outermost group. A children content model becomes the position
+// automaton of its expression, with a state per name, which is deterministic as the content model has to be. Consumes
+// the particles. Returns PARADOX_XML1_PARSER_INVALID_DOCUMENT for a content model that is not deterministic or that
+// names a type twice in Mixed content. [E: Deterministic Content Models][VC: No Duplicate Types]
+paradox_xml1_parser_errno_t paradox_xml1_elements_compile(paradox_xml1_element_table* table, const paradox_uint32_t type, const paradox_xml1_content_t content);
+
+static inline paradox_uint64_t paradox_xml1_elements_transition_slot(const paradox_uint64_t key, const paradox_uint64_t mask)
+{
+    const paradox_uint64_t hash = key * 0x9E3779B97F4A7C15ULL;
+    return (hash ^ (hash >> 32)) & mask;
+}
+
+// The state the automaton enters from state on a child of type, or PARADOX_XML1_ELEMENTS_NONE when the content model
+// does not allow one there. One probe of the transitions per child element.
+static inline paradox_uint32_t paradox_xml1_elements_next(const paradox_xml1_element_table* table, const paradox_uint32_t state, const paradox_uint32_t type)
+{
+    if(0 == table->transition_slot_count) return PARADOX_XML1_ELEMENTS_NONE;
+    const paradox_uint64_t key = ((paradox_uint64_t)state << 32) | type;
+    const paradox_uint64_t mask = table->transition_slot_count - 1;
+    for(paradox_uint64_t slot = paradox_xml1_elements_transition_slot(key, mask);; slot = (slot + 1) & mask)
+    {
+        if(key == table->keys[slot]) return table->targets[slot];
+        if(PARADOX_XML1_ELEMENTS_NO_KEY == table->keys[slot]) return PARADOX_XML1_ELEMENTS_NONE;
+    }
+}
+
+#endif
@@ -0,0 +1,147 @@
+#include "xml1_entities.h"
+#include "xml1_symbols.h"
+#include "xml1_references.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Slot of the entity named name: the one holding its index, or the empty one it would be put into.
+// General and parameter entities share the slots but not their names.
+static inline paradox_uint64_t paradox_xml1_entities_slot(const paradox_xml1_entity_table* table, const char* name, const paradox_uint64_t length, const paradox_uint64_t hash, const paradox_bool8_t parameter)
+{
+    const paradox_uint64_t mask = table->slot_count - 1;
+    for(paradox_uint64_t slot = hash & mask;; slot = (slot + 1) & mask)
+    {
+        const paradox_uint32_t entry = table->slots[slot];
+        if(0 == entry) return slot;
+        const paradox_xml1_entity* entity = &table->entities[entry - 1];
+        if(entity->hash == hash && entity->parameter == parameter && entity->name.length == length && PARADOX_TRUE == paradox_xml1_symbols_equal(entity->name.data, name, length)) return slot;
+    }
+}
+
+// Doubles the slots once they are half full.
+static paradox_bool8_t paradox_xml1_entities_rehash(paradox_xml1_entity_table* table)
+{
+    const paradox_uint64_t slot_count = table->slot_count ? table->slot_count * 2 : 16;
+    paradox_uint32_t* slots = calloc(slot_count, sizeof(paradox_uint32_t));
+    if(NULL == slots) return PARADOX_FALSE;
+    free(table->slots);
+    table->slots = slots;
+    table->slot_count = slot_count;
+    for(paradox_uint64_t i = 0; i < table->count; i++)
+    {
+        const paradox_xml1_entity* entity = &table->entities[i];
+        table->slots[paradox_xml1_entities_slot(table, entity->name.data, entity->name.length, entity->hash, entity->parameter)] = (paradox_uint32_t)i + 1;
+    }
+    return PARADOX_TRUE;
+}
+
+paradox_xml1_entity_table* paradox_xml1_entities_create(const paradox_uint64_t depth_limit, const paradox_uint64_t byte_limit)
+{
+    paradox_xml1_entity_table* table = calloc(1, sizeof(paradox_xml1_entity_table));
+    if(NULL == table) return NULL;
+    paradox_xml1_arena_init(&table->arena);
+    table->depth_limit = depth_limit;
+    table->byte_limit = byte_limit;
+    return table;
+}
+
+void paradox_xml1_entities_free(paradox_xml1_entity_table* table)
+{
+    if(NULL == table) return;
+    paradox_xml1_elements_free(table->elements);
+    paradox_xml1_arena_free(&table->arena);
+    free(table->entities);
+    free(table->slots);
+    free(table);
+}
+
+paradox_bool8_t paradox_xml1_entities_declare(paradox_xml1_entity_table* table, const char* name, const paradox_uint64_t length, const paradox_bool8_t parameter, const paradox_xml1_slice* literal, const paradox_bool8_t unparsed)
+{
+    const paradox_uint64_t hash = paradox_xml1_symbols_hash(name, length);
+    paradox_uint64_t slot = 0;
+    if(0 != table->slot_count)
+    {
+        slot = paradox_xml1_entities_slot(table, name, length, hash, parameter);
+        if(0 != table->slots[slot]) return PARADOX_TRUE;
+    }
+    if(table->count >= 0xFFFFFFFE) return PARADOX_FALSE;
+    if(table->count == table->capacity)
+    {
+        const paradox_uint64_t capacity = table->capacity ? table->capacity * 2 : 16;
+        paradox_xml1_entity* entities = realloc(table->entities, capacity * sizeof(paradox_xml1_entity));
+        if(NULL == entities) return PARADOX_FALSE;
+        table->entities = entities;
+        table->capacity = capacity;
+    }
+    if((table->count + 1) * 2 > table->slot_count)
+    {
+        if(PARADOX_FALSE == paradox_xml1_entities_rehash(table)) return PARADOX_FALSE;
+        slot = paradox_xml1_entities_slot(table, name, length, hash, parameter);
+    }
+
+    paradox_xml1_entity* entity = &table->entities[table->count];
+    memset(entity, 0, sizeof(paradox_xml1_entity));
+    entity->name.data = paradox_xml1_arena_strndup(&table->arena, name, length);
+    if(NULL == entity->name.data) return PARADOX_FALSE;
+    entity->name.length = length;
+    entity->hash = hash;
+    entity->parameter = parameter;
+    if(NULL != literal)
+    {
+        entity->literal.data = paradox_xml1_arena_strndup(&table->arena, literal->data, literal->length);
+        if(NULL == entity->literal.data) return PARADOX_FALSE;
+        entity->literal.length = literal->length;
+    }
+    else
+    {
+        entity->external = PARADOX_TRUE;
+        entity->unparsed = unparsed;
+    }
+    entity->state = PARADOX_XML1_ENTITY_DECLARED;
+    table->slots[slot] = (paradox_uint32_t)++table->count;
+    return PARADOX_TRUE;
+}
+
+paradox_xml1_entity* paradox_xml1_entities_find(const paradox_xml1_entity_table* table, const char* name, const paradox_uint64_t length, const paradox_bool8_t parameter)
+{
+    if(NULL == table || 0 == table->slot_count) return NULL;
+    const paradox_uint64_t slot = paradox_xml1_entities_slot(table, name, length, paradox_xml1_symbols_hash(name, length), parameter);
+    return 0 != table->slots[slot] ? &table->entities[table->slots[slot] - 1] : NULL;
+}
+
+paradox_uint64_t paradox_xml1_entities_expand_value(const paradox_xml1_entity_table* table, const char* value, const paradox_uint64_t length, char* output)
+{
+    paradox_uint64_t index = 0;
+    paradox_uint64_t output_length = 0;
+    char character[4];
+    for(const char* reference = memchr(value, '&', length); NULL != reference; reference = memchr(value + index, '&', length - index))
+    {
+        const paradox_uint64_t reference_index = (paradox_uint64_t)(reference - value);
+        if(NULL != output) memcpy(output + output_length, value + index, reference_index - index);
+        output_length += reference_index - index;
+        const paradox_uint64_t reference_length = (paradox_uint64_t)((const char*)memchr(reference, ';', length - reference_index) - reference) + 1;
+        index = reference_index + reference_length;
+        char* destination = NULL != output ? output + output_length : character;
+        paradox_uint32_t code = 0;
+        const char predefined = paradox_xml1_decode_predefined(reference, reference_length);
+        const paradox_xml1_entity* entity = '#' != reference[1] && '\0' == predefined ? paradox_xml1_entities_find(table, reference + 1, reference_length - 2, PARADOX_FALSE) : NULL;
+        if('#' == reference[1] && 0 != paradox_xml1_decode_char_ref(reference, reference_length, &code)) output_length += paradox_xml1_encode_utf8(code, destination);
+        else if('\0' != predefined)
+        {
+            *destination = predefined;
+            output_length++;
+        }
+        else if(NULL != entity && PARADOX_FALSE == entity->external)
+        {
+            if(NULL != output) memcpy(destination, entity->expansion.data, entity->expansion.length);
+            output_length += entity->expansion.length;
+        }
+        else
+        {
+            if(NULL != output) memcpy(destination, reference, reference_length);
+            output_length += reference_length;
+        }
+    }
+    if(NULL != output) memcpy(output + output_length, value + index, length - index);
+    return output_length + (length - index);
+}
@@ -0,0 +1,90 @@
+#ifndef PARADOX_SOFTWARE_C_HEADER_XML1_ENTITIES
+#define PARADOX_SOFTWARE_C_HEADER_XML1_ENTITIES
+
+#include <paradox-xml/xml1_document.h>
+#include <paradox-xml/xml1_arena.h>
+#include "xml1_elements.h"
+
+typedef enum paradox_xml1_entity_state_t {
+    PARADOX_XML1_ENTITY_DECLARED,
+    // Set while the replacement text of the entity is expanded or parsed, so a reference to it
+    // from there is a reference to itself. [WFC: No Recursion]
+    PARADOX_XML1_ENTITY_EXPANDING,
+    PARADOX_XML1_ENTITY_EXPANDED
+} paradox_xml1_entity_state_t;
+
+typedef struct paradox_xml1_entity
+{
+    paradox_xml1_slice name;
+    paradox_uint64_t hash;
+    // The EntityValue of an internal entity between its quotes.
+    paradox_xml1_slice literal;
+    // The literal with its character references and parameter-entity references replaced, once expanded.
+    paradox_xml1_slice replacement;
+    // The replacement text with its references to general entities replaced as well, once expanded. Only
+    // entities whose replacement text is character data have one, and every later reference copies it.
+    paradox_xml1_slice expansion;
+    paradox_xml1_entity_state_t state;
+    paradox_bool8_t parameter;
+    // Declared with an ExternalID, whose entity is not read, and with an NDataDecl on top for an unparsed one.
+    paradox_bool8_t external;
+    paradox_bool8_t unparsed;
+    // Set when the replacement text holds markup, or references an entity that does, so it has to be parsed as content.
+    paradox_bool8_t markup;
+
+} paradox_xml1_entity;
+
+struct paradox_xml1_entity_table
+{
+    // Entities in the order of their declarations.
+    paradox_xml1_entity* entities;
+    paradox_uint64_t count;
+    paradox_uint64_t capacity;
+    // Open addressing over the hashes of the names, like the symbol table.
+    paradox_uint32_t* slots;
+    paradox_uint64_t slot_count;
+    // Copies of the names and literals, so a streaming reader may drop the input they were declared in,
+    // together with the replacement texts and their expansions.
+    paradox_xml1_arena arena;
+    // Budgets of the parse and what has been spent of them: the entities being expanded inside each other
+    // and the bytes the expansions and the references to them added up to.
+    paradox_uint64_t depth_limit;
+    paradox_uint64_t byte_limit;
+    paradox_uint64_t depth;
+    paradox_uint64_t bytes;
+    // Set once the document type declaration has an external subset or references a parameter entity, which
+    // may declare entities that are not read. A reference to an undeclared entity is then kept as it is written
+    // rather than rejected. [WFC: Entity Declared]
+    paradox_bool8_t incomplete;
+    // Set after a reference to a parameter entity that is not read, after which declarations are not processed.
+    paradox_bool8_t skipped;
+    // Element types the doctypedecl declares, with their content models compiled, when the parse validates.
+    // NULL otherwise.
+    paradox_xml1_element_table* elements;
+
+};
+
+// Returns NULL when out of memory.
+paradox_xml1_entity_table* paradox_xml1_entities_create(const paradox_uint64_t depth_limit, const paradox_uint64_t byte_limit);
+void paradox_xml1_entities_free(paradox_xml1_entity_table* table);
+// Declares the entity named by the length bytes of name, internal with the EntityValue literal unless it is NULL.
+// The first declaration of a name binds it and later ones are ignored. Returns PARADOX_FALSE when out of memory.
+paradox_bool8_t paradox_xml1_entities_declare(paradox_xml1_entity_table* table, const char* name, const paradox_uint64_t length, const paradox_bool8_t parameter, const paradox_xml1_slice* literal, const paradox_bool8_t unparsed);
+// The general or parameter entity named by the length bytes of name, or NULL when none is declared.
+paradox_xml1_entity* paradox_xml1_entities_find(const paradox_xml1_entity_table* table, const char* name, const paradox_uint64_t length, const paradox_bool8_t parameter);
+
+// Expands the length bytes of value, an AttValue without its quotes the parse accepted, into output and returns the
+// length of the expansion, or only counts its bytes when output is NULL. The parse expanded the entities value refers
+// to and spent their bytes, so their expansions are copied as they are. References to entities that are not read are
+// kept as they are written.
+paradox_uint64_t paradox_xml1_entities_expand_value(const paradox_xml1_entity_table* table, const char* value, const paradox_uint64_t length, char* output);
+
+// Spends length bytes of the byte budget, or returns PARADOX_FALSE when that would go beyond it.
+static inline paradox_bool8_t paradox_xml1_entities_charge(paradox_xml1_entity_table* table, const paradox_uint64_t length)
+{
+    if(length > table->byte_limit - table->bytes) return PARADOX_FALSE;
+    table->bytes += length;
+    return PARADOX_TRUE;
+}
+
+#endif
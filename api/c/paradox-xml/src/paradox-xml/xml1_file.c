@@ -0,0 +1,97 @@
+#include <paradox-xml/xml1_parser.h>
+#include <stdint.h>
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+// Maps the whole file read-only. An empty file yields a NULL mapping of length 0, since it cannot be mapped.
+static paradox_xml1_parser_errno_t paradox_xml1_map_file(paradox_str_t path, const void** mapping, paradox_uint64_t* length)
+{
+    *mapping = NULL;
+    *length = 0;
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if(INVALID_HANDLE_VALUE == file) return PARADOX_XML1_PARSER_FILE_ERROR;
+    LARGE_INTEGER size;
+    if(!GetFileSizeEx(file, &size) || (paradox_uint64_t)size.QuadPart > SIZE_MAX)
+    {
+        CloseHandle(file);
+        return PARADOX_XML1_PARSER_FILE_ERROR;
+    }
+    if(0 == size.QuadPart)
+    {
+        CloseHandle(file);
+        return PARADOX_XML1_PARSER_SUCCESS;
+    }
+    // The view keeps the mapping object alive, so both handles can be closed right away.
+    HANDLE file_mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if(NULL == file_mapping) return PARADOX_XML1_PARSER_FILE_ERROR;
+    const void* view = MapViewOfFile(file_mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(file_mapping);
+    if(NULL == view) return PARADOX_XML1_PARSER_FILE_ERROR;
+    *mapping = view;
+    *length = (paradox_uint64_t)size.QuadPart;
+#else
+    const int file = open(path, O_RDONLY);
+    if(file < 0) return PARADOX_XML1_PARSER_FILE_ERROR;
+    struct stat status;
+    if(0 != fstat(file, &status) || !S_ISREG(status.st_mode) || (paradox_uint64_t)status.st_size > SIZE_MAX)
+    {
+        close(file);
+        return PARADOX_XML1_PARSER_FILE_ERROR;
+    }
+    if(0 == status.st_size)
+    {
+        close(file);
+        return PARADOX_XML1_PARSER_SUCCESS;
+    }
+    // The mapping holds its own reference to the file, so the descriptor is not needed afterwards.
+    void* view = mmap(NULL, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+    close(file);
+    if(MAP_FAILED == view) return PARADOX_XML1_PARSER_FILE_ERROR;
+    // The parser walks the input front to back exactly once.
+    madvise(view, (size_t)status.st_size, MADV_SEQUENTIAL);
+    *mapping = view;
+    *length = (paradox_uint64_t)status.st_size;
+#endif
+    return PARADOX_XML1_PARSER_SUCCESS;
+}
+
+static void paradox_xml1_unmap_file(const void* mapping, const paradox_uint64_t length)
+{
+    if(NULL == mapping) return;
+#ifdef _WIN32
+    (void)length;
+    UnmapViewOfFile(mapping);
+#else
+    munmap((void*)mapping, (size_t)length);
+#endif
+}
+
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_file(paradox_str_t path, paradox_xml1_document** document)
+{
+    if(NULL != document) *document = NULL;
+    if(NULL == path || NULL == document) return PARADOX_XML1_PARSER_NULL_DOCUMENT;
+
+    const void* mapping;
+    paradox_uint64_t length;
+    paradox_xml1_parser_errno_t result = paradox_xml1_map_file(path, &mapping, &length);
+    if(PARADOX_XML1_PARSER_SUCCESS != result) return result;
+
+    // An empty file still goes through the parser so it is reported as an invalid document.
+    result = paradox_parse_xml1_document_n(NULL != mapping ? mapping : "", length, document);
+    if(PARADOX_XML1_PARSER_SUCCESS != result)
+    {
+        paradox_xml1_unmap_file(mapping, length);
+        return result;
+    }
+    (*document)->mapping = mapping;
+    (*document)->mapping_length = length;
+    return PARADOX_XML1_PARSER_SUCCESS;
+}
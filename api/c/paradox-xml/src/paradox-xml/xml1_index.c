@@ -0,0 +1,182 @@
+#include "xml1_index.h"
+#include "xml1_scanner.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Bytes classified per call of the bitmap kernel, few enough for their bitmap to stay in L1.
+#define PARADOX_XML1_INDEX_BLOCK 4096
+
+typedef enum paradox_xml1_index_state_t {
+    PARADOX_XML1_INDEX_CHAR_DATA,
+    PARADOX_XML1_INDEX_TAG,
+    PARADOX_XML1_INDEX_VALUE
+} paradox_xml1_index_state_t;
+
+typedef struct paradox_xml1_index_walker
+{
+    const char* data;
+    paradox_uint64_t length;
+    paradox_xml1_index* structurals;
+    paradox_xml1_index_state_t state;
+    // Quote that closes the attribute value while in PARADOX_XML1_INDEX_VALUE.
+    char quote;
+
+} paradox_xml1_index_walker;
+
+// Makes room for count more positions.
+static paradox_bool8_t paradox_xml1_index_reserve(paradox_xml1_index* structurals, const paradox_uint64_t count)
+{
+    if(structurals->count + count <= structurals->capacity) return PARADOX_TRUE;
+    paradox_uint64_t capacity = structurals->capacity ? structurals->capacity * 2 : 1024;
+    while(capacity < structurals->count + count) capacity *= 2;
+    paradox_uint32_t* positions = realloc(structurals->positions, capacity * sizeof(paradox_uint32_t));
+    if(NULL == positions) return PARADOX_FALSE;
+    structurals->positions = positions;
+    structurals->capacity = capacity;
+    return PARADOX_TRUE;
+}
+
+// The position after the next terminator from index, or length when there is none.
+static paradox_uint64_t paradox_xml1_index_skip_to(const char* data, const paradox_uint64_t length, const paradox_uint64_t index, const char* terminator)
+{
+    const paradox_uint64_t found = index + paradox_xml1_scan_terminator(data + index, length - index, terminator, NULL, PARADOX_TRUE);
+    return found == length ? length : found + strlen(terminator);
+}
+
+// Where indexing resumes after the '<?' or '<!' at position: after the whole Comment, PI or CDATA
+// section. Markup that is not terminated runs to the end of the input and is rejected by the second
+// stage. Returns 0 for the other declarations.
+static paradox_uint64_t paradox_xml1_index_skip_markup(const char* data, const paradox_uint64_t length, const paradox_uint64_t position)
+{
+    const char* markup = data + position;
+    const paradox_uint64_t available = length - position;
+    if('?' == markup[1]) return paradox_xml1_index_skip_to(data, length, position + 2, "?>");
+    if(available >= 4 && !memcmp(markup, "<!--", 4)) return paradox_xml1_index_skip_to(data, length, position + 4, "-->");
+    if(available >= 9 && !memcmp(markup, "<![CDATA[", 9)) return paradox_xml1_index_skip_to(data, length, position + 9, "]]>");
+    return 0;
+}
+
+// Keeps the structural bits of one block that matter in the context they occur in. Stores where the
+// next block starts into next, which is earlier than the end of this one when markup was skipped.
+// Every bit is one position at most, so the block reserves them all up front.
+static paradox_xml1_parser_errno_t paradox_xml1_index_block(paradox_xml1_index_walker* walker, const paradox_uint64_t block, const paradox_uint64_t* bitmap, const paradox_uint64_t block_length, paradox_uint64_t* next)
+{
+    const char* data = walker->data;
+    paradox_xml1_index_state_t state = walker->state;
+    char quote = walker->quote;
+    paradox_xml1_parser_errno_t result = PARADOX_XML1_PARSER_SUCCESS;
+    *next = block + block_length;
+
+    paradox_uint64_t bits_count = 0;
+    for(paradox_uint64_t word = 0; word * 64 < block_length; word++) bits_count += paradox_xml1_scanner_count_bits(bitmap[word]);
+    if(PARADOX_FALSE == paradox_xml1_index_reserve(walker->structurals, bits_count)) return PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+    paradox_uint32_t* positions = walker->structurals->positions;
+    paradox_uint64_t count = walker->structurals->count;
+
+    for(paradox_uint64_t word = 0; word * 64 < block_length && *next == block + block_length; word++)
+    {
+        paradox_uint64_t bits = bitmap[word];
+        while(bits)
+        {
+            const paradox_uint64_t position = block + word * 64 + paradox_xml1_scanner_first_bit(bits);
+            const char byte = data[position];
+            bits &= bits - 1;
+            if(PARADOX_XML1_INDEX_CHAR_DATA == state)
+            {
+                if('>' == byte || '=' == byte || '/' == byte || '"' == byte || '\'' == byte) continue;
+                positions[count++] = (paradox_uint32_t)position;
+                if('<' != byte) continue;
+                const char marker = position + 1 < walker->length ? data[position + 1] : '\0';
+                if('?' != marker && '!' != marker)
+                {
+                    state = PARADOX_XML1_INDEX_TAG;
+                    continue;
+                }
+                *next = paradox_xml1_index_skip_markup(data, walker->length, position);
+                if(0 == *next) result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+                break;
+            }
+            else if(PARADOX_XML1_INDEX_TAG == state)
+            {
+                if(']' == byte) continue;
+                positions[count++] = (paradox_uint32_t)position;
+                if('>' == byte) state = PARADOX_XML1_INDEX_CHAR_DATA;
+                else if('"' == byte || '\'' == byte)
+                {
+                    state = PARADOX_XML1_INDEX_VALUE;
+                    quote = byte;
+                }
+            }
+            else
+            {
+                if(quote != byte && '<' != byte && '&' != byte) continue;
+                positions[count++] = (paradox_uint32_t)position;
+                if(quote == byte) state = PARADOX_XML1_INDEX_TAG;
+            }
+        }
+    }
+    walker->structurals->count = count;
+    walker->state = state;
+    walker->quote = quote;
+    return result;
+}
+
+// Bytes of the block at block, up to PARADOX_XML1_INDEX_BLOCK of them. A block does not end inside a UTF-8
+// sequence of valid input, so every block can be validated on its own.
+static paradox_uint64_t paradox_xml1_index_block_length(const char* data, const paradox_uint64_t length, const paradox_uint64_t block)
+{
+    if(length - block <= PARADOX_XML1_INDEX_BLOCK) return length - block;
+    paradox_uint64_t end = block + PARADOX_XML1_INDEX_BLOCK;
+    for(int i = 0; i < 3 && 0x80 == ((unsigned char)data[end] & 0xC0); i++) end--;
+    return end - block;
+}
+
+paradox_xml1_parser_errno_t paradox_xml1_index_build(const char* data, const paradox_uint64_t length, paradox_xml1_index* structurals)
+{
+    paradox_uint64_t bitmap[PARADOX_XML1_INDEX_BLOCK / 64];
+    paradox_xml1_index_walker walker = { data, length, structurals, PARADOX_XML1_INDEX_CHAR_DATA, '\0' };
+    paradox_xml1_parser_errno_t result = PARADOX_XML1_PARSER_SUCCESS;
+    structurals->count = 0;
+    if(length > PARADOX_XML1_INDEX_MAX_LENGTH)
+    {
+        paradox_xml1_index_free(structurals);
+        return PARADOX_XML1_PARSER_SUCCESS;
+    }
+
+    // Everything up to validated is valid Char, including the markup the walk skipped over.
+    paradox_uint64_t validated = 0;
+    paradox_uint64_t block = 0;
+    while(block < length)
+    {
+        const paradox_uint64_t block_length = paradox_xml1_index_block_length(data, length, block);
+        if(block + block_length > validated)
+        {
+            if(block + block_length - validated != paradox_xml1_validate(data + validated, block + block_length - validated))
+            {
+                paradox_xml1_index_free(structurals);
+                return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+            }
+            validated = block + block_length;
+        }
+        paradox_xml1_scan_structurals(data + block, block_length, bitmap);
+        result = paradox_xml1_index_block(&walker, block, bitmap, block_length, &block);
+        if(PARADOX_XML1_PARSER_SUCCESS != result) break;
+    }
+    if(PARADOX_XML1_PARSER_SUCCESS == result && PARADOX_FALSE == paradox_xml1_index_reserve(structurals, 1)) result = PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+    if(PARADOX_XML1_PARSER_SUCCESS != result)
+    {
+        paradox_xml1_index_free(structurals);
+        // The walk gives up on a document type declaration without the document being invalid.
+        return PARADOX_XML1_PARSER_INVALID_DOCUMENT == result ? PARADOX_XML1_PARSER_SUCCESS : result;
+    }
+    structurals->positions[structurals->count++] = (paradox_uint32_t)length;
+    return PARADOX_XML1_PARSER_SUCCESS;
+}
+
+void paradox_xml1_index_free(paradox_xml1_index* structurals)
+{
+    free(structurals->positions);
+    structurals->positions = NULL;
+    structurals->count = 0;
+    structurals->capacity = 0;
+}
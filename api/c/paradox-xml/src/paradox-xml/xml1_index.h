@@ -0,0 +1,31 @@
+#ifndef PARADOX_SOFTWARE_C_HEADER_XML1_INDEX
+#define PARADOX_SOFTWARE_C_HEADER_XML1_INDEX
+
+#include <paradox-xml/xml1_parser.h>
+
+// Positions are 32 bits wide to halve the memory the index streams through, which limits it to
+// documents shorter than 4 GiB.
+#define PARADOX_XML1_INDEX_MAX_LENGTH ((paradox_uint64_t)0xFFFFFFFF - 1)
+
+// Positions of the structural characters of a document in order, followed by the length of the
+// document as a sentinel. Only the characters that delimit markup in their context are kept:
+// '<', '&' and ']' in character data; '>', '=', '/', quotes, '<' and '&' inside tags; the closing
+// quote, '<' and '&' inside attribute values. Comments, PIs and CDATA sections are represented by
+// their '<' alone.
+typedef struct paradox_xml1_index
+{
+    paradox_uint32_t* positions;
+    paradox_uint64_t count;
+    paradox_uint64_t capacity;
+
+} paradox_xml1_index;
+
+// Indexes length bytes of data and validates them as UTF-8 Char on the way, one block at a time while it is
+// in cache. Returns PARADOX_XML1_PARSER_INVALID_DOCUMENT when they are not valid. Succeeds but leaves structurals
+// empty for documents the index does not cover: those with a document type declaration, whose internal subset
+// it does not follow, and those longer than PARADOX_XML1_INDEX_MAX_LENGTH. Their validation is left undone.
+// The positions of an earlier build are overwritten, so their buffer serves the next document.
+paradox_xml1_parser_errno_t paradox_xml1_index_build(const char* data, const paradox_uint64_t length, paradox_xml1_index* structurals);
+void paradox_xml1_index_free(paradox_xml1_index* structurals);
+
+#endif
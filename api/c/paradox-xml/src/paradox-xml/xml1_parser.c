@@ -1,2987 +1,4753 @@
 #include <paradox-xml/xml1_parser.h>
+#include <paradox-xml/xml1_reader.h>
 #include <paradox-platform/characters.h>
+#include "xml1_characters.h"
+#include "xml1_scanner.h"
+#include "xml1_index.h"
+#include "xml1_thread.h"
+#include "xml1_symbols.h"
+#include "xml1_references.h"
+#include "xml1_attribute_index.h"
+#include "xml1_entities.h"
+#include "xml1_elements.h"
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
 
-// Helpers
-void paradox_xml1_parser_next_index(paradox_str_t xml_string, paradox_uint64_t* index)
-{
-    size_t num_bytes;
-    const paradox_uint32_t code = paradox_utf8_to_codepoint(xml_string + *index, &num_bytes);
-    if(!num_bytes) return;
-    (*index) += num_bytes;
-}
+// Input
 
-// Document
+// Parses never look past length bytes of data. Reads at or beyond the end yield '\0',
+// which every production already treats as the end of the text.
+// The paradox_str_t entry points pass PARADOX_XML1_INPUT_UNBOUNDED and are bounded by their terminator instead.
+#define PARADOX_XML1_INPUT_UNBOUNDED ((paradox_uint64_t)-1)
 
-// [1] document ::= ( prolog element Misc* ) - ( Char* RestrictedChar Char* )
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_document(paradox_str_t xml_string, paradox_xml1_document** document)
+// validated is set once paradox_xml1_validate accepted all length bytes. The productions then trust
+// every sequence to be well-formed UTF-8 and the scanners stop only at markup.
+typedef struct paradox_xml1_input
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string || NULL == document)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    *document = malloc(sizeof(document));
+    const char* data;
+    paradox_uint64_t length;
+    paradox_bool8_t validated;
+} paradox_xml1_input;
 
-    paradox_uint64_t index = 0;
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_prolog(xml_string, &index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_element(xml_string, &index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    while(PARADOX_XML1_PARSER_SUCCESS == paradox_parse_xml1_misc(xml_string, &index));
-    if('\0' == xml_string[index]) result = PARADOX_XML1_PARSER_SUCCESS;
-    else result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+// The productions trust their arguments, take the position by value and return the position after
+// their match, or PARADOX_XML1_PARSER_NO_MATCH. Only the public entry points check and store.
+#define PARADOX_XML1_PARSER_NO_MATCH ((paradox_uint64_t)-1)
 
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(NULL != document && NULL != *document)
-        {
-            free(*document);
-            *document = NULL;
-        }
-    }
-    
-    return result;
+// Moves index to next when the production matched.
+static inline paradox_bool8_t paradox_xml1_parser_accept(paradox_uint64_t* index, const paradox_uint64_t next)
+{
+    if(PARADOX_XML1_PARSER_NO_MATCH == next) return PARADOX_FALSE;
+    *index = next;
+    return PARADOX_TRUE;
 }
 
-// Character Range
-
-// [2] Char ::= ([#x1-#xD7FF] | [#xE000-#xFFFD] | [#x10000-#x10FFFF]) - RestrictedChar
-PARADOX_XML_API paradox_bool8_t paradox_is_xml1_char(paradox_str_t xml_string, const paradox_uint64_t index)
+// Runs a production for a public entry point on its terminated string.
+static inline paradox_xml1_parser_errno_t paradox_xml1_parser_run(paradox_str_t xml_string, paradox_uint64_t* index, paradox_uint64_t (*production)(const paradox_xml1_input* input, paradox_uint64_t index))
 {
-    size_t num_bytes;
-    const paradox_uint32_t code = paradox_utf8_to_codepoint(xml_string + index, &num_bytes);
-    if(!num_bytes) return PARADOX_FALSE;
-    if( (0x1 <= code && code <= 0xD7FF)
-    ||  (0xE000 <= code && code <= 0xFFFD)
-    ||  (0x10000 <= code && code <= 0x10FFFF))
-        return !paradox_is_xml1_restricted_char(xml_string, index);
-    return PARADOX_FALSE;
+    if(NULL == xml_string) return PARADOX_XML1_PARSER_NULL_DOCUMENT;
+    if(NULL == index) return PARADOX_XML1_PARSER_NULL_INDEX;
+    const paradox_xml1_input input = { xml_string, PARADOX_XML1_INPUT_UNBOUNDED, PARADOX_FALSE };
+    return paradox_xml1_parser_accept(index, production(&input, *index)) ? PARADOX_XML1_PARSER_SUCCESS : PARADOX_XML1_PARSER_INVALID_DOCUMENT;
 }
-// [2a] RestrictedChar ::= [#x1-#x8] | [#xB-#xC] | [#xE-#x1F] | [#x7F-#x84] | [#x86-#x9F]
-PARADOX_XML_API paradox_bool8_t paradox_is_xml1_restricted_char(paradox_str_t xml_string, const paradox_uint64_t index)
+
+static inline paradox_char8_t paradox_xml1_peek(const paradox_xml1_input* input, const paradox_uint64_t index)
 {
-    size_t num_bytes;
-    const paradox_uint32_t code = paradox_utf8_to_codepoint(xml_string + index, &num_bytes);
-    if(!num_bytes) return PARADOX_FALSE;
-    if( (0x1 <= code && code <= 0x8)
-    ||  (0xB <= code && code <= 0xC)
-    ||  (0xE <= code && code <= 0x1F)
-    ||  (0x7F <= code && code <= 0x84)
-    ||  (0x86 <= code && code <= 0x9F))
-        return PARADOX_TRUE;
-    return PARADOX_FALSE;
+    return index < input->length ? input->data[index] : '\0';
 }
 
-// White Space
+// strncmp against a literal that must fit in the remaining input; zero when it matches.
+static inline int paradox_xml1_compare(const paradox_xml1_input* input, const paradox_uint64_t index, const char* literal, const paradox_uint64_t length)
+{
+    if(index > input->length || input->length - index < length) return 1;
+    return strncmp(input->data + index, literal, length);
+}
 
-// [3] S ::= (#x20 | #x9 | #xD | #xA)+
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_space(paradox_str_t xml_string, paradox_uint64_t* index)
+// Decodes the UTF-8 sequence at index, see paradox_xml1_decode_utf8.
+static inline paradox_uint32_t paradox_xml1_decode(const paradox_xml1_input* input, const paradox_uint64_t index, size_t* num_bytes)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
+    if(index >= input->length)
     {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
+        *num_bytes = 0;
+        return 0;
     }
-    const paradox_uint64_t base_index = *index;
-
-    paradox_bool8_t space_found = PARADOX_FALSE;
-    do
-    {
-        switch(xml_string[*index])
-        {
-        case 0x9:
-        case 0xA:
-        case 0xD:
-        case 0x20:
-            space_found = PARADOX_TRUE;
-            (*index)++;
-            break;
-        default: break;
-        }
-    } while(PARADOX_TRUE == space_found);
+    if(input->validated) return paradox_xml1_decode_utf8_unchecked((const unsigned char*)input->data + index, num_bytes);
+    return paradox_xml1_decode_utf8((const unsigned char*)input->data + index, input->length - index, num_bytes);
+}
 
-    if(PARADOX_TRUE == space_found) result = PARADOX_XML1_PARSER_SUCCESS;
-    else result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+// Productions are defined in the order of the grammar, so they are declared up front.
+static paradox_bool8_t paradox_xml1_is_char(const paradox_xml1_input* input, const paradox_uint64_t index);
+static paradox_bool8_t paradox_xml1_is_restricted_char(const paradox_xml1_input* input, const paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_space(const paradox_xml1_input* input, paradox_uint64_t index);
+static paradox_bool8_t paradox_xml1_is_name_start_char(const paradox_xml1_input* input, const paradox_uint64_t index);
+static paradox_bool8_t paradox_xml1_is_name_char(const paradox_xml1_input* input, const paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_name(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_names(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_nm_token(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_nm_tokens(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_entity_value(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_att_value(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_system_literal(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_pubid_literal(const paradox_xml1_input* input, paradox_uint64_t index);
+static paradox_bool8_t paradox_xml1_is_pubid_char(const paradox_xml1_input* input, const paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_char_data(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_comment(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_pi(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_pi_target(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_cd_sect(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_cd_start(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_c_data(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_cd_end(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_prolog(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_xml_decl(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_version_info(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_eq(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_version_num(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_misc(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_doctypedecl(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_decl_sep(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_int_subset(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_markupdecl(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_ext_subset(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_ext_subset_decl(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_sd_decl(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_s_tag(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_e_tag(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_empty_elem_tag(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_elementdecl(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_contentspec(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_children(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_cp(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_choice(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_seq(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_mixed(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_attlist_decl(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_att_def(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_att_type(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_string_type(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_tokenized_type(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_enumerated_type(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_notation_type(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_enumeration(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_default_decl(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_conditional_sect(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_include_sect(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_ignore_sect(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_ignore_sect_contents(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_ignore(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_char_ref(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_reference(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_entity_ref(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_pe_reference(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_entity_decl(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_ge_decl(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_pe_decl(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_entity_def(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_pe_def(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_external_id(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_ndata_decl(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_text_decl(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_ext_parsed_ent(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_encoding_decl(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_enc_name(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_notation_decl(const paradox_xml1_input* input, paradox_uint64_t index);
+static inline paradox_uint64_t paradox_xml1_parser_public_id(const paradox_xml1_input* input, paradox_uint64_t index);
+typedef struct paradox_xml1_parser_events paradox_xml1_parser_events;
+typedef struct paradox_xml1_parser_validation paradox_xml1_parser_validation;
+static paradox_bool8_t paradox_xml1_parser_references_entities(const paradox_xml1_slice text);
+static paradox_xml1_parser_errno_t paradox_xml1_parser_measure_value(paradox_xml1_entity_table* entities, const paradox_xml1_slice value, paradox_uint64_t* length);
+static paradox_uint64_t paradox_xml1_parser_expand_value(paradox_xml1_entity_table* entities, const paradox_xml1_slice value, char* output);
+static paradox_xml1_parser_errno_t paradox_xml1_parser_element(const paradox_xml1_input* input, paradox_uint64_t* index, paradox_xml1_document* document, paradox_xml1_parser_events* events, paradox_xml1_parser_validation* parent_validation, paradox_xml1_element** element);
+static paradox_xml1_parser_errno_t paradox_xml1_parser_content(const paradox_xml1_input* input, paradox_uint64_t* index, paradox_xml1_document* document, paradox_xml1_parser_events* events, paradox_xml1_element* parent, paradox_xml1_parser_validation* validation, const paradox_uint64_t stop);
+static paradox_xml1_parser_errno_t paradox_xml1_parser_tag(const paradox_xml1_input* input, paradox_uint64_t* index, paradox_xml1_document* document, paradox_xml1_parser_events* events, paradox_xml1_element** element, paradox_uint64_t* name_length);
+static paradox_xml1_parser_errno_t paradox_xml1_parser_doctype(const paradox_xml1_input* input, paradox_uint64_t* index, const paradox_xml1_parser_options* options, paradox_xml1_entity_table** entities);
+
+// Cursor
+
+// The character at index, decoded once together with its classes. width is 0 at the end of the
+// input and for malformed sequences, whose classes are empty as well.
+typedef struct paradox_xml1_cursor
+{
+    paradox_uint64_t index;
+    paradox_uint32_t code;
+    paradox_uint32_t width;
+    paradox_uint8_t classes;
+} paradox_xml1_cursor;
 
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
-    }
+static inline void paradox_xml1_cursor_load(const paradox_xml1_input* input, paradox_xml1_cursor* cursor, const paradox_uint64_t index)
+{
+    cursor->index = index;
+    if(index < input->length && !(input->data[index] & 0x80))
+    {
+        const unsigned char byte = (unsigned char)input->data[index];
+        cursor->code = byte;
+        cursor->width = 0 != byte;
+        cursor->classes = paradox_xml1_character_blocks[0][byte];
+        return;
+    }
+    size_t width;
+    cursor->code = paradox_xml1_decode(input, index, &width);
+    cursor->width = (paradox_uint32_t)width;
+    cursor->classes = width ? paradox_xml1_classify(cursor->code) : 0;
+}
 
-    return result;
+static inline void paradox_xml1_cursor_advance(const paradox_xml1_input* input, paradox_xml1_cursor* cursor)
+{
+    paradox_xml1_cursor_load(input, cursor, cursor->index + cursor->width);
 }
 
-// Names and Tokens
+// Skips the characters CharData accepts without a closer look. The vector kernels only run on
+// bounded input, the unbounded production entry points do not know how far they may read.
+static inline paradox_uint64_t paradox_xml1_skip_char_data(const paradox_xml1_input* input, const paradox_uint64_t index)
+{
+    if(PARADOX_XML1_INPUT_UNBOUNDED == input->length || index >= input->length) return index;
+    return index + paradox_xml1_scan_char_data(input->data + index, input->length - index, input->validated);
+}
 
-// [4] NameStartChar ::= ":" | [A-Z] | "_" | [a-z] | [#xC0-#xD6] | [#xD8-#xF6] | [#xF8-#x2FF] | [#x370-#x37D] | [#x37F-#x1FFF] | [#x200C-#x200D] | [#x2070-#x218F] | [#x2C00-#x2FEF] | [#x3001-#xD7FF] | [#xF900-#xFDCF] | [#xFDF0-#xFFFD] | [#x10000-#xEFFFF]
-PARADOX_XML_API paradox_bool8_t paradox_is_xml1_name_start_char(paradox_str_t xml_string, const paradox_uint64_t index)
+// Skips to the next terminator, or alternative unless it is NULL, over characters Char accepts without a closer look.
+static inline paradox_uint64_t paradox_xml1_skip_to_terminator(const paradox_xml1_input* input, const paradox_uint64_t index, const char* terminator, const char* alternative)
 {
-    size_t num_bytes;
-    const paradox_uint32_t code = paradox_utf8_to_codepoint(xml_string + index, &num_bytes);
-    if(!num_bytes) return PARADOX_FALSE;
-    switch(code)
-    {
-    case ':':
-    case '_': return PARADOX_TRUE;
-    default:
-    {
-        if( ('A' <= code && code <= 'Z')
-        ||  ('a' <= code && code <= 'z')
-        ||  (0xC0 <= code && code <= 0xD6)
-        ||  (0xD8 <= code && code <= 0xF6)
-        ||  (0xF8 <= code && code <= 0x2FF)
-        ||  (0x370 <= code && code <= 0x37D)
-        ||  (0x37F <= code && code <= 0x1FFF)
-        ||  (0x200C <= code && code <= 0x200D)
-        ||  (0x2070 <= code && code <= 0x218F)
-        ||  (0x2C00 <= code && code <= 0x2FEF)
-        ||  (0x3001 <= code && code <= 0xD7FF)
-        ||  (0xF900 <= code && code <= 0xFDCF)
-        ||  (0xFDF0 <= code && code <= 0xFFFD)
-        ||  (0x10000 <= code && code <= 0xEFFFF))
-            return PARADOX_TRUE;
-        break;
-    }
-    }
-    return PARADOX_FALSE;
+    if(PARADOX_XML1_INPUT_UNBOUNDED == input->length || index >= input->length) return index;
+    return index + paradox_xml1_scan_terminator(input->data + index, input->length - index, terminator, alternative, input->validated);
 }
-// [4a] NameChar ::= NameStartChar | "-" | "." | [0-9] | #xB7 | [#x0300-#x036F] | [#x203F-#x2040]
-PARADOX_XML_API paradox_bool8_t paradox_is_xml1_name_char(paradox_str_t xml_string, const paradox_uint64_t index)
+
+// Tree building
+
+// Collects the text of an element across the CharData, CDSect and Reference pieces of its content.
+// Pieces that follow each other in the input stay a slice of it; a piece elsewhere materializes the
+// text into a buffer allocated from the arena. References are collected as they are written, and
+// decoded only when the value is read.
+typedef struct paradox_xml1_parser_text
 {
-    size_t num_bytes;
-    const paradox_uint32_t code = paradox_utf8_to_codepoint(xml_string + index, &num_bytes);
-    if(!num_bytes) return PARADOX_FALSE;
-    switch(code)
-    {
-    case ':':
-    case '_':
-    case '-':
-    case '.':
-    case 0xB7: return PARADOX_TRUE;
-    default:
-    {
-        if( ('A' <= code && code <= 'Z')
-        ||  ('a' <= code && code <= 'z')
-        ||  ('0' <= code && code <= '9')
-        ||  (0xC0 <= code && code <= 0xD6)
-        ||  (0xD8 <= code && code <= 0xF6)
-        ||  (0xF8 <= code && code <= 0x2FF)
-        ||  (0x300 <= code && code <= 0x36F)
-        ||  (0x370 <= code && code <= 0x37D)
-        ||  (0x37F <= code && code <= 0x1FFF)
-        ||  (0x200C <= code && code <= 0x200D)
-        ||  (0x203F <= code && code <= 0x2040)
-        ||  (0x2070 <= code && code <= 0x218F)
-        ||  (0x2C00 <= code && code <= 0x2FEF)
-        ||  (0x3001 <= code && code <= 0xD7FF)
-        ||  (0xF900 <= code && code <= 0xFDCF)
-        ||  (0xFDF0 <= code && code <= 0xFFFD)
-        ||  (0x10000 <= code && code <= 0xEFFFF))
-            return PARADOX_TRUE;
-        break;
-    }
-    }
-    return PARADOX_FALSE;
+    const char* data;
+    paradox_uint64_t length;
+    char* buffer;
+    paradox_uint64_t capacity;
+    // Set while the text holds references that are still written out.
+    paradox_bool8_t references;
+    // Set once the text holds a '&' that stands for itself, as a CDATA section can, after which references
+    // have to be decoded as they come.
+    paradox_bool8_t literal;
+} paradox_xml1_parser_text;
+
+static paradox_bool8_t paradox_xml1_parser_reserve_text(paradox_xml1_arena* arena, paradox_xml1_parser_text* text, const paradox_uint64_t length)
+{
+    if(NULL != text->buffer && text->length + length <= text->capacity) return PARADOX_TRUE;
+    paradox_uint64_t capacity = text->capacity ? text->capacity * 2 : 32;
+    while(capacity < text->length + length) capacity *= 2;
+    char* grown = paradox_xml1_arena_alloc(arena, capacity);
+    if(NULL == grown) return PARADOX_FALSE;
+    if(text->length) memcpy(grown, text->data, text->length);
+    text->data = text->buffer = grown;
+    text->capacity = capacity;
+    return PARADOX_TRUE;
 }
-// [5] Name ::= NameStartChar (NameChar)*
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_name(paradox_str_t xml_string, paradox_uint64_t* index)
+
+static paradox_bool8_t paradox_xml1_parser_append_text(paradox_xml1_arena* arena, paradox_xml1_parser_text* text, const char* data, const paradox_uint64_t length)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
+    if(0 == text->length && NULL == text->buffer)
     {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
+        text->data = data;
+        text->length = length;
+        return PARADOX_TRUE;
     }
-    else if(NULL == index)
+    if(NULL == text->buffer && text->data + text->length == data)
     {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
+        text->length += length;
+        return PARADOX_TRUE;
     }
-    const paradox_uint64_t base_index = *index;
+    if(PARADOX_FALSE == paradox_xml1_parser_reserve_text(arena, text, length)) return PARADOX_FALSE;
+    memcpy(text->buffer + text->length, data, length);
+    text->length += length;
+    return PARADOX_TRUE;
+}
 
-    if(PARADOX_FALSE == paradox_is_xml1_name_start_char(xml_string, *index))
+// Decodes the references text still holds, in its buffer when it has one.
+static paradox_bool8_t paradox_xml1_parser_decode_text(paradox_xml1_arena* arena, paradox_xml1_parser_text* text)
+{
+    if(PARADOX_FALSE == text->references) return PARADOX_TRUE;
+    if(NULL == text->buffer)
     {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
+        text->buffer = paradox_xml1_arena_alloc(arena, text->length);
+        if(NULL == text->buffer) return PARADOX_FALSE;
+        text->capacity = text->length;
     }
-    else paradox_xml1_parser_next_index(xml_string, index);
+    text->length = paradox_xml1_decode_value(text->data, text->length, text->buffer);
+    text->data = text->buffer;
+    text->references = PARADOX_FALSE;
+    return PARADOX_TRUE;
+}
 
-    while('\0' != xml_string[*index])
+// Appends length bytes of data holding references as they are written, which a Reference is on its own.
+static paradox_bool8_t paradox_xml1_parser_append_reference(paradox_xml1_arena* arena, paradox_xml1_parser_text* text, const char* data, const paradox_uint64_t length)
+{
+    if(PARADOX_FALSE == text->literal)
     {
-        if(PARADOX_FALSE == paradox_is_xml1_name_char(xml_string, *index)) break;
-        paradox_xml1_parser_next_index(xml_string, index);
+        text->references = PARADOX_TRUE;
+        return paradox_xml1_parser_append_text(arena, text, data, length);
     }
-    result = PARADOX_XML1_PARSER_SUCCESS;
+    if(PARADOX_FALSE == paradox_xml1_parser_reserve_text(arena, text, length)) return PARADOX_FALSE;
+    text->length += paradox_xml1_decode_value(data, length, text->buffer + text->length);
+    return PARADOX_TRUE;
+}
 
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
+// Appends length bytes of data whose '&' stand for themselves, like the CData of a CDATA section.
+static paradox_bool8_t paradox_xml1_parser_append_literal(paradox_xml1_arena* arena, paradox_xml1_parser_text* text, const char* data, const paradox_uint64_t length)
+{
+    if(PARADOX_FALSE == text->literal && NULL != memchr(data, '&', length))
     {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
+        if(PARADOX_FALSE == paradox_xml1_parser_decode_text(arena, text)) return PARADOX_FALSE;
+        text->literal = PARADOX_TRUE;
     }
-
-    return result;
+    return paradox_xml1_parser_append_text(arena, text, data, length);
 }
-// [6] Names ::= Name (#x20 Name)*
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_names(paradox_str_t xml_string, paradox_uint64_t* index)
+
+// Hands the text collected for element over as its value.
+static void paradox_xml1_parser_set_value(paradox_xml1_element* element, const paradox_xml1_parser_text* text)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
-    const paradox_uint64_t base_index = *index;
+    element->value.data = text->data;
+    element->value.length = text->length;
+    element->references = text->references;
+}
 
-    result = paradox_parse_xml1_name(xml_string, index);
-    if(PARADOX_XML1_PARSER_SUCCESS != result) goto INVALID_PARSING;
+// Allocates an element without children, attributes or value yet and interns its tag.
+static paradox_xml1_element* paradox_xml1_parser_create_element(paradox_xml1_document* document, const paradox_xml1_slice tag)
+{
+    paradox_xml1_element* created = paradox_xml1_arena_alloc(&document->arena, sizeof(paradox_xml1_element));
+    if(NULL == created) return NULL;
+    memset(created, 0, sizeof(paradox_xml1_element));
+    created->tag = tag;
+    created->symbol = paradox_xml1_symbols_intern(document->symbols, tag.data, tag.length);
+    if(PARADOX_XML1_SYMBOL_NONE == created->symbol) return NULL;
+    return created;
+}
 
-    while('\0' != xml_string[*index])
-    {
-        paradox_uint64_t last_index = *index;
-        if(0x20 != xml_string[last_index++]) break;
-        if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_name(xml_string, &last_index)) break;
-        *index = last_index;
-    }
-    result = PARADOX_XML1_PARSER_SUCCESS;
+// [WFC: Element Type Match] Whether the end-tag Name at end_name_index is the Name of the start-tag, which is name.
+static inline paradox_bool8_t paradox_xml1_parser_end_tag_matches(const paradox_xml1_input* input, const paradox_uint64_t end_name_index, const char* name, const paradox_uint64_t name_length)
+{
+    if(input->length - end_name_index < name_length || PARADOX_TRUE == paradox_xml1_is_name_char(input, end_name_index + name_length)) return PARADOX_FALSE;
+    return 0 == memcmp(input->data + end_name_index, name, name_length);
+}
 
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
-    }
+// Allocates an attribute whose value is given without its surrounding quotes, and holds references when
+// they are set. The value stays a slice of the input, with its references decoded when it is first read.
+// References to entities are only checked here, which expands the entities and spends their bytes, and
+// paradox_get_xml1_attribute_value copies the expansions out of the entities of the document.
+static paradox_xml1_parser_errno_t paradox_xml1_parser_create_attribute(paradox_xml1_document* document, const paradox_xml1_slice tag, const paradox_xml1_slice value, const paradox_bool8_t references, paradox_xml1_attribute** attribute)
+{
+    paradox_xml1_attribute* created = paradox_xml1_arena_alloc(&document->arena, sizeof(paradox_xml1_attribute));
+    if(NULL == created) return PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+    created->tag = tag;
+    created->symbol = paradox_xml1_symbols_intern(document->symbols, tag.data, tag.length);
+    if(PARADOX_XML1_SYMBOL_NONE == created->symbol) return PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+    created->value = value;
+    created->references = references;
+    created->next = NULL;
+    *attribute = created;
+    if(PARADOX_FALSE == created->references || PARADOX_FALSE == paradox_xml1_parser_references_entities(value)) return PARADOX_XML1_PARSER_SUCCESS;
+    paradox_uint64_t length;
+    return paradox_xml1_parser_measure_value(document->entities, value, &length);
+}
 
-    return result;
+// Links attribute after last, the attribute element has so far, and checks [WFC: Unique Att Spec] against the others
+// through the same lookup paradox_find_xml1_attribute runs. Names are interned, so equal names share their symbol.
+static paradox_xml1_parser_errno_t paradox_xml1_parser_add_attribute(paradox_xml1_document* document, paradox_xml1_element* element, paradox_xml1_attribute** last, paradox_xml1_attribute* attribute)
+{
+    if(NULL != paradox_find_xml1_attribute(element, attribute->symbol)) return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+    if(NULL == *last) element->attributes = attribute;
+    else (*last)->next = attribute;
+    *last = attribute;
+    return PARADOX_TRUE == paradox_xml1_attribute_index_add(&document->arena, element, attribute) ? PARADOX_XML1_PARSER_SUCCESS : PARADOX_XML1_PARSER_OUT_OF_MEMORY;
 }
-// [7] Nmtoken ::= (NameChar)+
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_nm_token(paradox_str_t xml_string, paradox_uint64_t* index)
+
+// Unique Att Spec
+
+// Attribute names of one start-tag, checked for [WFC: Unique Att Spec] where there is no tree that interns them.
+// Up to PARADOX_XML1_ATTRIBUTE_LINEAR_MAX names are compared one by one, like the attributes of an element. Beyond,
+// the names are hashed into slots stamped with the tag they belong to, so a tag never has to clear those of the last.
+typedef struct paradox_xml1_parser_name_set
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
+    // The stamp of the tag in the high half and the position of the name + 1 in the low half.
+    paradox_uint64_t* slots;
+    paradox_uint64_t slot_count;
+    paradox_uint64_t stamp;
+} paradox_xml1_parser_name_set;
+
+// Puts the position of name into its slot, unless a name of the same tag is already there.
+static paradox_bool8_t paradox_xml1_parser_name_set_put(paradox_xml1_parser_name_set* set, const paradox_xml1_slice* names, const paradox_uint64_t stride, const paradox_uint64_t position, const paradox_xml1_slice name)
+{
+    const paradox_uint64_t mask = set->slot_count - 1;
+    for(paradox_uint64_t slot = paradox_xml1_symbols_hash(name.data, name.length) & mask;; slot = (slot + 1) & mask)
     {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
+        const paradox_uint64_t entry = set->slots[slot];
+        if(entry >> 32 != set->stamp)
+        {
+            set->slots[slot] = set->stamp << 32 | (position + 1);
+            return PARADOX_TRUE;
+        }
+        const paradox_xml1_slice* other = &names[((entry & 0xFFFFFFFF) - 1) * stride];
+        if(other->length == name.length && PARADOX_TRUE == paradox_xml1_symbols_equal(other->data, name.data, name.length)) return PARADOX_FALSE;
     }
-    const paradox_uint64_t base_index = *index;
+}
 
-    paradox_bool8_t name_char_found = PARADOX_FALSE;
-    do
+// Checks name, the count-th of its tag, against those before it, which are every stride-th slice of names.
+static paradox_xml1_parser_errno_t paradox_xml1_parser_unique_name(paradox_xml1_parser_name_set* set, const paradox_xml1_slice* names, const paradox_uint64_t stride, const paradox_uint64_t count, const paradox_xml1_slice name)
+{
+    if(count < PARADOX_XML1_ATTRIBUTE_LINEAR_MAX)
     {
-        if(PARADOX_TRUE == paradox_is_xml1_name_char(xml_string, *index))
+        for(paradox_uint64_t i = 0; i < count; i++)
         {
-            name_char_found = PARADOX_TRUE;
-            paradox_xml1_parser_next_index(xml_string, index);
+            const paradox_xml1_slice* other = &names[i * stride];
+            if(other->length == name.length && !memcmp(other->data, name.data, name.length)) return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
         }
-    } while(PARADOX_TRUE == name_char_found);
-    
-    if(PARADOX_TRUE == name_char_found) result = PARADOX_XML1_PARSER_SUCCESS;
-    else result = PARADOX_XML1_PARSER_INVALID_DOCUMENT; 
-
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
+        return PARADOX_XML1_PARSER_SUCCESS;
+    }
+    if(count >= 0xFFFFFFFF) return PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+    if(PARADOX_XML1_ATTRIBUTE_LINEAR_MAX == count || (count + 1) * 2 > set->slot_count)
     {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
+        // The names of the tag so far move into the slots under a new stamp, after the slots grew when they had to.
+        if((count + 1) * 2 > set->slot_count)
+        {
+            paradox_uint64_t slot_count = set->slot_count ? set->slot_count * 2 : 4 * PARADOX_XML1_ATTRIBUTE_LINEAR_MAX;
+            while(slot_count < (count + 1) * 2) slot_count *= 2;
+            paradox_uint64_t* slots = realloc(set->slots, slot_count * sizeof(paradox_uint64_t));
+            if(NULL == slots) return PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+            memset(slots, 0, slot_count * sizeof(paradox_uint64_t));
+            set->slots = slots;
+            set->slot_count = slot_count;
+            set->stamp = 0;
+        }
+        if(++set->stamp > 0xFFFFFFFF)
+        {
+            memset(set->slots, 0, set->slot_count * sizeof(paradox_uint64_t));
+            set->stamp = 1;
+        }
+        for(paradox_uint64_t i = 0; i < count; i++) paradox_xml1_parser_name_set_put(set, names, stride, i, names[i * stride]);
     }
+    return PARADOX_TRUE == paradox_xml1_parser_name_set_put(set, names, stride, count, name) ? PARADOX_XML1_PARSER_SUCCESS : PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+}
 
-    return result;
+// Events
+
+// State of an event parse. Slices handed to the handler point into the input, except for decoded
+// references and attribute values holding references, which live in buffers owned by the parse.
+struct paradox_xml1_parser_events
+{
+    const paradox_xml1_sax_handler* handler;
+    // Attribute names of the current tag, for [WFC: Unique Att Spec] without a tree.
+    paradox_xml1_slice* names;
+    paradox_uint64_t names_capacity;
+    paradox_xml1_parser_name_set unique;
+    // Reused for every attribute value holding references and every run of references that is decoded.
+    char* buffer;
+    paradox_uint64_t capacity;
+    // Entities declared by the doctypedecl, NULL without one.
+    paradox_xml1_entity_table* entities;
+};
+
+typedef paradox_bool8_t (*paradox_xml1_parser_slice_callback)(void* user_data, paradox_xml1_slice slice);
+
+// Returns PARADOX_FALSE when the handler asked to stop.
+static paradox_bool8_t paradox_xml1_parser_emit(const paradox_xml1_parser_events* events, paradox_xml1_parser_slice_callback callback, const char* data, const paradox_uint64_t length)
+{
+    if(NULL == events || NULL == callback) return PARADOX_TRUE;
+    const paradox_xml1_slice slice = { data, length };
+    return callback(events->handler->user_data, slice);
 }
-// [8] Nmtokens ::= Nmtoken (#x20 Nmtoken)*
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_nm_tokens(paradox_str_t xml_string, paradox_uint64_t* index)
+
+// Emits the Comment or PI spanning [markup_index, end_index).
+static paradox_bool8_t paradox_xml1_parser_emit_markup(const paradox_xml1_input* input, const paradox_xml1_parser_events* events, const paradox_uint64_t markup_index, const paradox_uint64_t end_index)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
-    const paradox_uint64_t base_index = *index;
+    if(NULL == events) return PARADOX_TRUE;
+    const char* markup = input->data + markup_index;
+    if('!' == markup[1]) return paradox_xml1_parser_emit(events, events->handler->comment, markup + 4, end_index - markup_index - 7);
+    if(NULL == events->handler->processing_instruction) return PARADOX_TRUE;
+
+    // '<?' PITarget (S data)? '?>'
+    paradox_uint64_t index = markup_index + 2;
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_name(input, index));
+    const paradox_xml1_slice target = { markup + 2, index - markup_index - 2 };
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+    const paradox_xml1_slice data = { input->data + index, end_index - 2 > index ? end_index - 2 - index : 0 };
+    return events->handler->processing_instruction(events->handler->user_data, target, data);
+}
 
-    result = paradox_parse_xml1_nm_token(xml_string, index);
-    if(PARADOX_XML1_PARSER_SUCCESS != result) goto INVALID_PARSING;
+// Makes room for length bytes in the buffer of the parse.
+static paradox_bool8_t paradox_xml1_parser_reserve_buffer(paradox_xml1_parser_events* events, const paradox_uint64_t length)
+{
+    if(length <= events->capacity) return PARADOX_TRUE;
+    char* buffer = realloc(events->buffer, length);
+    if(NULL == buffer) return PARADOX_FALSE;
+    events->buffer = buffer;
+    events->capacity = length;
+    return PARADOX_TRUE;
+}
 
-    while('\0' != xml_string[*index])
-    {
-        paradox_uint64_t last_index = *index;
-        if(0x20 != xml_string[last_index++]) break;
-        if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_nm_token(xml_string, &last_index)) break;
-        *index = last_index;
-    }
-    result = PARADOX_XML1_PARSER_SUCCESS;
+// Emits the replacement of a run of References that have already been recognized as one piece of character data.
+static paradox_xml1_parser_errno_t paradox_xml1_parser_emit_references(paradox_xml1_parser_events* events, const char* references, const paradox_uint64_t length)
+{
+    if(NULL == events->handler->char_data) return PARADOX_XML1_PARSER_SUCCESS;
+    if(PARADOX_FALSE == paradox_xml1_parser_reserve_buffer(events, length)) return PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+    const paradox_uint64_t decoded_length = paradox_xml1_decode_value(references, length, events->buffer);
+    return PARADOX_TRUE == paradox_xml1_parser_emit(events, events->handler->char_data, events->buffer, decoded_length) ? PARADOX_XML1_PARSER_SUCCESS : PARADOX_XML1_PARSER_ABORTED;
+}
 
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
-    }
+// Checks [WFC: Unique Att Spec] for an event parse and emits the attribute.
+static paradox_xml1_parser_errno_t paradox_xml1_parser_emit_attribute(paradox_xml1_parser_events* events, const paradox_uint64_t count, const paradox_xml1_slice name, paradox_xml1_slice value)
+{
+    const paradox_xml1_parser_errno_t result = paradox_xml1_parser_unique_name(&events->unique, events->names, 1, count, name);
+    if(PARADOX_XML1_PARSER_SUCCESS != result) return result;
+    if(count == events->names_capacity)
+    {
+        const paradox_uint64_t capacity = events->names_capacity ? events->names_capacity * 2 : 16;
+        paradox_xml1_slice* names = realloc(events->names, capacity * sizeof(paradox_xml1_slice));
+        if(NULL == names) return PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+        events->names = names;
+        events->names_capacity = capacity;
+    }
+    events->names[count] = name;
+
+    // References to entities are checked even when nobody listens to the value.
+    const paradox_bool8_t references = NULL != memchr(value.data, '&', value.length);
+    if(PARADOX_TRUE == references && PARADOX_TRUE == paradox_xml1_parser_references_entities(value))
+    {
+        paradox_uint64_t length;
+        const paradox_xml1_parser_errno_t expanded = paradox_xml1_parser_measure_value(events->entities, value, &length);
+        if(PARADOX_XML1_PARSER_SUCCESS != expanded) return expanded;
+        if(NULL == events->handler->attribute) return PARADOX_XML1_PARSER_SUCCESS;
+        if(PARADOX_FALSE == paradox_xml1_parser_reserve_buffer(events, length)) return PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+        value.length = paradox_xml1_parser_expand_value(events->entities, value, events->buffer);
+        value.data = events->buffer;
+    }
+    else if(NULL == events->handler->attribute) return PARADOX_XML1_PARSER_SUCCESS;
+    else if(PARADOX_TRUE == references)
+    {
+        if(PARADOX_FALSE == paradox_xml1_parser_reserve_buffer(events, value.length)) return PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+        value.length = paradox_xml1_decode_value(value.data, value.length, events->buffer);
+        value.data = events->buffer;
+    }
+    if(PARADOX_FALSE == events->handler->attribute(events->handler->user_data, name, value)) return PARADOX_XML1_PARSER_ABORTED;
+    return PARADOX_XML1_PARSER_SUCCESS;
+}
 
-    return result;
+// Misc with a Comment or PI event for what it recognized.
+static paradox_xml1_parser_errno_t paradox_xml1_parser_event_misc(const paradox_xml1_input* input, paradox_uint64_t* index, const paradox_xml1_parser_events* events)
+{
+    const paradox_uint64_t markup_index = *index;
+    if(!paradox_xml1_parser_accept(index, paradox_xml1_parser_misc(input, *index))) return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+    if('<' == paradox_xml1_peek(input, markup_index) && PARADOX_FALSE == paradox_xml1_parser_emit_markup(input, events, markup_index, *index)) return PARADOX_XML1_PARSER_ABORTED;
+    return PARADOX_XML1_PARSER_SUCCESS;
 }
 
-// Literals
+// Validity
 
-// [9] EntityValue ::= '"' ([^%&"] | PEReference | Reference)* '"' | "'" ([^%&'] | PEReference | Reference)* "'"
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_entity_value(paradox_str_t xml_string, paradox_uint64_t* index)
+// How far the content of an element has got through the automaton the content model of its type was compiled to, while
+// a parse checks [VC: Element Valid]. type is NULL for an element that is not checked.
+struct paradox_xml1_parser_validation
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
+    const paradox_xml1_element_table* elements;
+    const paradox_xml1_element_type* type;
+    paradox_uint32_t state;
+};
+
+// Checks the element named by the length bytes of name against the content it starts in, or against the doctypedecl
+// when parent is NULL, and starts validation on its own content. [VC: Root Element Type][VC: Element Valid]
+static paradox_xml1_parser_errno_t paradox_xml1_parser_validate_element(const paradox_xml1_entity_table* entities, paradox_xml1_parser_validation* parent, const char* name, const paradox_uint64_t length, paradox_xml1_parser_validation* validation)
+{
+    const paradox_xml1_element_table* elements = entities->elements;
+    const paradox_uint32_t type = paradox_xml1_elements_find(elements, name, length);
+    if(NULL == parent)
     {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
+        if(type != elements->root) return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
     }
-    else if(NULL == index)
+    else if(NULL != parent->type && PARADOX_XML1_CONTENT_ANY != parent->type->content)
     {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
+        // EMPTY has no automaton to take the element.
+        const paradox_uint32_t state = PARADOX_XML1_CONTENT_EMPTY == parent->type->content
+            ?   PARADOX_XML1_ELEMENTS_NONE
+            :   paradox_xml1_elements_next(elements, parent->state, type);
+        if(PARADOX_XML1_ELEMENTS_NONE == state) return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+        parent->state = state;
     }
-    const paradox_uint64_t base_index = *index;
 
-    paradox_char8_t quote;
-    if('"' != xml_string[*index] || '\'' != xml_string[*index])
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
-    else
-    {
-        quote = xml_string[*index];
-        (*index)++;
-    }
-    while('\0' != xml_string[*index])
-    {
-        if(PARADOX_XML1_PARSER_SUCCESS == paradox_parse_xml1_pe_reference(xml_string, index)) continue;
-        if(PARADOX_XML1_PARSER_SUCCESS == paradox_parse_xml1_reference(xml_string, index)) continue;
-        if(PARADOX_FALSE == paradox_is_xml1_char(xml_string, *index)) break;
-        if('%' != xml_string[*index] && '&' != xml_string[*index] && quote != xml_string[*index])
-        {
-            paradox_xml1_parser_next_index(xml_string, index);
-            continue;
-        }
-        break;
-    }
-    if(quote != xml_string[*index])
+    validation->elements = elements;
+    validation->type = NULL;
+    if(PARADOX_XML1_ELEMENTS_NONE != type && PARADOX_TRUE == elements->types[type].declared)
     {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
+        validation->type = &elements->types[type];
+        validation->state = validation->type->start;
     }
-    else (*index)++;
-    result = PARADOX_XML1_PARSER_SUCCESS;
+    else if(PARADOX_FALSE == entities->incomplete) return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+    return PARADOX_XML1_PARSER_SUCCESS;
+}
 
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
+// Whether the content validation is on may hold the length bytes of character data at data. Element content only holds
+// white space, which neither a CDATA section nor a character reference are even when they stand for some, so their data
+// is passed as NULL. An EMPTY element holds nothing at all.
+static inline paradox_bool8_t paradox_xml1_parser_validate_text(const paradox_xml1_parser_validation* validation, const char* data, const paradox_uint64_t length)
+{
+    if(NULL == validation || NULL == validation->type) return PARADOX_TRUE;
+    if(PARADOX_XML1_CONTENT_EMPTY == validation->type->content) return PARADOX_FALSE;
+    if(PARADOX_XML1_CONTENT_CHILDREN != validation->type->content) return PARADOX_TRUE;
+    if(NULL == data) return PARADOX_FALSE;
+    for(paradox_uint64_t i = 0; i < length; i++)
     {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
+        if(' ' != data[i] && '\t' != data[i] && '\n' != data[i] && '\r' != data[i]) return PARADOX_FALSE;
     }
-    
-    return result;
+    return PARADOX_TRUE;
 }
-// [10] AttValue ::= '"' ([^<&"] | Reference)* '"' | "'" ([^<&'] | Reference)* "'"
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_att_value(paradox_str_t xml_string, paradox_uint64_t* index)
+
+// Whether the content validation is on may hold a Comment or PI, which only EMPTY rules out.
+static inline paradox_bool8_t paradox_xml1_parser_validate_misc(const paradox_xml1_parser_validation* validation)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
+    return NULL == validation || NULL == validation->type || PARADOX_XML1_CONTENT_EMPTY != validation->type->content;
+}
+
+// Whether the content validation is on may end where it got to.
+static inline paradox_bool8_t paradox_xml1_parser_validate_end(const paradox_xml1_parser_validation* validation)
+{
+    if(NULL == validation->type) return PARADOX_TRUE;
+    if(PARADOX_XML1_CONTENT_MIXED != validation->type->content && PARADOX_XML1_CONTENT_CHILDREN != validation->type->content) return PARADOX_TRUE;
+    return validation->elements->accepting[validation->state];
+}
+
+// Entities
+
+static paradox_xml1_parser_errno_t paradox_xml1_parser_content_pieces(const paradox_xml1_input* input, paradox_uint64_t* index, paradox_xml1_document* document, paradox_xml1_parser_events* events, paradox_xml1_element* parent, paradox_xml1_parser_text* text, paradox_xml1_element** last_child, paradox_xml1_parser_validation* validation, const paradox_uint64_t stop);
+static paradox_xml1_parser_errno_t paradox_xml1_parser_expand_entity(paradox_xml1_entity_table* entities, paradox_xml1_entity* entity);
+
+// Whether the Reference of length bytes at reference refers to an entity other than the predefined ones.
+static inline paradox_bool8_t paradox_xml1_parser_entity_reference(const char* reference, const paradox_uint64_t length)
+{
+    return '#' != reference[1] && '\0' == paradox_xml1_decode_predefined(reference, length);
+}
+
+// Whether text, an AttValue or character data that has already been recognized, holds such a reference.
+static paradox_bool8_t paradox_xml1_parser_references_entities(const paradox_xml1_slice text)
+{
+    const char* end = text.data + text.length;
+    for(const char* reference = memchr(text.data, '&', text.length); NULL != reference; reference = memchr(reference + 1, '&', (paradox_uint64_t)(end - reference - 1)))
     {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
+        const char* semicolon = memchr(reference, ';', (paradox_uint64_t)(end - reference));
+        if(PARADOX_TRUE == paradox_xml1_parser_entity_reference(reference, (paradox_uint64_t)(semicolon - reference) + 1)) return PARADOX_TRUE;
     }
-    const paradox_uint64_t base_index = *index;
+    return PARADOX_FALSE;
+}
 
-    paradox_char8_t quote;
-    if('"' != xml_string[*index] || '\'' != xml_string[*index])
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
-    else
-    {
-        quote = xml_string[*index];
-        (*index)++;
+// Replaces the character references and parameter-entity references of literal, an EntityValue without its quotes,
+// into output from *length on, or only counts the bytes when output is NULL. References to general entities are kept
+// as they are written. Counting expands the parameter entities and spends the bytes they add. [WFC: Entity Declared]
+static paradox_xml1_parser_errno_t paradox_xml1_parser_replace_literal(paradox_xml1_entity_table* entities, const paradox_xml1_slice literal, char* output, paradox_uint64_t* length)
+{
+    paradox_uint64_t index = 0;
+    while(index < literal.length)
+    {
+        paradox_uint64_t end = index;
+        while(end < literal.length && '&' != literal.data[end] && '%' != literal.data[end]) end++;
+        if(NULL != output) memcpy(output + *length, literal.data + index, end - index);
+        *length += end - index;
+        if(end == literal.length) break;
+
+        const char* reference = literal.data + end;
+        const paradox_uint64_t reference_length = (paradox_uint64_t)((const char*)memchr(reference, ';', literal.length - end) - reference) + 1;
+        index = end + reference_length;
+        if('&' == reference[0] && '#' == reference[1])
+        {
+            paradox_uint32_t code = 0;
+            char character[4];
+            if(0 == paradox_xml1_decode_char_ref(reference, reference_length, &code)) return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+            *length += paradox_xml1_encode_utf8(code, NULL != output ? output + *length : character);
+        }
+        else if('&' == reference[0])
+        {
+            if(NULL != output) memcpy(output + *length, reference, reference_length);
+            *length += reference_length;
+        }
+        else
+        {
+            paradox_xml1_entity* parameter = paradox_xml1_entities_find(entities, reference + 1, reference_length - 2, PARADOX_TRUE);
+            if(NULL == parameter || PARADOX_TRUE == parameter->external) return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+            if(NULL == output)
+            {
+                const paradox_xml1_parser_errno_t result = paradox_xml1_parser_expand_entity(entities, parameter);
+                if(PARADOX_XML1_PARSER_SUCCESS != result) return result;
+                if(PARADOX_FALSE == paradox_xml1_entities_charge(entities, parameter->replacement.length)) return PARADOX_XML1_PARSER_ENTITY_LIMIT;
+            }
+            else memcpy(output + *length, parameter->replacement.data, parameter->replacement.length);
+            *length += parameter->replacement.length;
+        }
     }
-    while('\0' != xml_string[*index])
+    return PARADOX_XML1_PARSER_SUCCESS;
+}
+
+// Replaces the References of length bytes of text, the replacement text of an entity or an AttValue, into output from
+// *length on, or only counts the bytes when output is NULL. Counting recognizes the references, expands the entities
+// they refer to and spends the bytes their expansions add. It sets markup and stops once text holds markup or refers
+// to an entity that has to be parsed as content, which an AttValue cannot. References to undeclared entities are kept
+// as they are written when the entities that are not read may declare them. [WFC: Entity Declared][WFC: Parsed Entity]
+static paradox_xml1_parser_errno_t paradox_xml1_parser_replace_references(paradox_xml1_entity_table* entities, const char* text, const paradox_uint64_t text_length, char* output, paradox_uint64_t* length, paradox_bool8_t* markup)
+{
+    const paradox_xml1_input input = { text, text_length, PARADOX_FALSE };
+    paradox_uint64_t index = 0;
+    while(index < text_length)
     {
-        if(PARADOX_XML1_PARSER_SUCCESS == paradox_parse_xml1_reference(xml_string, index)) continue;
-        if(PARADOX_FALSE == paradox_is_xml1_char(xml_string, *index)) break;
-        if('%' != xml_string[*index] && '&' != xml_string[*index] && quote != xml_string[*index])
+        const char* reference = memchr(text + index, '&', text_length - index);
+        const paradox_uint64_t end = NULL != reference ? (paradox_uint64_t)(reference - text) : text_length;
+        if(NULL == output && NULL != memchr(text + index, '<', end - index))
+        {
+            *markup = PARADOX_TRUE;
+            return PARADOX_XML1_PARSER_SUCCESS;
+        }
+        if(NULL != output) memcpy(output + *length, text + index, end - index);
+        *length += end - index;
+        if(NULL == reference) break;
+
+        index = paradox_xml1_parser_reference(&input, end);
+        if(PARADOX_XML1_PARSER_NO_MATCH == index) return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+        const paradox_uint64_t reference_length = index - end;
+        char character[4];
+        char* destination = NULL != output ? output + *length : character;
+        if('#' == reference[1])
         {
-            paradox_xml1_parser_next_index(xml_string, index);
+            paradox_uint32_t code = 0;
+            if(0 == paradox_xml1_decode_char_ref(reference, reference_length, &code)) return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+            *length += paradox_xml1_encode_utf8(code, destination);
             continue;
         }
-        break;
-    }
-    if(quote != xml_string[*index])
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
+        const char predefined = paradox_xml1_decode_predefined(reference, reference_length);
+        if('\0' != predefined)
+        {
+            *destination = predefined;
+            (*length)++;
+            continue;
+        }
+
+        paradox_xml1_entity* entity = paradox_xml1_entities_find(entities, reference + 1, reference_length - 2, PARADOX_FALSE);
+        if(NULL == entity)
+        {
+            if(NULL == entities || PARADOX_FALSE == entities->incomplete) return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+            if(NULL != output) memcpy(destination, reference, reference_length);
+            *length += reference_length;
+            continue;
+        }
+        if(PARADOX_TRUE == entity->unparsed) return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+        if(NULL == output)
+        {
+            // An external parsed entity is not read, so its reference stays in content. [WFC: No External Entity References]
+            if(PARADOX_FALSE == entity->external)
+            {
+                const paradox_xml1_parser_errno_t result = paradox_xml1_parser_expand_entity(entities, entity);
+                if(PARADOX_XML1_PARSER_SUCCESS != result) return result;
+            }
+            if(PARADOX_TRUE == entity->external || PARADOX_TRUE == entity->markup)
+            {
+                *markup = PARADOX_TRUE;
+                return PARADOX_XML1_PARSER_SUCCESS;
+            }
+            if(PARADOX_FALSE == paradox_xml1_entities_charge(entities, entity->expansion.length)) return PARADOX_XML1_PARSER_ENTITY_LIMIT;
+        }
+        else memcpy(destination, entity->expansion.data, entity->expansion.length);
+        *length += entity->expansion.length;
     }
-    else (*index)++;
-    result = PARADOX_XML1_PARSER_SUCCESS;
+    return PARADOX_XML1_PARSER_SUCCESS;
+}
 
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
+// Expands entity the first time it is referenced: its replacement text, and for a general entity whose replacement
+// text is character data also its expansion, which every later reference copies. Both stay in the arena of the table.
+// The bytes are spent where they are copied, so the budget counts every reference. [WFC: No Recursion]
+static paradox_xml1_parser_errno_t paradox_xml1_parser_expand_entity(paradox_xml1_entity_table* entities, paradox_xml1_entity* entity)
+{
+    if(PARADOX_XML1_ENTITY_EXPANDED == entity->state) return PARADOX_XML1_PARSER_SUCCESS;
+    if(PARADOX_XML1_ENTITY_EXPANDING == entity->state) return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+    if(entities->depth >= entities->depth_limit) return PARADOX_XML1_PARSER_ENTITY_LIMIT;
+    entity->state = PARADOX_XML1_ENTITY_EXPANDING;
+    entities->depth++;
+
+    paradox_uint64_t length = 0;
+    char* output = NULL;
+    paradox_xml1_parser_errno_t result = paradox_xml1_parser_replace_literal(entities, entity->literal, NULL, &length);
+    if(PARADOX_XML1_PARSER_SUCCESS == result && NULL == (output = paradox_xml1_arena_alloc(&entities->arena, length))) result = PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+    if(PARADOX_XML1_PARSER_SUCCESS == result)
+    {
+        entity->replacement.data = output;
+        entity->replacement.length = 0;
+        paradox_xml1_parser_replace_literal(entities, entity->literal, output, &entity->replacement.length);
+    }
+    if(PARADOX_XML1_PARSER_SUCCESS == result && PARADOX_FALSE == entity->parameter)
+    {
+        length = 0;
+        result = paradox_xml1_parser_replace_references(entities, entity->replacement.data, entity->replacement.length, NULL, &length, &entity->markup);
+        if(PARADOX_XML1_PARSER_SUCCESS == result && PARADOX_FALSE == entity->markup)
+        {
+            if(NULL == (output = paradox_xml1_arena_alloc(&entities->arena, length))) result = PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+            else
+            {
+                entity->expansion.data = output;
+                entity->expansion.length = 0;
+                paradox_xml1_parser_replace_references(entities, entity->replacement.data, entity->replacement.length, output, &entity->expansion.length, &entity->markup);
+            }
+        }
     }
-    
+
+    entities->depth--;
+    entity->state = PARADOX_XML1_PARSER_SUCCESS == result ? PARADOX_XML1_ENTITY_EXPANDED : PARADOX_XML1_ENTITY_DECLARED;
     return result;
 }
-// [11] SystemLiteral ::= ('"' [^"]* '"') | ("'" [^']* "'")
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_system_literal(paradox_str_t xml_string, paradox_uint64_t* index)
+
+// The bytes value, an AttValue without its quotes that references entities, expands to. [WFC: No < in Attribute Values]
+static paradox_xml1_parser_errno_t paradox_xml1_parser_measure_value(paradox_xml1_entity_table* entities, const paradox_xml1_slice value, paradox_uint64_t* length)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
+    paradox_bool8_t markup = PARADOX_FALSE;
+    *length = 0;
+    const paradox_xml1_parser_errno_t result = paradox_xml1_parser_replace_references(entities, value.data, value.length, NULL, length, &markup);
+    return PARADOX_XML1_PARSER_SUCCESS == result && PARADOX_TRUE == markup ? PARADOX_XML1_PARSER_INVALID_DOCUMENT : result;
+}
+
+// Expands value into output once paradox_xml1_parser_measure_value accepted it and returns its length.
+static paradox_uint64_t paradox_xml1_parser_expand_value(paradox_xml1_entity_table* entities, const paradox_xml1_slice value, char* output)
+{
+    paradox_bool8_t markup = PARADOX_FALSE;
+    paradox_uint64_t length = 0;
+    paradox_xml1_parser_replace_references(entities, value.data, value.length, output, &length, &markup);
+    return length;
+}
+
+// Includes the entity the EntityRef of length bytes at reference refers to in the content of parent, as if its
+// replacement text stood in place of the reference. Character data is appended from the cached expansion, markup
+// is parsed as content of its own, which has to be balanced. References to entities that are not read are kept as
+// they are written, and validated as the character data they stay. [WFC: Entity Declared][WFC: Parsed Entity][WFC: No Recursion]
+static paradox_xml1_parser_errno_t paradox_xml1_parser_include_entity(const char* reference, const paradox_uint64_t length, paradox_xml1_document* document, paradox_xml1_parser_events* events, paradox_xml1_element* parent, paradox_xml1_parser_text* text, paradox_xml1_element** last_child, paradox_xml1_parser_validation* validation)
+{
+    paradox_xml1_entity_table* entities = NULL != document ? document->entities : events->entities;
+    paradox_xml1_entity* entity = paradox_xml1_entities_find(entities, reference + 1, length - 2, PARADOX_FALSE);
+    if(NULL == entity ? NULL == entities || PARADOX_FALSE == entities->incomplete : PARADOX_TRUE == entity->unparsed) return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+    if(NULL == entity || PARADOX_TRUE == entity->external)
+    {
+        if(PARADOX_FALSE == paradox_xml1_parser_validate_text(validation, NULL, 0)) return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+        if(NULL != document && PARADOX_FALSE == paradox_xml1_parser_append_reference(&document->arena, text, reference, length)) return PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+        return NULL != events ? paradox_xml1_parser_emit_references(events, reference, length) : PARADOX_XML1_PARSER_SUCCESS;
+    }
+    paradox_xml1_parser_errno_t result = paradox_xml1_parser_expand_entity(entities, entity);
+    if(PARADOX_XML1_PARSER_SUCCESS != result) return result;
+    if(PARADOX_FALSE == entity->markup)
+    {
+        if(PARADOX_FALSE == paradox_xml1_parser_validate_text(validation, entity->expansion.data, entity->expansion.length)) return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+        if(PARADOX_FALSE == paradox_xml1_entities_charge(entities, entity->expansion.length)) return PARADOX_XML1_PARSER_ENTITY_LIMIT;
+        if(0 == entity->expansion.length) return PARADOX_XML1_PARSER_SUCCESS;
+        if(NULL != document && PARADOX_FALSE == paradox_xml1_parser_append_literal(&document->arena, text, entity->expansion.data, entity->expansion.length)) return PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+        if(NULL != events && PARADOX_FALSE == paradox_xml1_parser_emit(events, events->handler->char_data, entity->expansion.data, entity->expansion.length)) return PARADOX_XML1_PARSER_ABORTED;
+        return PARADOX_XML1_PARSER_SUCCESS;
+    }
+
+    if(PARADOX_FALSE == paradox_xml1_entities_charge(entities, entity->replacement.length)) return PARADOX_XML1_PARSER_ENTITY_LIMIT;
+    if(entities->depth >= entities->depth_limit) return PARADOX_XML1_PARSER_ENTITY_LIMIT;
+    const paradox_xml1_input replacement = { entity->replacement.data, entity->replacement.length, PARADOX_FALSE };
+    paradox_uint64_t index = 0;
+    entity->state = PARADOX_XML1_ENTITY_EXPANDING;
+    entities->depth++;
+    result = paradox_xml1_parser_content_pieces(&replacement, &index, document, events, parent, text, last_child, validation, replacement.length);
+    entities->depth--;
+    entity->state = PARADOX_XML1_ENTITY_EXPANDED;
+    if(PARADOX_XML1_PARSER_SUCCESS == result && index != replacement.length) result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+    return result;
+}
+
+// Structural Index
+
+// An element whose content the walk of the structural index is in.
+typedef struct paradox_xml1_parser_open_element
+{
+    paradox_xml1_element* element;
+    paradox_xml1_element* last_child;
+    paradox_xml1_parser_text text;
+    paradox_xml1_slice name;
+} paradox_xml1_parser_open_element;
+
+// The first structural at or after index. The index ends with the length of the input, which no production passes.
+static inline const paradox_uint32_t* paradox_xml1_parser_next_structural(const paradox_uint32_t* structural, const paradox_uint64_t index)
+{
+    while(*structural < index) structural++;
+    return structural;
+}
+
+static inline void paradox_xml1_parser_append_child(paradox_xml1_parser_open_element* parent, paradox_xml1_element* child)
+{
+    if(NULL == child) return;
+    child->parent = parent->element;
+    if(NULL == parent->last_child) parent->element->children = child;
+    else parent->last_child->next = child;
+    parent->last_child = child;
+}
+
+// Name at index, which ends before bound, the next structural. The first stage validated the bytes, so ASCII is
+// classified byte by byte without decoding it. A Name with other characters goes through the production.
+static inline paradox_uint64_t paradox_xml1_parser_indexed_name(const paradox_xml1_input* input, const paradox_uint64_t index, const paradox_uint64_t bound)
+{
+    const unsigned char* data = (const unsigned char*)input->data;
+    paradox_uint64_t end = index;
+    if(end < bound && data[end] < 0x80 && (paradox_xml1_character_blocks[0][data[end]] & PARADOX_XML1_CHARACTER_NAME_START))
     {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
+        do end++;
+        while(end < bound && data[end] < 0x80 && (paradox_xml1_character_blocks[0][data[end]] & PARADOX_XML1_CHARACTER_NAME));
+        if(end == bound || data[end] < 0x80) return end;
     }
-    else if(NULL == index)
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
+    return paradox_xml1_parser_name(input, index);
+}
+
+// S? from index up to bound, the next structural. Returns index when there is none.
+static inline paradox_uint64_t paradox_xml1_parser_indexed_space(const paradox_xml1_input* input, paradox_uint64_t index, const paradox_uint64_t bound)
+{
+    const char* data = input->data;
+    while(index < bound && (' ' == data[index] || '\n' == data[index] || '\t' == data[index] || '\r' == data[index])) index++;
+    return index;
+}
+
+// '<' Name (S Attribute)* S? ('>' | '/>') starting at the '<' *structural points to, which is moved past the closing '>'.
+// Only the names and spaces between the structurals are parsed: each attribute ends its name before the next '=' and
+// its value at the next matching quote, and a value that neither holds '<' nor '&' is valid Char data already.
+static paradox_xml1_parser_errno_t paradox_xml1_parser_indexed_tag(const paradox_xml1_input* input, const paradox_uint32_t** structural, paradox_xml1_document* document, paradox_xml1_parser_events* events, paradox_xml1_element** element, paradox_xml1_slice* name, paradox_bool8_t* empty)
+{
+    const paradox_uint32_t* next = *structural;
+    const paradox_uint64_t name_index = *next + 1;
+    paradox_uint64_t index = paradox_xml1_parser_indexed_name(input, name_index, next[1]);
+    if(PARADOX_XML1_PARSER_NO_MATCH == index) return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+    name->data = input->data + name_index;
+    name->length = index - name_index;
+    paradox_xml1_element* created = NULL;
+    if(NULL != document)
+    {
+        created = paradox_xml1_parser_create_element(document, *name);
+        if(NULL == created) return PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+    }
+    if(NULL != events && PARADOX_FALSE == paradox_xml1_parser_emit(events, events->handler->start_element, name->data, name->length)) return PARADOX_XML1_PARSER_ABORTED;
+
+    paradox_xml1_attribute* last_attribute = NULL;
+    paradox_uint64_t attribute_count = 0;
+    for(next++; '=' == paradox_xml1_peek(input, *next); next++)
+    {
+        // S Name S? '=' S? around the '=' indexed next, and the opening quote right after it.
+        const paradox_uint64_t attribute_index = paradox_xml1_parser_indexed_space(input, index, *next);
+        if(attribute_index == index) return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+        index = paradox_xml1_parser_indexed_name(input, attribute_index, *next);
+        if(PARADOX_XML1_PARSER_NO_MATCH == index) return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+        const paradox_xml1_slice attribute_name = { input->data + attribute_index, index - attribute_index };
+        if(paradox_xml1_parser_indexed_space(input, index, *next) != *next) return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+        index = paradox_xml1_parser_indexed_space(input, *next + 1, next[1]);
+        if(index != *(++next)) return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+        const paradox_char8_t quote = paradox_xml1_peek(input, index);
+        if('"' != quote && '\'' != quote) return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+
+        // [WFC: No < in Attribute Values]; references still have to be recognized.
+        paradox_bool8_t references = PARADOX_FALSE;
+        for(next++; quote != paradox_xml1_peek(input, *next); next++)
+        {
+            if('&' != paradox_xml1_peek(input, *next)) return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+            references = PARADOX_TRUE;
+        }
+        if(PARADOX_TRUE == references && *next + 1 != paradox_xml1_parser_att_value(input, index)) return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+        const paradox_xml1_slice attribute_value = { input->data + index + 1, *next - index - 1 };
+        index = *next + 1;
+
+        if(NULL != document)
+        {
+            paradox_xml1_attribute* attribute = NULL;
+            paradox_xml1_parser_errno_t result = paradox_xml1_parser_create_attribute(document, attribute_name, attribute_value, references, &attribute);
+            if(PARADOX_XML1_PARSER_SUCCESS != result) return result;
+            result = paradox_xml1_parser_add_attribute(document, created, &last_attribute, attribute);
+            if(PARADOX_XML1_PARSER_SUCCESS != result) return result;
+        }
+        if(NULL != events)
+        {
+            const paradox_xml1_parser_errno_t result = paradox_xml1_parser_emit_attribute(events, attribute_count, attribute_name, attribute_value);
+            if(PARADOX_XML1_PARSER_SUCCESS != result) return result;
+        }
+        attribute_count++;
     }
-    const paradox_uint64_t base_index = *index;
 
-    paradox_char8_t quote;
-    if('"' != xml_string[*index] || '\'' != xml_string[*index])
+    index = paradox_xml1_parser_indexed_space(input, index, *next);
+    if(index != *next) return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+    *empty = '/' == paradox_xml1_peek(input, index);
+    if(PARADOX_TRUE == *empty) next++;
+    if('>' != paradox_xml1_peek(input, *next) || *next != index + *empty) return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+    *structural = next + 1;
+    *element = created;
+    return PARADOX_XML1_PARSER_SUCCESS;
+}
+
+// [39] element walked along the structural index, which the first stage built over the whole validated input.
+// The open elements live on an explicit stack. Comments, PIs, CDATA sections, references and end-tags are
+// recognized by their productions; character data runs from one structural to the next without being looked at,
+// except for the ']' that could start a ']]>'.
+static paradox_xml1_parser_errno_t paradox_xml1_parser_indexed_element(const paradox_xml1_input* input, paradox_uint64_t* index, const paradox_xml1_index* structurals, paradox_xml1_document* document, paradox_xml1_parser_events* events, paradox_xml1_element** element)
+{
+    paradox_xml1_parser_errno_t result;
+    paradox_xml1_parser_open_element* open = NULL;
+    paradox_uint64_t depth = 0;
+    paradox_uint64_t capacity = 0;
+    paradox_uint64_t text_index = *index;
+
+    const paradox_uint32_t* structural = paradox_xml1_parser_next_structural(structurals->positions, *index);
+    if(*structural != *index || '<' != paradox_xml1_peek(input, *index))
     {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
+        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
         goto INVALID_PARSING;
     }
-    else
-    {
-        quote = xml_string[*index];
-        (*index)++;
-    }
-    while('\0' != xml_string[*index])
+    for(;;)
     {
-        if(PARADOX_FALSE == paradox_is_xml1_char(xml_string, *index)) break;
-        if(quote != xml_string[*index])
+        paradox_xml1_element* created = NULL;
+        paradox_xml1_slice name;
+        paradox_bool8_t empty;
+        result = paradox_xml1_parser_indexed_tag(input, &structural, document, events, &created, &name, &empty);
+        if(PARADOX_XML1_PARSER_SUCCESS != result) goto INVALID_PARSING;
+        text_index = structural[-1] + 1;
+        if(0 == depth && NULL != element) *element = created;
+        if(0 != depth) paradox_xml1_parser_append_child(&open[depth - 1], created);
+        if(PARADOX_TRUE == empty)
         {
-            paradox_xml1_parser_next_index(xml_string, index);
-            continue;
+            if(NULL != events && PARADOX_FALSE == paradox_xml1_parser_emit(events, events->handler->end_element, name.data, name.length))
+            {
+                result = PARADOX_XML1_PARSER_ABORTED;
+                goto INVALID_PARSING;
+            }
+            if(0 == depth) break;
         }
-        break;
-    }
-    if(quote != xml_string[*index])
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
+        else
+        {
+            if(depth == capacity)
+            {
+                capacity = capacity ? capacity * 2 : 32;
+                paradox_xml1_parser_open_element* grown = realloc(open, capacity * sizeof(paradox_xml1_parser_open_element));
+                if(NULL == grown)
+                {
+                    result = PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+                    goto INVALID_PARSING;
+                }
+                open = grown;
+            }
+            const paradox_xml1_parser_open_element opened = { created, NULL, { NULL, 0, NULL, 0, PARADOX_FALSE, PARADOX_FALSE }, name };
+            open[depth++] = opened;
+        }
+
+        // Content of the innermost open element up to its next child.
+        while(0 != depth)
+        {
+            paradox_xml1_parser_open_element* parent = &open[depth - 1];
+            const paradox_uint64_t markup_index = *structural;
+            const paradox_char8_t byte = paradox_xml1_peek(input, markup_index);
+            // A ']' only ends the character data when it starts ']]>', which is not well-formed.
+            if(']' == byte && paradox_xml1_compare(input, markup_index, "]]>", 3))
+            {
+                structural++;
+                continue;
+            }
+            if(markup_index != text_index)
+            {
+                if(NULL != document && PARADOX_FALSE == paradox_xml1_parser_append_text(&document->arena, &parent->text, input->data + text_index, markup_index - text_index))
+                {
+                    result = PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+                    goto INVALID_PARSING;
+                }
+                if(NULL != events && PARADOX_FALSE == paradox_xml1_parser_emit(events, events->handler->char_data, input->data + text_index, markup_index - text_index))
+                {
+                    result = PARADOX_XML1_PARSER_ABORTED;
+                    goto INVALID_PARSING;
+                }
+            }
+
+            paradox_uint64_t end_index = PARADOX_XML1_PARSER_NO_MATCH;
+            const paradox_char8_t marker = paradox_xml1_peek(input, markup_index + 1);
+            if(']' == byte)
+            {
+                result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+                goto INVALID_PARSING;
+            }
+            if('&' == byte)
+            {
+                // A run of references is taken in one go; the structurals of the ones after the first are skipped below.
+                // A run ends before a '&' that starts no reference, which then fails on its own, and before a reference
+                // to an entity, which no document parsed along the index declares. [WFC: Entity Declared]
+                end_index = markup_index;
+                do
+                {
+                    const paradox_uint64_t reference_end = paradox_xml1_parser_reference(input, end_index);
+                    if(PARADOX_XML1_PARSER_NO_MATCH == reference_end || PARADOX_TRUE == paradox_xml1_parser_entity_reference(input->data + end_index, reference_end - end_index)) break;
+                    end_index = reference_end;
+                }
+                while('&' == paradox_xml1_peek(input, end_index));
+                if(markup_index == end_index)
+                {
+                    result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+                    goto INVALID_PARSING;
+                }
+                if(NULL != document && PARADOX_FALSE == paradox_xml1_parser_append_reference(&document->arena, &parent->text, input->data + markup_index, end_index - markup_index))
+                {
+                    result = PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+                    goto INVALID_PARSING;
+                }
+                if(NULL != events)
+                {
+                    result = paradox_xml1_parser_emit_references(events, input->data + markup_index, end_index - markup_index);
+                    if(PARADOX_XML1_PARSER_SUCCESS != result) goto INVALID_PARSING;
+                }
+            }
+            else if('<' != byte)
+            {
+                // Only the sentinel at the end of the input is none of them.
+                result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+                goto INVALID_PARSING;
+            }
+            else if('/' == marker)
+            {
+                // [WFC: Element Type Match] against the Name of the start-tag, which leaves S? '>' of the ETag to parse.
+                end_index = markup_index + 2 + parent->name.length;
+                if(PARADOX_FALSE == paradox_xml1_parser_end_tag_matches(input, markup_index + 2, parent->name.data, parent->name.length))
+                {
+                    result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+                    goto INVALID_PARSING;
+                }
+                paradox_xml1_parser_accept(&end_index, paradox_xml1_parser_space(input, end_index));
+                if('>' != paradox_xml1_peek(input, end_index++))
+                {
+                    result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+                    goto INVALID_PARSING;
+                }
+                if(NULL != parent->element) paradox_xml1_parser_set_value(parent->element, &parent->text);
+                if(NULL != events && PARADOX_FALSE == paradox_xml1_parser_emit(events, events->handler->end_element, parent->name.data, parent->name.length))
+                {
+                    result = PARADOX_XML1_PARSER_ABORTED;
+                    goto INVALID_PARSING;
+                }
+                depth--;
+            }
+            else if('?' == marker || ('!' == marker && '-' == paradox_xml1_peek(input, markup_index + 2)))
+            {
+                end_index = '?' == marker ? paradox_xml1_parser_pi(input, markup_index) : paradox_xml1_parser_comment(input, markup_index);
+                if(PARADOX_XML1_PARSER_NO_MATCH == end_index)
+                {
+                    result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+                    goto INVALID_PARSING;
+                }
+                if(PARADOX_FALSE == paradox_xml1_parser_emit_markup(input, events, markup_index, end_index))
+                {
+                    result = PARADOX_XML1_PARSER_ABORTED;
+                    goto INVALID_PARSING;
+                }
+            }
+            else if('!' == marker)
+            {
+                end_index = paradox_xml1_parser_cd_sect(input, markup_index);
+                if(PARADOX_XML1_PARSER_NO_MATCH == end_index)
+                {
+                    result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+                    goto INVALID_PARSING;
+                }
+                // Only the CData between '<![CDATA[' and ']]>' belongs to the value.
+                if(NULL != document && PARADOX_FALSE == paradox_xml1_parser_append_literal(&document->arena, &parent->text, input->data + markup_index + 9, end_index - markup_index - 12))
+                {
+                    result = PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+                    goto INVALID_PARSING;
+                }
+                if(NULL != events && PARADOX_FALSE == paradox_xml1_parser_emit(events, events->handler->cdata, input->data + markup_index + 9, end_index - markup_index - 12))
+                {
+                    result = PARADOX_XML1_PARSER_ABORTED;
+                    goto INVALID_PARSING;
+                }
+            }
+            else break;
+            text_index = end_index;
+            structural = paradox_xml1_parser_next_structural(structural, end_index);
+        }
+        if(0 == depth) break;
     }
-    else (*index)++;
+    *index = text_index;
     result = PARADOX_XML1_PARSER_SUCCESS;
 
     INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
-    }
-    
+    free(open);
+
     return result;
 }
-// [12] PubidLiteral ::= '"' PubidChar* '"' | "'" (PubidChar - "'")* "'"
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_pubid_literal(paradox_str_t xml_string, paradox_uint64_t* index)
+
+// Split Parse
+
+// Content of the root element per thread below which a split does not pay for the thread. A run costs about
+// 50us on top of its parse, for starting the thread, its arena and merging, which is under 5% of the 1.2ms
+// a thread takes for 256 KiB at 200 MB/s. Validating the input starts the threads once more.
+#define PARADOX_XML1_PARSER_SPLIT_MIN_LENGTH (256 * 1024)
+
+// A run of the content of the root element parsed on a thread of its own into a shard with its own arena.
+// The run starts at a speculative split and ends after the piece of content that reaches stop, the next
+// split, or earlier where the content of the root ends. When the input is validated, a thread validates a
+// share of it first, and no run is parsed before every share is known to be valid.
+typedef struct paradox_xml1_parser_split
 {
+    const paradox_xml1_input* input;
+    paradox_uint64_t start;
+    paradox_uint64_t stop;
+    paradox_uint64_t end;
+    paradox_uint64_t validate_index;
+    paradox_uint64_t validate_length;
+    paradox_bool8_t valid;
+    // Stands in for the root element: collects the top-level children and text of the run.
+    paradox_xml1_element parent;
+    // The root element the children of the run are handed to, and the last of them.
+    paradox_xml1_element* root;
+    paradox_xml1_element* last;
+    paradox_xml1_document shard;
     paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
-    const paradox_uint64_t base_index = *index;
+    paradox_xml1_thread thread;
+    paradox_bool8_t threaded;
 
-    paradox_char8_t quote;
-    if('"' != xml_string[*index] || '\'' != xml_string[*index])
+} paradox_xml1_parser_split;
+
+// Points the children of the run at the root on the thread of the run, so that stitching the runs together
+// only links the first child of every run behind the last one of the run before.
+static void paradox_xml1_parser_adopt(paradox_xml1_parser_split* split)
+{
+    for(paradox_xml1_element* child = split->parent.children; NULL != child; child = child->next)
     {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
+        child->parent = split->root;
+        split->last = child;
     }
-    else
+}
+
+static void paradox_xml1_parser_validate_split(void* argument)
+{
+    paradox_xml1_parser_split* split = argument;
+    split->valid = split->validate_length == paradox_xml1_validate(split->input->data + split->validate_index, split->validate_length);
+}
+
+static void paradox_xml1_parser_run_split(void* argument)
+{
+    paradox_xml1_parser_split* split = argument;
+    split->end = split->start;
+    split->result = paradox_xml1_parser_content(split->input, &split->end, &split->shard, NULL, &split->parent, NULL, split->stop);
+    if(PARADOX_XML1_PARSER_SUCCESS == split->result) paradox_xml1_parser_adopt(split);
+}
+
+// Runs routine on every split, each on a thread of its own but the first, which runs on the calling thread
+// together with those no thread could be started for. Returns once all of them returned.
+static void paradox_xml1_parser_run_splits(paradox_xml1_parser_split* splits, const paradox_uint64_t count, void (*routine)(void* argument))
+{
+    for(paradox_uint64_t split = 1; split < count; split++)
     {
-        quote = xml_string[*index];
-        (*index)++;
+        splits[split].threaded = paradox_xml1_thread_start(&splits[split].thread, routine, &splits[split]);
     }
-    while('\0' != xml_string[*index])
+    for(paradox_uint64_t split = 0; split < count; split++)
     {
-        if(PARADOX_FALSE == paradox_is_xml1_pubid_char(xml_string, *index)) break;
-        if(('"' == quote) || ('\'' == quote && '\'' != xml_string[*index]))
-        {
-            paradox_xml1_parser_next_index(xml_string, index);
-            continue;
-        }
-        break;
+        if(PARADOX_FALSE == splits[split].threaded) routine(&splits[split]);
     }
-    if(quote != xml_string[*index])
+    for(paradox_uint64_t split = 1; split < count; split++)
     {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
+        if(PARADOX_TRUE == splits[split].threaded) paradox_xml1_thread_join(&splits[split].thread);
     }
-    else (*index)++;
-    result = PARADOX_XML1_PARSER_SUCCESS;
+}
 
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
+// Position of the '<' of the first start-tag of the content from index, or PARADOX_XML1_PARSER_NO_MATCH
+// when the content ends before one.
+static paradox_uint64_t paradox_xml1_parser_first_child(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    for(;;)
+    {
+        paradox_xml1_parser_accept(&index, paradox_xml1_parser_char_data(input, index));
+        const paradox_char8_t marker = paradox_xml1_peek(input, index + 1);
+        paradox_uint64_t next;
+        if('&' == paradox_xml1_peek(input, index)) next = paradox_xml1_parser_reference(input, index);
+        else if('<' != paradox_xml1_peek(input, index) || '/' == marker) return PARADOX_XML1_PARSER_NO_MATCH;
+        else if('?' == marker) next = paradox_xml1_parser_pi(input, index);
+        else if('!' == marker) next = '-' == paradox_xml1_peek(input, index + 2) ? paradox_xml1_parser_comment(input, index) : paradox_xml1_parser_cd_sect(input, index);
+        else return index;
+        if(!paradox_xml1_parser_accept(&index, next)) return PARADOX_XML1_PARSER_NO_MATCH;
     }
-    
-    return result;
 }
-// [13] PubidChar ::= #x20 | #xD | #xA | [a-zA-Z0-9] | [-'()+,./:=?;!*#@$_%]
-PARADOX_XML_API paradox_bool8_t paradox_is_xml1_pubid_char(paradox_str_t xml_string, const paradox_uint64_t index)
+
+// The first '<' from index that is followed by the Name of pattern, which is that Name behind a '<'. Markup
+// around it is not looked at, so the tag found may as well be part of a comment or an attribute value.
+static paradox_uint64_t paradox_xml1_parser_find_tag(const paradox_xml1_input* input, paradox_uint64_t index, const char* pattern, const paradox_uint64_t pattern_length)
 {
-    size_t num_bytes;
-    const paradox_uint32_t code = paradox_utf8_to_codepoint(xml_string + index, &num_bytes);
-    if(!num_bytes) return PARADOX_FALSE;
-    switch(code)
-    {
-    case 0xA:
-    case 0xD:
-    case 0x20:
-    case '-':
-    case '\'':
-    case '(':
-    case ')':
-    case '+':
-    case ',':
-    case '.':
-    case '/':
-    case ':':
-    case '=':
-    case '?':
-    case ';':
-    case '!':
-    case '*':
-    case '#':
-    case '@':
-    case '$':
-    case '_':
-    case '%': return PARADOX_TRUE;
-    default:
-    {
-        if( ('A' <= code && code <= 'Z')
-        ||  ('a' <= code && code <= 'z')
-        ||  ('0' <= code && code <= '9'))
-            return PARADOX_TRUE;
-        break;
-    }
+    while(index < input->length)
+    {
+        index += paradox_xml1_scan_terminator(input->data + index, input->length - index, pattern, NULL, PARADOX_TRUE);
+        if(index == input->length) break;
+        if(PARADOX_FALSE == paradox_xml1_is_name_char(input, index + pattern_length)) return index;
+        index++;
     }
-    return PARADOX_FALSE;
+    return PARADOX_XML1_PARSER_NO_MATCH;
 }
 
-// Character Data
-
-// [14] CharData ::= [^<&]* - ([^<&]* ']]>' [^<&]*)
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_char_data(paradox_str_t xml_string, paradox_uint64_t* index)
+// [39] element for the root, whose content is split across threads ahead of the start-tags named like its first
+// child. The splits are speculative: a run is only kept when the content before it ended exactly where the run
+// starts, which proves that the split sits between two pieces of the content of the root. Content no kept run
+// covers is parsed on the calling thread, so a wrong split costs time but never changes the result.
+// Validates the input ahead of the runs when options ask for it. The runs cannot tell which entities are
+// declared, so the root of a document with a document type declaration is parsed as a whole.
+static paradox_xml1_parser_errno_t paradox_xml1_parser_split_element(const paradox_xml1_input* input, paradox_uint64_t* index, paradox_xml1_document* document, const paradox_xml1_parser_options* options, paradox_xml1_element** element)
 {
     paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
+    paradox_xml1_input split_input = *input;
+    paradox_xml1_parser_split* splits = NULL;
+    paradox_uint64_t count = 0;
+    char* pattern = NULL;
+
+    paradox_uint64_t content_index = *index;
+    paradox_uint64_t name_length = 0;
+    if( NULL == document->entities
+    &&  PARADOX_XML1_PARSER_SUCCESS == paradox_xml1_parser_tag(input, &content_index, NULL, NULL, NULL, &name_length)
+    &&  '>' == paradox_xml1_peek(input, content_index++))
+    {
+        count = (input->length - content_index) / PARADOX_XML1_PARSER_SPLIT_MIN_LENGTH;
+        if(count > options->threads) count = options->threads;
+    }
+    const paradox_uint64_t child_index = count > 1 ? paradox_xml1_parser_first_child(input, content_index) : PARADOX_XML1_PARSER_NO_MATCH;
+    const paradox_uint64_t child_name_index = PARADOX_XML1_PARSER_NO_MATCH != child_index ? paradox_xml1_parser_name(input, child_index + 1) : PARADOX_XML1_PARSER_NO_MATCH;
+    if(PARADOX_XML1_PARSER_NO_MATCH == child_name_index)
+    {
+        // Too little content, no child to split ahead of, or entities: the root is parsed as a whole.
+        if(PARADOX_TRUE == options->validate_input)
+        {
+            if(input->length != paradox_xml1_validate(input->data, input->length)) return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+            split_input.validated = PARADOX_TRUE;
+        }
+        return paradox_xml1_parser_element(&split_input, index, document, NULL, NULL, element);
+    }
+
+    const paradox_uint64_t pattern_length = child_name_index - child_index;
+    pattern = malloc(pattern_length + 1);
+    splits = calloc(count, sizeof(paradox_xml1_parser_split));
+    if(NULL == pattern || NULL == splits)
     {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
+        result = PARADOX_XML1_PARSER_OUT_OF_MEMORY;
         goto INVALID_PARSING;
     }
-    else if(NULL == index)
+    memcpy(pattern, input->data + child_index, pattern_length);
+    pattern[pattern_length] = '\0';
+    splits[0].start = content_index;
+    for(paradox_uint64_t split = 1; split < count; split++)
     {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
+        const paradox_uint64_t nominal = content_index + split * ((input->length - content_index) / count);
+        const paradox_uint64_t start = paradox_xml1_parser_find_tag(input, nominal > splits[split - 1].start ? nominal : splits[split - 1].start + 1, pattern, pattern_length);
+        if(PARADOX_XML1_PARSER_NO_MATCH == start)
+        {
+            count = split;
+            break;
+        }
+        splits[split].start = start;
     }
-    const paradox_uint64_t base_index = *index;
 
-    while('\0' != xml_string[*index])
+    // The root is created ahead of the threads, which hand their children to it. Its start-tag is parsed
+    // from input, which is not validated yet.
+    paradox_uint64_t end_index = *index;
+    paradox_xml1_element* root = NULL;
+    result = paradox_xml1_parser_tag(input, &end_index, document, NULL, &root, NULL);
+    if(PARADOX_XML1_PARSER_SUCCESS != result) goto INVALID_PARSING;
+    end_index++;
+
+    // Every thread validates an equal share of the whole input, cut ahead of the UTF-8 sequences.
+    paradox_uint64_t validate_index = 0;
+    for(paradox_uint64_t split = 0; split < count; split++)
+    {
+        paradox_uint64_t validate_end = split + 1 < count ? (split + 1) * (input->length / count) : input->length;
+        for(int i = 0; i < 3 && validate_end < input->length && 0x80 == ((unsigned char)input->data[validate_end] & 0xC0); i++) validate_end--;
+        splits[split].input = &split_input;
+        splits[split].stop = split + 1 < count ? splits[split + 1].start : input->length;
+        splits[split].validate_index = validate_index;
+        splits[split].validate_length = validate_end - validate_index;
+        paradox_xml1_arena_init(&splits[split].shard.arena);
+        splits[split].shard.symbols = document->symbols;
+        splits[split].root = root;
+        validate_index = validate_end;
+    }
+    // The runs skip the checks of the characters they parse only once all of the input has been validated.
+    if(PARADOX_TRUE == options->validate_input)
+    {
+        paradox_xml1_parser_run_splits(splits, count, paradox_xml1_parser_validate_split);
+        for(paradox_uint64_t split = 0; split < count; split++)
+        {
+            if(PARADOX_FALSE == splits[split].valid)
+            {
+                result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+                goto INVALID_PARSING;
+            }
+        }
+        split_input.validated = PARADOX_TRUE;
+    }
+    // The runs intern their names into the table of the document side by side.
+    document->symbols->concurrent = PARADOX_TRUE;
+    paradox_xml1_parser_run_splits(splits, count, paradox_xml1_parser_run_split);
+    document->symbols->concurrent = PARADOX_FALSE;
+
+    // Stitches the runs that start where the content parsed so far ends, and parses the gaps in between.
+    paradox_xml1_parser_text text = { NULL, 0, NULL, 0, PARADOX_FALSE, PARADOX_FALSE };
+    paradox_xml1_element* last_child = NULL;
+    paradox_uint64_t next_split = 0;
+    for(;;)
+    {
+        while(next_split < count && splits[next_split].start < end_index) next_split++;
+        paradox_xml1_parser_split gap;
+        paradox_xml1_parser_split* run = &gap;
+        if(next_split < count && splits[next_split].start == end_index)
+        {
+            run = &splits[next_split++];
+            paradox_xml1_arena_merge(&document->arena, &run->shard.arena);
+        }
+        else
+        {
+            memset(&gap, 0, sizeof(paradox_xml1_parser_split));
+            gap.stop = next_split < count ? splits[next_split].start : input->length;
+            gap.end = end_index;
+            gap.root = root;
+            gap.result = paradox_xml1_parser_content(&split_input, &gap.end, document, NULL, &gap.parent, NULL, gap.stop);
+            if(PARADOX_XML1_PARSER_SUCCESS == gap.result) paradox_xml1_parser_adopt(&gap);
+        }
+        if(PARADOX_XML1_PARSER_SUCCESS != run->result)
+        {
+            result = run->result;
+            goto INVALID_PARSING;
+        }
+        if(NULL != run->parent.children)
+        {
+            if(NULL == last_child) root->children = run->parent.children;
+            else last_child->next = run->parent.children;
+            last_child = run->last;
+        }
+        // A run hands over its text with the references still written out, or with all of them decoded.
+        if( NULL != run->parent.value.data
+        &&  PARADOX_FALSE == (PARADOX_TRUE == run->parent.references
+            ?   paradox_xml1_parser_append_reference(&document->arena, &text, run->parent.value.data, run->parent.value.length)
+            :   paradox_xml1_parser_append_literal(&document->arena, &text, run->parent.value.data, run->parent.value.length)))
+        {
+            result = PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+            goto INVALID_PARSING;
+        }
+        end_index = run->end;
+        if(run->end < run->stop || run->stop == input->length) break;
+    }
+    paradox_xml1_parser_set_value(root, &text);
+
+    // [WFC: Element Type Match]
+    const paradox_uint64_t end_name_index = end_index + 2;
+    if( !paradox_xml1_parser_accept(&end_index, paradox_xml1_parser_e_tag(&split_input, end_index))
+    ||  PARADOX_FALSE == paradox_xml1_parser_end_tag_matches(&split_input, end_name_index, input->data + *index + 1, name_length))
     {
-        if(PARADOX_FALSE == paradox_is_xml1_char(xml_string, *index)) break;
-        if('<' == xml_string[*index] || '&' == xml_string[*index]) break;
-        if(!strncmp(xml_string + *index, "]]>", 3)) break;
-        paradox_xml1_parser_next_index(xml_string, index);
+        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+        goto INVALID_PARSING;
     }
+    *index = end_index;
+    *element = root;
     result = PARADOX_XML1_PARSER_SUCCESS;
 
     INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
+    for(paradox_uint64_t split = 0; NULL != splits && split < count; split++) paradox_xml1_arena_free(&splits[split].shard.arena);
+    free(splits);
+    free(pattern);
+
+    return result;
+}
+
+// Document
+
+// Whether options split the root element across threads.
+static inline paradox_bool8_t paradox_xml1_parser_splits(const paradox_xml1_parser_options* options)
+{
+    return NULL != options && PARADOX_XML1_PARSE_MODE_RECURSIVE == options->mode && options->threads > 1;
+}
+
+// Runs the passes options ask for ahead of the parse: the validation pass, which marks input as validated
+// once it succeeded, and the first stage of the indexed engine, which validates as it goes. structurals
+// stays empty when the document is parsed by the recursive descent.
+static paradox_xml1_parser_errno_t paradox_xml1_parser_prepare(paradox_xml1_input* input, const paradox_xml1_parser_options* options, paradox_xml1_index* structurals)
+{
+    if(NULL == options || NULL == input->data) return PARADOX_XML1_PARSER_SUCCESS;
+    if(PARADOX_XML1_PARSE_MODE_INDEXED == options->mode)
     {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
+        const paradox_xml1_parser_errno_t result = paradox_xml1_index_build(input->data, input->length, structurals);
+        if(PARADOX_XML1_PARSER_SUCCESS != result) return result;
+        if(0 != structurals->count)
+        {
+            input->validated = PARADOX_TRUE;
+            return PARADOX_XML1_PARSER_SUCCESS;
+        }
     }
-    
-    return result;
+    else if(PARADOX_FALSE == options->validate_input) return PARADOX_XML1_PARSER_SUCCESS;
+    if(input->length != paradox_xml1_validate(input->data, input->length)) return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+    input->validated = PARADOX_TRUE;
+    return PARADOX_XML1_PARSER_SUCCESS;
 }
 
-// [15] Comment ::= '<!--' ((Char - '-') | ('-' (Char - '-')))* '-->'
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_comment(paradox_str_t xml_string, paradox_uint64_t* index)
+// [1] document ::= ( prolog element Misc* ) - ( Char* RestrictedChar Char* )
+// The root element is walked along structurals when they are given, or split across threads when options ask for it.
+static paradox_xml1_parser_errno_t paradox_xml1_parser_document(const paradox_xml1_input* input, const paradox_xml1_index* structurals, const paradox_xml1_parser_options* options, paradox_xml1_document** document)
 {
     paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
+    if(NULL != document) *document = NULL;
+    if(NULL == input->data || NULL == document)
     {
         result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
         goto INVALID_PARSING;
     }
-    else if(NULL == index)
+
+    // The document is the first allocation of its own arena, so a single free releases everything.
+    paradox_xml1_arena arena;
+    paradox_xml1_arena_init(&arena);
+    *document = paradox_xml1_arena_alloc(&arena, sizeof(paradox_xml1_document));
+    if(NULL == *document)
     {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
+        result = PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+        goto INVALID_PARSING;
+    }
+    (*document)->root = NULL;
+    (*document)->error = NULL;
+    (*document)->arena = arena;
+    (*document)->mapping = NULL;
+    (*document)->mapping_length = 0;
+    (*document)->symbols = NULL != options ? options->symbols : NULL;
+    (*document)->owns_symbols = NULL == (*document)->symbols;
+    (*document)->entities = NULL;
+    if(PARADOX_TRUE == (*document)->owns_symbols && NULL == ((*document)->symbols = paradox_xml1_symbols_create(PARADOX_FALSE)))
+    {
+        result = PARADOX_XML1_PARSER_OUT_OF_MEMORY;
         goto INVALID_PARSING;
     }
-    const paradox_uint64_t base_index = *index;
 
-    if(strncmp(xml_string + *index, "<!--", 4))
+    // [22] prolog ::= XMLDecl Misc* (doctypedecl Misc*)?, walked here so the doctypedecl declares its entities.
+    paradox_uint64_t index = 0;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_xml_decl(input, index)))
     {
         result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
         goto INVALID_PARSING;
     }
-    else (*index) += 4;
-    while('\0' != xml_string[*index])
-    {
-        if(PARADOX_FALSE == paradox_is_xml1_char(xml_string, *index)) break;
-        if(!strncmp(xml_string + *index, "-->", 3)) break;
-        paradox_xml1_parser_next_index(xml_string, index);
-    }
-    if(strncmp(xml_string + *index, "-->", 3))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else (*index) += 3;
-    result = PARADOX_XML1_PARSER_SUCCESS;
+    while(paradox_xml1_parser_accept(&index, paradox_xml1_parser_misc(input, index)));
+    result = paradox_xml1_parser_doctype(input, &index, options, &(*document)->entities);
+    if(PARADOX_XML1_PARSER_SUCCESS != result) goto INVALID_PARSING;
+    while(paradox_xml1_parser_accept(&index, paradox_xml1_parser_misc(input, index)));
+    result = NULL != structurals
+        ?   paradox_xml1_parser_indexed_element(input, &index, structurals, *document, NULL, &(*document)->root)
+        :   PARADOX_TRUE == paradox_xml1_parser_splits(options)
+        ?   paradox_xml1_parser_split_element(input, &index, *document, options, &(*document)->root)
+        :   paradox_xml1_parser_element(input, &index, *document, NULL, NULL, &(*document)->root);
+    if(PARADOX_XML1_PARSER_SUCCESS != result) goto INVALID_PARSING;
+    while(paradox_xml1_parser_accept(&index, paradox_xml1_parser_misc(input, index)));
+    if(index == input->length) result = PARADOX_XML1_PARSER_SUCCESS;
+    else result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
 
     INVALID_PARSING:
     if(result != PARADOX_XML1_PARSER_SUCCESS)
     {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
+        if(NULL != document && NULL != *document)
+        {
+            paradox_free_xml1_document(*document);
+            *document = NULL;
+        }
     }
     
     return result;
 }
-
-// Processing Instructions
-
-// [16] PI ::= '<?' PITarget (S (Char* - (Char* '?>' Char*)))? '?>'
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_pi(paradox_str_t xml_string, paradox_uint64_t* index)
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_document(paradox_str_t xml_string, paradox_xml1_document** document)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
+    const paradox_xml1_input input = { xml_string, NULL != xml_string ? strlen(xml_string) : 0, PARADOX_FALSE };
+    return paradox_xml1_parser_document(&input, NULL, NULL, document);
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_document_n(const char* data, const paradox_uint64_t length, paradox_xml1_document** document)
+{
+    const paradox_xml1_input input = { data, length, PARADOX_FALSE };
+    return paradox_xml1_parser_document(&input, NULL, NULL, document);
+}
+// paradox_parse_xml1_document_with_options with the structural index of the caller, whose buffer outlives the parse.
+static paradox_xml1_parser_errno_t paradox_xml1_parser_document_with_options(const char* data, const paradox_uint64_t length, const paradox_xml1_parser_options* options, paradox_xml1_index* structurals, paradox_xml1_document** document)
+{
+    paradox_xml1_input input = { data, length, PARADOX_FALSE };
+    structurals->count = 0;
+    // A split parse validates on its threads instead.
+    const paradox_xml1_parser_errno_t result = NULL != document && PARADOX_FALSE == paradox_xml1_parser_splits(options) ? paradox_xml1_parser_prepare(&input, options, structurals) : PARADOX_XML1_PARSER_SUCCESS;
+    if(PARADOX_XML1_PARSER_SUCCESS != result)
     {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
+        *document = NULL;
+        return result;
     }
-    const paradox_uint64_t base_index = *index;
+    return paradox_xml1_parser_document(&input, 0 != structurals->count ? structurals : NULL, options, document);
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_document_with_options(const char* data, const paradox_uint64_t length, const paradox_xml1_parser_options* options, paradox_xml1_document** document)
+{
+    paradox_xml1_index structurals = { NULL, 0, 0 };
+    const paradox_xml1_parser_errno_t result = paradox_xml1_parser_document_with_options(data, length, options, &structurals, document);
+    paradox_xml1_index_free(&structurals);
+    return result;
+}
 
-    if(strncmp(xml_string + *index, "<?", 2))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else (*index) += 2;
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_pi_target(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    if(PARADOX_XML1_PARSER_SUCCESS == paradox_parse_xml1_space(xml_string, index))
+// Batch
+
+// Documents of a batch are numbered with 32 bits, so larger batches are parsed in parts of this many.
+#define PARADOX_XML1_PARSER_BATCH_MAX ((paradox_uint64_t)0xFFFFFFFF)
+#define PARADOX_XML1_PARSER_SHARE(begin, end) ((paradox_uint64_t)(begin) | (paradox_uint64_t)(end) << 32)
+
+// Documents a worker has left: the first in the low half of range and the one past the last in the high half,
+// so a single compare-exchange takes documents off either end.
+typedef struct paradox_xml1_parser_share
+{
+    volatile paradox_uint64_t range;
+    // Keeps the share of every worker on a cache line of its own.
+    char padding[56];
+
+} paradox_xml1_parser_share;
+
+typedef struct paradox_xml1_parser_batch
+{
+    const paradox_xml1_slice* inputs;
+    paradox_xml1_parser_output* outputs;
+    paradox_xml1_parser_options options;
+    paradox_xml1_parser_share* shares;
+    paradox_uint32_t workers;
+
+} paradox_xml1_parser_batch;
+
+// Takes the first document off a share.
+static paradox_bool8_t paradox_xml1_parser_take(paradox_xml1_parser_share* share, paradox_uint64_t* document)
+{
+    for(;;)
     {
-        while('\0' != xml_string[*index])
+        const paradox_uint64_t range = paradox_xml1_atomic_load(&share->range);
+        const paradox_uint64_t begin = range & 0xFFFFFFFF;
+        const paradox_uint64_t end = range >> 32;
+        if(begin >= end) return PARADOX_FALSE;
+        if(PARADOX_TRUE == paradox_xml1_atomic_compare_exchange(&share->range, range, PARADOX_XML1_PARSER_SHARE(begin + 1, end)))
         {
-            if(PARADOX_FALSE == paradox_is_xml1_char(xml_string, *index)) break;
-            if(!strncmp(xml_string + *index, "?>", 2)) break;
-            paradox_xml1_parser_next_index(xml_string, index);
+            *document = begin;
+            return PARADOX_TRUE;
         }
     }
-    if(strncmp(xml_string + *index, "?>", 2))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else (*index) += 2;
-    result = PARADOX_XML1_PARSER_SUCCESS;
+}
 
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
+// Moves the back half of the share of the next worker that has documents left into the empty share of worker
+// and takes the first of them. A range only ever holds documents no worker has taken yet, so a range that still
+// reads the same at the compare-exchange still holds the same documents.
+static paradox_bool8_t paradox_xml1_parser_steal(paradox_xml1_parser_batch* batch, const paradox_uint32_t worker, paradox_uint64_t* document)
+{
+    for(paradox_uint32_t offset = 1; offset < batch->workers; offset++)
     {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
+        paradox_xml1_parser_share* victim = &batch->shares[(worker + offset) % batch->workers];
+        for(;;)
+        {
+            const paradox_uint64_t range = paradox_xml1_atomic_load(&victim->range);
+            const paradox_uint64_t begin = range & 0xFFFFFFFF;
+            const paradox_uint64_t end = range >> 32;
+            if(begin >= end) break;
+            const paradox_uint64_t middle = begin + (end - begin) / 2;
+            if(PARADOX_TRUE == paradox_xml1_atomic_compare_exchange(&victim->range, range, PARADOX_XML1_PARSER_SHARE(begin, middle)))
+            {
+                paradox_xml1_atomic_store(&batch->shares[worker].range, PARADOX_XML1_PARSER_SHARE(middle + 1, end));
+                *document = middle;
+                return PARADOX_TRUE;
+            }
+        }
     }
-    
-    return result;
+    return PARADOX_FALSE;
 }
 
-// [17] PITarget ::= Name - (('X' | 'x') ('M' | 'm') ('L' | 'l'))
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_pi_target(paradox_str_t xml_string, paradox_uint64_t* index)
+// Parses documents until no share has any left. The structural index is private to the worker and keeps
+// its buffer from one document to the next.
+static void paradox_xml1_parser_batch_worker(void* argument, const paradox_uint32_t worker)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
+    paradox_xml1_parser_batch* batch = argument;
+    paradox_xml1_index structurals = { NULL, 0, 0 };
+    paradox_uint64_t document;
+    while(PARADOX_TRUE == paradox_xml1_parser_take(&batch->shares[worker], &document) || PARADOX_TRUE == paradox_xml1_parser_steal(batch, worker, &document))
     {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
+        const paradox_xml1_slice* input = &batch->inputs[document];
+        paradox_xml1_parser_output* output = &batch->outputs[document];
+        output->result = paradox_xml1_parser_document_with_options(input->data, input->length, &batch->options, &structurals, &output->document);
     }
-    const paradox_uint64_t base_index = *index;
+    paradox_xml1_index_free(&structurals);
+}
 
-    if( ('\0' != xml_string[*index] && ('X' == xml_string[*index] || 'x' == xml_string[*index]))
-    &&  ('\0' != xml_string[(*index) + 1] && ('M' == xml_string[(*index) + 1] || 'm' == xml_string[(*index) + 1]))
-    &&  ('\0' != xml_string[(*index) + 2] && ('L' == xml_string[(*index) + 2] || 'l' == xml_string[(*index) + 2])))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_name(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_documents(const paradox_xml1_slice* inputs, const paradox_uint64_t count, paradox_xml1_parser_output* outputs, const paradox_xml1_parser_options* options)
+{
+    if(0 == count) return PARADOX_XML1_PARSER_SUCCESS;
+    if(NULL == inputs || NULL == outputs) return PARADOX_XML1_PARSER_NULL_DOCUMENT;
+
+    paradox_xml1_parser_batch batch;
+    memset(&batch.options, 0, sizeof(paradox_xml1_parser_options));
+    if(NULL != options) batch.options = *options;
+    batch.options.threads = 0;
+    batch.options.pool = NULL;
+    paradox_xml1_parser_pool* pool = NULL != options ? options->pool : NULL;
+    paradox_xml1_parser_pool* started = NULL;
+    if(NULL == pool && NULL != options && options->threads > 1) pool = started = paradox_xml1_pool_create(count < options->threads ? (paradox_uint32_t)count : options->threads);
+
+    // Without memory for the shares of the pool the calling thread parses the batch alone.
+    paradox_xml1_parser_share single;
+    batch.workers = NULL != pool ? pool->size : 1;
+    batch.shares = batch.workers > 1 ? malloc(batch.workers * sizeof(paradox_xml1_parser_share)) : NULL;
+    if(NULL == batch.shares)
+    {
+        batch.workers = 1;
+        batch.shares = &single;
+    }
+    for(paradox_uint64_t first = 0; first < count; first += PARADOX_XML1_PARSER_BATCH_MAX)
+    {
+        const paradox_uint64_t part = count - first < PARADOX_XML1_PARSER_BATCH_MAX ? count - first : PARADOX_XML1_PARSER_BATCH_MAX;
+        batch.inputs = inputs + first;
+        batch.outputs = outputs + first;
+        for(paradox_uint32_t worker = 0; worker < batch.workers; worker++)
+        {
+            batch.shares[worker].range = PARADOX_XML1_PARSER_SHARE(part * worker / batch.workers, part * (worker + 1) / batch.workers);
+        }
+        if(batch.workers > 1) paradox_xml1_pool_run(pool, paradox_xml1_parser_batch_worker, &batch);
+        else paradox_xml1_parser_batch_worker(&batch, 0);
     }
-    result = PARADOX_XML1_PARSER_SUCCESS;
+    if(&single != batch.shares) free(batch.shares);
+    paradox_xml1_pool_free(started);
 
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
+    for(paradox_uint64_t document = 0; document < count; document++)
     {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
+        if(PARADOX_XML1_PARSER_SUCCESS != outputs[document].result) return outputs[document].result;
     }
-
-    return result;
+    return PARADOX_XML1_PARSER_SUCCESS;
 }
 
-// CDATA Sections
-
-// [18] CDSect ::= CDStart CData CDEnd
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_cd_sect(paradox_str_t xml_string, paradox_uint64_t* index)
+// [1] document ::= ( prolog element Misc* ) - ( Char* RestrictedChar Char* )
+// The prolog is walked here rather than through paradox_xml1_parser_prolog so its comments and PIs are emitted too.
+static paradox_xml1_parser_errno_t paradox_xml1_parser_events_document(const paradox_xml1_input* input, const paradox_xml1_index* structurals, const paradox_xml1_parser_options* options, const paradox_xml1_sax_handler* handler)
 {
     paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
+    paradox_xml1_parser_events events = { handler, NULL, 0, { NULL, 0, 0 }, NULL, 0, NULL };
+    if(NULL == input->data || NULL == handler)
     {
         result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
         goto INVALID_PARSING;
     }
-    else if(NULL == index)
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
-    const paradox_uint64_t base_index = *index;
 
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_cd_start(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_c_data(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_cd_end(xml_string, index))
+    paradox_uint64_t index = 0;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_xml_decl(input, index)))
     {
         result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
         goto INVALID_PARSING;
     }
-    result = PARADOX_XML1_PARSER_SUCCESS;
+    while(PARADOX_XML1_PARSER_SUCCESS == (result = paradox_xml1_parser_event_misc(input, &index, &events)));
+    if(PARADOX_XML1_PARSER_ABORTED == result) goto INVALID_PARSING;
+    result = paradox_xml1_parser_doctype(input, &index, options, &events.entities);
+    if(PARADOX_XML1_PARSER_SUCCESS != result) goto INVALID_PARSING;
+    while(PARADOX_XML1_PARSER_SUCCESS == (result = paradox_xml1_parser_event_misc(input, &index, &events)));
+    if(PARADOX_XML1_PARSER_ABORTED == result) goto INVALID_PARSING;
+    result = NULL != structurals
+        ?   paradox_xml1_parser_indexed_element(input, &index, structurals, NULL, &events, NULL)
+        :   paradox_xml1_parser_element(input, &index, NULL, &events, NULL, NULL);
+    if(PARADOX_XML1_PARSER_SUCCESS != result) goto INVALID_PARSING;
+    while(PARADOX_XML1_PARSER_SUCCESS == (result = paradox_xml1_parser_event_misc(input, &index, &events)));
+    if(PARADOX_XML1_PARSER_ABORTED == result) goto INVALID_PARSING;
+    if(index == input->length) result = PARADOX_XML1_PARSER_SUCCESS;
+    else result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
 
     INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
-    }
+    free(events.names);
+    free(events.unique.slots);
+    free(events.buffer);
+    paradox_xml1_entities_free(events.entities);
 
     return result;
 }
-// [19] CDStart ::= '<![CDATA['
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_cd_start(paradox_str_t xml_string, paradox_uint64_t* index)
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_events(paradox_str_t xml_string, const paradox_xml1_sax_handler* handler)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
-    const paradox_uint64_t base_index = *index;
-
-    if(strncmp(xml_string + *index, "<![CDATA[", 9))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else (*index) += 9;
-    result = PARADOX_XML1_PARSER_SUCCESS;
-
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
-    }
-
-    return result;
+    const paradox_xml1_input input = { xml_string, NULL != xml_string ? strlen(xml_string) : 0, PARADOX_FALSE };
+    return paradox_xml1_parser_events_document(&input, NULL, NULL, handler);
 }
-// [20] CData ::= (Char* - (Char* ']]>' Char*))
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_c_data(paradox_str_t xml_string, paradox_uint64_t* index)
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_events_n(const char* data, const paradox_uint64_t length, const paradox_xml1_sax_handler* handler)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
-    const paradox_uint64_t base_index = *index;
-
-    while('\0' != xml_string[*index])
-    {
-        if(PARADOX_FALSE == paradox_is_xml1_char(xml_string, *index)) break;
-        if(!strncmp(xml_string + *index, "]]>", 3)) break;
-        paradox_xml1_parser_next_index(xml_string, index);
-    }
-    result = PARADOX_XML1_PARSER_SUCCESS;
-
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
-    }
-
-    return result;
+    const paradox_xml1_input input = { data, length, PARADOX_FALSE };
+    return paradox_xml1_parser_events_document(&input, NULL, NULL, handler);
 }
-// [21] CDEnd ::= ']]>'
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_cd_end(paradox_str_t xml_string, paradox_uint64_t* index)
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_events_with_options(const char* data, const paradox_uint64_t length, const paradox_xml1_parser_options* options, const paradox_xml1_sax_handler* handler)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
-    const paradox_uint64_t base_index = *index;
+    paradox_xml1_input input = { data, length, PARADOX_FALSE };
+    paradox_xml1_index structurals = { NULL, 0, 0 };
+    paradox_xml1_parser_errno_t result = NULL != handler ? paradox_xml1_parser_prepare(&input, options, &structurals) : PARADOX_XML1_PARSER_SUCCESS;
+    if(PARADOX_XML1_PARSER_SUCCESS != result) return result;
+    result = paradox_xml1_parser_events_document(&input, 0 != structurals.count ? &structurals : NULL, options, handler);
+    paradox_xml1_index_free(&structurals);
+    return result;
+}
 
-    if(strncmp(xml_string + *index, "]]>", 3))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else (*index) += 3;
-    result = PARADOX_XML1_PARSER_SUCCESS;
+// Tape
 
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
-    }
+// Element of a tape build whose end has not been seen yet.
+typedef struct paradox_xml1_parser_tape_level
+{
+    paradox_uint32_t node;
+    paradox_uint32_t last_child;
+    paradox_xml1_parser_text text;
+} paradox_xml1_parser_tape_level;
 
-    return result;
+// Fills a tape from the events of a parse. Its callbacks only stop the parse when they run out of memory.
+typedef struct paradox_xml1_parser_tape
+{
+    const paradox_xml1_input* input;
+    paradox_xml1_tape* tape;
+    paradox_uint64_t node_capacity;
+    paradox_uint64_t attribute_capacity;
+    paradox_xml1_parser_tape_level* levels;
+    paradox_uint64_t depth;
+    paradox_uint64_t level_capacity;
+} paradox_xml1_parser_tape;
+
+// Returns array with room for one entry of size bytes past count, which may have moved, or NULL when out of memory.
+static void* paradox_xml1_parser_grow(void* array, paradox_uint64_t* capacity, const paradox_uint64_t count, const paradox_uint64_t size)
+{
+    if(count < *capacity) return array;
+    const paradox_uint64_t grown = *capacity ? *capacity * 2 : 64;
+    void* reallocated = realloc(array, grown * size);
+    if(NULL != reallocated) *capacity = grown;
+    return reallocated;
 }
 
-// Prolog
+// Events hand over decoded references and values in buffers they reuse, so only slices of the input can be kept as they are.
+static inline paradox_bool8_t paradox_xml1_parser_in_input(const paradox_xml1_input* input, const char* data)
+{
+    return (uintptr_t)data >= (uintptr_t)input->data && (uintptr_t)data <= (uintptr_t)(input->data + input->length);
+}
 
-// [22] prolog ::= XMLDecl Misc* (doctypedecl Misc*)?
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_prolog(paradox_str_t xml_string, paradox_uint64_t* index)
+// Copies slice into the arena of the tape unless it lies in the input, like the names and values that entities replaced.
+static paradox_bool8_t paradox_xml1_parser_tape_keep(paradox_xml1_parser_tape* builder, paradox_xml1_slice* slice)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
-    const paradox_uint64_t base_index = *index;
+    if(0 == slice->length || PARADOX_TRUE == paradox_xml1_parser_in_input(builder->input, slice->data)) return PARADOX_TRUE;
+    char* kept = paradox_xml1_arena_alloc(&builder->tape->arena, slice->length);
+    if(NULL == kept) return PARADOX_FALSE;
+    memcpy(kept, slice->data, slice->length);
+    slice->data = kept;
+    return PARADOX_TRUE;
+}
 
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_xml_decl(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    while(PARADOX_XML1_PARSER_SUCCESS == paradox_parse_xml1_misc(xml_string, index));
-    if(PARADOX_XML1_PARSER_SUCCESS == paradox_parse_xml1_doctypedecl(xml_string, index))
-    {
-        while(PARADOX_XML1_PARSER_SUCCESS == paradox_parse_xml1_misc(xml_string, index));
-    }
-    result = PARADOX_XML1_PARSER_SUCCESS;
+static paradox_bool8_t paradox_xml1_parser_tape_start(void* user_data, paradox_xml1_slice name)
+{
+    paradox_xml1_parser_tape* builder = user_data;
+    paradox_xml1_tape* tape = builder->tape;
+    if(PARADOX_FALSE == paradox_xml1_parser_tape_keep(builder, &name)) return PARADOX_FALSE;
+    if(tape->node_count >= PARADOX_XML1_TAPE_NONE) return PARADOX_FALSE;
+    paradox_xml1_tape_node* nodes = paradox_xml1_parser_grow(tape->nodes, &builder->node_capacity, tape->node_count, sizeof(paradox_xml1_tape_node));
+    if(NULL == nodes) return PARADOX_FALSE;
+    tape->nodes = nodes;
+    paradox_xml1_parser_tape_level* levels = paradox_xml1_parser_grow(builder->levels, &builder->level_capacity, builder->depth, sizeof(paradox_xml1_parser_tape_level));
+    if(NULL == levels) return PARADOX_FALSE;
+    builder->levels = levels;
+
+    const paradox_uint32_t node = (paradox_uint32_t)tape->node_count++;
+    paradox_xml1_tape_node* created = &nodes[node];
+    created->tag = name;
+    created->value.data = NULL;
+    created->value.length = 0;
+    created->parent = PARADOX_XML1_TAPE_NONE;
+    created->first_child = PARADOX_XML1_TAPE_NONE;
+    created->next_sibling = PARADOX_XML1_TAPE_NONE;
+    created->attribute_start = (paradox_uint32_t)tape->attribute_count;
+    created->attribute_count = 0;
+    created->symbol = paradox_xml1_symbols_intern(tape->symbols, name.data, name.length);
+    if(PARADOX_XML1_SYMBOL_NONE == created->symbol) return PARADOX_FALSE;
+    if(0 != builder->depth)
+    {
+        paradox_xml1_parser_tape_level* parent = &levels[builder->depth - 1];
+        created->parent = parent->node;
+        if(PARADOX_XML1_TAPE_NONE == parent->last_child) nodes[parent->node].first_child = node;
+        else nodes[parent->last_child].next_sibling = node;
+        parent->last_child = node;
+    }
+    paradox_xml1_parser_tape_level* level = &levels[builder->depth++];
+    memset(level, 0, sizeof(paradox_xml1_parser_tape_level));
+    level->node = node;
+    level->last_child = PARADOX_XML1_TAPE_NONE;
+    return PARADOX_TRUE;
+}
 
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
-    }
+static paradox_bool8_t paradox_xml1_parser_tape_attribute(void* user_data, paradox_xml1_slice name, paradox_xml1_slice value)
+{
+    paradox_xml1_parser_tape* builder = user_data;
+    paradox_xml1_tape* tape = builder->tape;
+    if(tape->attribute_count >= PARADOX_XML1_TAPE_NONE) return PARADOX_FALSE;
+    paradox_xml1_tape_attribute* attributes = paradox_xml1_parser_grow(tape->attributes, &builder->attribute_capacity, tape->attribute_count, sizeof(paradox_xml1_tape_attribute));
+    if(NULL == attributes) return PARADOX_FALSE;
+    tape->attributes = attributes;
+    if(PARADOX_FALSE == paradox_xml1_parser_tape_keep(builder, &name) || PARADOX_FALSE == paradox_xml1_parser_tape_keep(builder, &value)) return PARADOX_FALSE;
+    attributes[tape->attribute_count].tag = name;
+    attributes[tape->attribute_count].value = value;
+    attributes[tape->attribute_count].symbol = paradox_xml1_symbols_intern(tape->symbols, name.data, name.length);
+    if(PARADOX_XML1_SYMBOL_NONE == attributes[tape->attribute_count].symbol) return PARADOX_FALSE;
+    tape->attribute_count++;
+    tape->nodes[tape->node_count - 1].attribute_count++;
+    return PARADOX_TRUE;
+}
 
-    return result;
+static paradox_bool8_t paradox_xml1_parser_tape_end(void* user_data, paradox_xml1_slice name)
+{
+    paradox_xml1_parser_tape* builder = user_data;
+    const paradox_xml1_parser_tape_level* level = &builder->levels[--builder->depth];
+    (void)name;
+    builder->tape->nodes[level->node].value.data = level->text.data;
+    builder->tape->nodes[level->node].value.length = level->text.length;
+    return PARADOX_TRUE;
 }
-// [23] XMLDecl ::= '<?xml' VersionInfo EncodingDecl? SDDecl? S? '?>'
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_xml_decl(paradox_str_t xml_string, paradox_uint64_t* index)
+
+// Gathers the CharData, CDSect and Reference pieces of the open element the way the tree does.
+static paradox_bool8_t paradox_xml1_parser_tape_text(void* user_data, paradox_xml1_slice text)
+{
+    paradox_xml1_parser_tape* builder = user_data;
+    paradox_xml1_parser_text* gathered = &builder->levels[builder->depth - 1].text;
+    if(PARADOX_TRUE == paradox_xml1_parser_in_input(builder->input, text.data)) return paradox_xml1_parser_append_text(&builder->tape->arena, gathered, text.data, text.length);
+    if(PARADOX_FALSE == paradox_xml1_parser_reserve_text(&builder->tape->arena, gathered, text.length)) return PARADOX_FALSE;
+    memcpy(gathered->buffer + gathered->length, text.data, text.length);
+    gathered->length += text.length;
+    return PARADOX_TRUE;
+}
+
+static paradox_xml1_parser_errno_t paradox_xml1_parser_tape_document(const paradox_xml1_input* input, const paradox_xml1_index* structurals, const paradox_xml1_parser_options* options, paradox_xml1_tape** tape)
 {
     paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
+    paradox_xml1_parser_tape builder;
+    memset(&builder, 0, sizeof(paradox_xml1_parser_tape));
+    if(NULL != tape) *tape = NULL;
+    if(NULL == input->data || NULL == tape)
     {
         result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
         goto INVALID_PARSING;
     }
-    else if(NULL == index)
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
-    const paradox_uint64_t base_index = *index;
 
-    if(strncmp(xml_string + *index, "<?xml", 5))
+    // The tape is the first allocation of its own arena, like a document.
+    paradox_xml1_arena arena;
+    paradox_xml1_arena_init(&arena);
+    *tape = paradox_xml1_arena_alloc(&arena, sizeof(paradox_xml1_tape));
+    if(NULL == *tape)
     {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else (*index) += 5;
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_version_info(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+        result = PARADOX_XML1_PARSER_OUT_OF_MEMORY;
         goto INVALID_PARSING;
     }
-    paradox_parse_xml1_encoding_decl(xml_string, index);
-    paradox_parse_xml1_sd_decl(xml_string, index);
-    paradox_parse_xml1_space(xml_string, index);
-    if(strncmp(xml_string + *index, "?>", 2))
+    memset(*tape, 0, sizeof(paradox_xml1_tape));
+    (*tape)->arena = arena;
+    (*tape)->symbols = NULL != options ? options->symbols : NULL;
+    (*tape)->owns_symbols = NULL == (*tape)->symbols;
+    if(PARADOX_TRUE == (*tape)->owns_symbols && NULL == ((*tape)->symbols = paradox_xml1_symbols_create(PARADOX_FALSE)))
     {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+        result = PARADOX_XML1_PARSER_OUT_OF_MEMORY;
         goto INVALID_PARSING;
     }
-    else (*index) += 2;
-    result = PARADOX_XML1_PARSER_SUCCESS;
+
+    builder.input = input;
+    builder.tape = *tape;
+    const paradox_xml1_sax_handler handler = {
+        &builder,
+        paradox_xml1_parser_tape_start,
+        paradox_xml1_parser_tape_attribute,
+        paradox_xml1_parser_tape_end,
+        paradox_xml1_parser_tape_text,
+        paradox_xml1_parser_tape_text,
+        NULL,
+        NULL
+    };
+    result = paradox_xml1_parser_events_document(input, structurals, options, &handler);
+    if(PARADOX_XML1_PARSER_ABORTED == result) result = PARADOX_XML1_PARSER_OUT_OF_MEMORY;
 
     INVALID_PARSING:
+    free(builder.levels);
     if(result != PARADOX_XML1_PARSER_SUCCESS)
     {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
+        if(NULL != tape && NULL != *tape)
+        {
+            paradox_free_xml1_tape(*tape);
+            *tape = NULL;
+        }
     }
 
     return result;
 }
-// [24] VersionInfo ::= S 'version' Eq ("'" VersionNum "'" | '"' VersionNum '"')
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_version_info(paradox_str_t xml_string, paradox_uint64_t* index)
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_tape_n(const char* data, const paradox_uint64_t length, paradox_xml1_tape** tape)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
+    const paradox_xml1_input input = { data, length, PARADOX_FALSE };
+    return paradox_xml1_parser_tape_document(&input, NULL, NULL, tape);
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_tape_with_options(const char* data, const paradox_uint64_t length, const paradox_xml1_parser_options* options, paradox_xml1_tape** tape)
+{
+    paradox_xml1_input input = { data, length, PARADOX_FALSE };
+    paradox_xml1_index structurals = { NULL, 0, 0 };
+    paradox_xml1_parser_errno_t result = NULL != tape ? paradox_xml1_parser_prepare(&input, options, &structurals) : PARADOX_XML1_PARSER_SUCCESS;
+    if(PARADOX_XML1_PARSER_SUCCESS != result)
     {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
+        *tape = NULL;
+        return result;
     }
-    const paradox_uint64_t base_index = *index;
+    result = paradox_xml1_parser_tape_document(&input, 0 != structurals.count ? &structurals : NULL, options, tape);
+    paradox_xml1_index_free(&structurals);
+    return result;
+}
 
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_space(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    if(strncmp(xml_string + *index, "version", 7))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else (*index) += 7;
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_eq(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    paradox_char8_t quote;
-    if('"' == xml_string[*index] || '\'' == xml_string[*index])
-    {
-        quote = xml_string[(*index)++];
-    }
-    else
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_version_num(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    if(quote != xml_string[*index])
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else (*index)++;
-    result = PARADOX_XML1_PARSER_SUCCESS;
-
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
-    }
+// Character Range
 
-    return result;
+// [2] Char ::= ([#x1-#xD7FF] | [#xE000-#xFFFD] | [#x10000-#x10FFFF]) - RestrictedChar
+static paradox_bool8_t paradox_xml1_is_char(const paradox_xml1_input* input, const paradox_uint64_t index)
+{
+    paradox_xml1_cursor cursor;
+    paradox_xml1_cursor_load(input, &cursor, index);
+    return 0 != (cursor.classes & PARADOX_XML1_CHARACTER_CHAR);
 }
-// [25] Eq ::= S? '=' S?
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_eq(paradox_str_t xml_string, paradox_uint64_t* index)
+PARADOX_XML_API paradox_bool8_t paradox_is_xml1_char(paradox_str_t xml_string, const paradox_uint64_t index)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
-    const paradox_uint64_t base_index = *index;
+    const paradox_xml1_input input = { xml_string, PARADOX_XML1_INPUT_UNBOUNDED, PARADOX_FALSE };
+    return paradox_xml1_is_char(&input, index);
+}
+// [2a] RestrictedChar ::= [#x1-#x8] | [#xB-#xC] | [#xE-#x1F] | [#x7F-#x84] | [#x86-#x9F]
+static paradox_bool8_t paradox_xml1_is_restricted_char(const paradox_xml1_input* input, const paradox_uint64_t index)
+{
+    paradox_xml1_cursor cursor;
+    paradox_xml1_cursor_load(input, &cursor, index);
+    return 0 != (cursor.classes & PARADOX_XML1_CHARACTER_RESTRICTED);
+}
+PARADOX_XML_API paradox_bool8_t paradox_is_xml1_restricted_char(paradox_str_t xml_string, const paradox_uint64_t index)
+{
+    const paradox_xml1_input input = { xml_string, PARADOX_XML1_INPUT_UNBOUNDED, PARADOX_FALSE };
+    return paradox_xml1_is_restricted_char(&input, index);
+}
 
-    paradox_parse_xml1_space(xml_string, index);
-    if('=' != xml_string[*index])
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else (*index)++;
-    paradox_parse_xml1_space(xml_string, index);
-    result = PARADOX_XML1_PARSER_SUCCESS;
+// White Space
 
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
-    }
+// [3] S ::= (#x20 | #x9 | #xD | #xA)+
+static inline paradox_uint64_t paradox_xml1_parser_space(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    const paradox_uint64_t base_index = index;
+    while(paradox_xml1_classify((unsigned char)paradox_xml1_peek(input, index)) & PARADOX_XML1_CHARACTER_SPACE) index++;
+    return base_index != index ? index : PARADOX_XML1_PARSER_NO_MATCH;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_space(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_space);
+}
 
-    return result;
+// Names and Tokens
+
+// [4] NameStartChar ::= ":" | [A-Z] | "_" | [a-z] | [#xC0-#xD6] | [#xD8-#xF6] | [#xF8-#x2FF] | [#x370-#x37D] | [#x37F-#x1FFF] | [#x200C-#x200D] | [#x2070-#x218F] | [#x2C00-#x2FEF] | [#x3001-#xD7FF] | [#xF900-#xFDCF] | [#xFDF0-#xFFFD] | [#x10000-#xEFFFF]
+static paradox_bool8_t paradox_xml1_is_name_start_char(const paradox_xml1_input* input, const paradox_uint64_t index)
+{
+    paradox_xml1_cursor cursor;
+    paradox_xml1_cursor_load(input, &cursor, index);
+    return 0 != (cursor.classes & PARADOX_XML1_CHARACTER_NAME_START);
 }
-// [26] VersionNum ::= '1.1'
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_version_num(paradox_str_t xml_string, paradox_uint64_t* index)
+PARADOX_XML_API paradox_bool8_t paradox_is_xml1_name_start_char(paradox_str_t xml_string, const paradox_uint64_t index)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
+    const paradox_xml1_input input = { xml_string, PARADOX_XML1_INPUT_UNBOUNDED, PARADOX_FALSE };
+    return paradox_xml1_is_name_start_char(&input, index);
+}
+// [4a] NameChar ::= NameStartChar | "-" | "." | [0-9] | #xB7 | [#x0300-#x036F] | [#x203F-#x2040]
+static paradox_bool8_t paradox_xml1_is_name_char(const paradox_xml1_input* input, const paradox_uint64_t index)
+{
+    paradox_xml1_cursor cursor;
+    paradox_xml1_cursor_load(input, &cursor, index);
+    return 0 != (cursor.classes & PARADOX_XML1_CHARACTER_NAME);
+}
+PARADOX_XML_API paradox_bool8_t paradox_is_xml1_name_char(paradox_str_t xml_string, const paradox_uint64_t index)
+{
+    const paradox_xml1_input input = { xml_string, PARADOX_XML1_INPUT_UNBOUNDED, PARADOX_FALSE };
+    return paradox_xml1_is_name_char(&input, index);
+}
+// [5] Name ::= NameStartChar (NameChar)*
+static inline paradox_uint64_t paradox_xml1_parser_name(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    paradox_xml1_cursor cursor;
+    paradox_xml1_cursor_load(input, &cursor, index);
+    if(!(cursor.classes & PARADOX_XML1_CHARACTER_NAME_START)) return PARADOX_XML1_PARSER_NO_MATCH;
+    do paradox_xml1_cursor_advance(input, &cursor);
+    while(cursor.classes & PARADOX_XML1_CHARACTER_NAME);
+    index = cursor.index;
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_name(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_name);
+}
+// [6] Names ::= Name (#x20 Name)*
+static inline paradox_uint64_t paradox_xml1_parser_names(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_name(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+
+    while('\0' != paradox_xml1_peek(input, index))
     {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
+        paradox_uint64_t last_index = index;
+        if(0x20 != paradox_xml1_peek(input, last_index++)) break;
+        if(!paradox_xml1_parser_accept(&last_index, paradox_xml1_parser_name(input, last_index))) break;
+        index = last_index;
     }
-    else if(NULL == index)
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_names(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_names);
+}
+// [7] Nmtoken ::= (NameChar)+
+static inline paradox_uint64_t paradox_xml1_parser_nm_token(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    paradox_xml1_cursor cursor;
+    paradox_xml1_cursor_load(input, &cursor, index);
+    while(cursor.classes & PARADOX_XML1_CHARACTER_NAME) paradox_xml1_cursor_advance(input, &cursor);
+    return index != cursor.index ? cursor.index : PARADOX_XML1_PARSER_NO_MATCH;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_nm_token(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_nm_token);
+}
+// [8] Nmtokens ::= Nmtoken (#x20 Nmtoken)*
+static inline paradox_uint64_t paradox_xml1_parser_nm_tokens(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_nm_token(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+
+    while('\0' != paradox_xml1_peek(input, index))
     {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
+        paradox_uint64_t last_index = index;
+        if(0x20 != paradox_xml1_peek(input, last_index++)) break;
+        if(!paradox_xml1_parser_accept(&last_index, paradox_xml1_parser_nm_token(input, last_index))) break;
+        index = last_index;
     }
-    const paradox_uint64_t base_index = *index;
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_nm_tokens(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_nm_tokens);
+}
 
-    if(strncmp(xml_string + *index, "1.1", 3))
+// Literals
+
+// [9] EntityValue ::= '"' ([^%&"] | PEReference | Reference)* '"' | "'" ([^%&'] | PEReference | Reference)* "'"
+static inline paradox_uint64_t paradox_xml1_parser_entity_value(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    paradox_char8_t quote;
+    if('"' != paradox_xml1_peek(input, index) && '\'' != paradox_xml1_peek(input, index)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else
     {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
+        quote = paradox_xml1_peek(input, index);
+        index++;
     }
-    else (*index) += 3;
-    result = PARADOX_XML1_PARSER_SUCCESS;
-
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
+    paradox_xml1_cursor cursor;
+    paradox_xml1_cursor_load(input, &cursor, index);
+    while((cursor.classes & PARADOX_XML1_CHARACTER_CHAR) && (paradox_uint32_t)quote != cursor.code)
     {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
+        if('%' == cursor.code)
+        {
+            if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_pe_reference(input, index))) break;
+        }
+        else if('&' == cursor.code)
+        {
+            if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_reference(input, index))) break;
+        }
+        else index += cursor.width;
+        paradox_xml1_cursor_load(input, &cursor, index);
     }
-
-    return result;
+    if(quote != paradox_xml1_peek(input, index)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index++;
+    return index;
 }
-// [27] Misc ::= Comment | PI | S
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_misc(paradox_str_t xml_string, paradox_uint64_t* index)
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_entity_value(paradox_str_t xml_string, paradox_uint64_t* index)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_entity_value);
+}
+// [10] AttValue ::= '"' ([^<&"] | Reference)* '"' | "'" ([^<&'] | Reference)* "'"
+static inline paradox_uint64_t paradox_xml1_parser_att_value(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    paradox_char8_t quote;
+    if('"' != paradox_xml1_peek(input, index) && '\'' != paradox_xml1_peek(input, index)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else
     {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
+        quote = paradox_xml1_peek(input, index);
+        index++;
     }
-    else if(NULL == index)
+    paradox_xml1_cursor cursor;
+    paradox_xml1_cursor_load(input, &cursor, index);
+    while((cursor.classes & PARADOX_XML1_CHARACTER_CHAR) && (paradox_uint32_t)quote != cursor.code && '<' != cursor.code)
     {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
+        if('&' == cursor.code)
+        {
+            if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_reference(input, index))) break;
+        }
+        else index += cursor.width;
+        paradox_xml1_cursor_load(input, &cursor, index);
     }
-    const paradox_uint64_t base_index = *index;
-
-    if( PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_comment(xml_string, index)
-    &&  PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_pi(xml_string, index)
-    &&  PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_space(xml_string, index))
+    if(quote != paradox_xml1_peek(input, index)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index++;
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_att_value(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_att_value);
+}
+// [11] SystemLiteral ::= ('"' [^"]* '"') | ("'" [^']* "'")
+static inline paradox_uint64_t paradox_xml1_parser_system_literal(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    paradox_char8_t quote;
+    if('"' != paradox_xml1_peek(input, index) && '\'' != paradox_xml1_peek(input, index)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else
     {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
+        quote = paradox_xml1_peek(input, index);
+        index++;
     }
-    result = PARADOX_XML1_PARSER_SUCCESS;
-
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
+    paradox_xml1_cursor cursor;
+    paradox_xml1_cursor_load(input, &cursor, index);
+    while((cursor.classes & PARADOX_XML1_CHARACTER_CHAR) && (paradox_uint32_t)quote != cursor.code) paradox_xml1_cursor_advance(input, &cursor);
+    index = cursor.index;
+    if(quote != paradox_xml1_peek(input, index)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index++;
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_system_literal(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_system_literal);
+}
+// [12] PubidLiteral ::= '"' PubidChar* '"' | "'" (PubidChar - "'")* "'"
+static inline paradox_uint64_t paradox_xml1_parser_pubid_literal(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    paradox_char8_t quote;
+    if('"' != paradox_xml1_peek(input, index) && '\'' != paradox_xml1_peek(input, index)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else
     {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
+        quote = paradox_xml1_peek(input, index);
+        index++;
     }
-
-    return result;
+    paradox_xml1_cursor cursor;
+    paradox_xml1_cursor_load(input, &cursor, index);
+    while((cursor.classes & PARADOX_XML1_CHARACTER_PUBID) && (paradox_uint32_t)quote != cursor.code) paradox_xml1_cursor_advance(input, &cursor);
+    index = cursor.index;
+    if(quote != paradox_xml1_peek(input, index)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index++;
+    return index;
 }
-
-// Document Type Definition
-
-// [28] doctypedecl ::= '<!DOCTYPE' S Name (S ExternalID)? S? ('[' intSubset ']' S?)? '>' [VC: Root Element Type][WFC: External Subset]
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_doctypedecl(paradox_str_t xml_string, paradox_uint64_t* index)
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_pubid_literal(paradox_str_t xml_string, paradox_uint64_t* index)
 {
-    return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_pubid_literal);
 }
-// [28a] DeclSep ::= PEReference | S [WFC: PE Between Declarations]
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_decl_sep(paradox_str_t xml_string, paradox_uint64_t* index)
+// [13] PubidChar ::= #x20 | #xD | #xA | [a-zA-Z0-9] | [-'()+,./:=?;!*#@$_%]
+static paradox_bool8_t paradox_xml1_is_pubid_char(const paradox_xml1_input* input, const paradox_uint64_t index)
 {
-    return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+    paradox_xml1_cursor cursor;
+    paradox_xml1_cursor_load(input, &cursor, index);
+    return 0 != (cursor.classes & PARADOX_XML1_CHARACTER_PUBID);
 }
-// [28b] intSubset ::= (markupdecl | DeclSep)*
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_int_subset(paradox_str_t xml_string, paradox_uint64_t* index)
+PARADOX_XML_API paradox_bool8_t paradox_is_xml1_pubid_char(paradox_str_t xml_string, const paradox_uint64_t index)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
-    const paradox_uint64_t base_index = *index;
+    const paradox_xml1_input input = { xml_string, PARADOX_XML1_INPUT_UNBOUNDED, PARADOX_FALSE };
+    return paradox_xml1_is_pubid_char(&input, index);
+}
 
-    while(  PARADOX_XML1_PARSER_SUCCESS == paradox_parse_xml1_markupdecl(xml_string, index)
-        ||  PARADOX_XML1_PARSER_SUCCESS == paradox_parse_xml1_decl_sep(xml_string, index));
-    result = PARADOX_XML1_PARSER_SUCCESS;
+// Character Data
 
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
+// [14] CharData ::= [^<&]* - ([^<&]* ']]>' [^<&]*)
+static inline paradox_uint64_t paradox_xml1_parser_char_data(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    paradox_xml1_cursor cursor;
+    paradox_xml1_cursor_load(input, &cursor, paradox_xml1_skip_char_data(input, index));
+    while(cursor.classes & PARADOX_XML1_CHARACTER_CHAR)
     {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
+        if('<' == cursor.code || '&' == cursor.code) break;
+        if(']' == cursor.code && !paradox_xml1_compare(input, cursor.index, "]]>", 3)) break;
+        paradox_xml1_cursor_load(input, &cursor, paradox_xml1_skip_char_data(input, cursor.index + cursor.width));
     }
+    index = cursor.index;
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_char_data(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_char_data);
+}
 
-    return result;
+// [15] Comment ::= '<!--' ((Char - '-') | ('-' (Char - '-')))* '-->'
+static inline paradox_uint64_t paradox_xml1_parser_comment(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if(paradox_xml1_compare(input, index, "<!--", 4)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index += 4;
+    paradox_xml1_cursor cursor;
+    // The content ends at the first "--", which has to be the one of the closing "-->".
+    paradox_xml1_cursor_load(input, &cursor, paradox_xml1_skip_to_terminator(input, index, "--", NULL));
+    while(cursor.classes & PARADOX_XML1_CHARACTER_CHAR)
+    {
+        if('-' == cursor.code && !paradox_xml1_compare(input, cursor.index, "--", 2)) break;
+        paradox_xml1_cursor_load(input, &cursor, paradox_xml1_skip_to_terminator(input, cursor.index + cursor.width, "--", NULL));
+    }
+    index = cursor.index;
+    if(paradox_xml1_compare(input, index, "-->", 3)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index += 3;
+    return index;
 }
-// [29] markupdecl ::= elementdecl | AttlistDecl | EntityDecl | NotationDecl | PI | Comment [VC: Proper Declaration/PE Nesting][WFC: PEs in Internal Subset]
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_markupdecl(paradox_str_t xml_string, paradox_uint64_t* index)
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_comment(paradox_str_t xml_string, paradox_uint64_t* index)
 {
-    return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_comment);
 }
 
-// External Subset
+// Processing Instructions
 
-// [30] extSubset ::= TextDecl? extSubsetDecl
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_ext_subset(paradox_str_t xml_string, paradox_uint64_t* index)
+// [16] PI ::= '<?' PITarget (S (Char* - (Char* '?>' Char*)))? '?>'
+static inline paradox_uint64_t paradox_xml1_parser_pi(const paradox_xml1_input* input, paradox_uint64_t index)
 {
-    return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+    if(paradox_xml1_compare(input, index, "<?", 2)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index += 2;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_pi_target(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    if(paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index)))
+    {
+        paradox_xml1_cursor cursor;
+        paradox_xml1_cursor_load(input, &cursor, paradox_xml1_skip_to_terminator(input, index, "?>", NULL));
+        while(cursor.classes & PARADOX_XML1_CHARACTER_CHAR)
+        {
+            if('?' == cursor.code && !paradox_xml1_compare(input, cursor.index, "?>", 2)) break;
+            paradox_xml1_cursor_load(input, &cursor, paradox_xml1_skip_to_terminator(input, cursor.index + cursor.width, "?>", NULL));
+        }
+        index = cursor.index;
+    }
+    if(paradox_xml1_compare(input, index, "?>", 2)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index += 2;
+    return index;
 }
-// [31] extSubsetDecl ::= ( markupdecl | conditionalSect | DeclSep)*
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_ext_subset_decl(paradox_str_t xml_string, paradox_uint64_t* index)
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_pi(paradox_str_t xml_string, paradox_uint64_t* index)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
-    const paradox_uint64_t base_index = *index;
-
-    while(  PARADOX_XML1_PARSER_SUCCESS == paradox_parse_xml1_markupdecl(xml_string, index)
-        ||  PARADOX_XML1_PARSER_SUCCESS == paradox_parse_xml1_conditional_sect(xml_string, index)
-        ||  PARADOX_XML1_PARSER_SUCCESS == paradox_parse_xml1_decl_sep(xml_string, index));
-    result = PARADOX_XML1_PARSER_SUCCESS;
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_pi);
+}
 
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
+// [17] PITarget ::= Name - (('X' | 'x') ('M' | 'm') ('L' | 'l'))
+static inline paradox_uint64_t paradox_xml1_parser_pi_target(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if( ('\0' != paradox_xml1_peek(input, index) && ('X' == paradox_xml1_peek(input, index) || 'x' == paradox_xml1_peek(input, index)))
+    &&  ('\0' != paradox_xml1_peek(input, index + 1) && ('M' == paradox_xml1_peek(input, index + 1) || 'm' == paradox_xml1_peek(input, index + 1)))
+    &&  ('\0' != paradox_xml1_peek(input, index + 2) && ('L' == paradox_xml1_peek(input, index + 2) || 'l' == paradox_xml1_peek(input, index + 2))))
     {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
+        return PARADOX_XML1_PARSER_NO_MATCH;
     }
-
-    return result;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_name(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_pi_target(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_pi_target);
 }
 
-// Standalone Document Declaration
+// CDATA Sections
 
-// [32] SDDecl ::= S 'standalone' Eq (("'" ('yes' | 'no') "'") | ('"' ('yes' | 'no') '"')) [VC: Standalone Document Declaration]
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_sd_decl(paradox_str_t xml_string, paradox_uint64_t* index)
+// [18] CDSect ::= CDStart CData CDEnd
+static inline paradox_uint64_t paradox_xml1_parser_cd_sect(const paradox_xml1_input* input, paradox_uint64_t index)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_cd_start(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_c_data(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_cd_end(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_cd_sect(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_cd_sect);
+}
+// [19] CDStart ::= '<![CDATA['
+static inline paradox_uint64_t paradox_xml1_parser_cd_start(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if(paradox_xml1_compare(input, index, "<![CDATA[", 9)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index += 9;
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_cd_start(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_cd_start);
+}
+// [20] CData ::= (Char* - (Char* ']]>' Char*))
+static inline paradox_uint64_t paradox_xml1_parser_c_data(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    paradox_xml1_cursor cursor;
+    paradox_xml1_cursor_load(input, &cursor, paradox_xml1_skip_to_terminator(input, index, "]]>", NULL));
+    while(cursor.classes & PARADOX_XML1_CHARACTER_CHAR)
     {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
+        if(']' == cursor.code && !paradox_xml1_compare(input, cursor.index, "]]>", 3)) break;
+        paradox_xml1_cursor_load(input, &cursor, paradox_xml1_skip_to_terminator(input, cursor.index + cursor.width, "]]>", NULL));
     }
-    const paradox_uint64_t base_index = *index;
+    index = cursor.index;
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_c_data(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_c_data);
+}
+// [21] CDEnd ::= ']]>'
+static inline paradox_uint64_t paradox_xml1_parser_cd_end(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if(paradox_xml1_compare(input, index, "]]>", 3)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index += 3;
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_cd_end(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_cd_end);
+}
 
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_space(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    if(strncmp(xml_string + *index, "standalone", 10))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else (*index) += 10;
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_eq(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    
-    if(!strncmp(xml_string + *index, "\"yes\"", 5) || !strncmp(xml_string + *index, "'yes'", 5) )
-    {
-        (*index) += 5;
-    }
-    else if(!strncmp(xml_string + *index, "\"no\"", 4) || !strncmp(xml_string + *index, "'no'", 4) )
-    {
-        (*index) += 4;
-    }
-    else
+// Prolog
+
+// [22] prolog ::= XMLDecl Misc* (doctypedecl Misc*)?
+static inline paradox_uint64_t paradox_xml1_parser_prolog(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_xml_decl(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    while(paradox_xml1_parser_accept(&index, paradox_xml1_parser_misc(input, index)));
+    if(paradox_xml1_parser_accept(&index, paradox_xml1_parser_doctypedecl(input, index)))
     {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
+        while(paradox_xml1_parser_accept(&index, paradox_xml1_parser_misc(input, index)));
     }
-    result = PARADOX_XML1_PARSER_SUCCESS;
-
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_prolog(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_prolog);
+}
+// [23] XMLDecl ::= '<?xml' VersionInfo EncodingDecl? SDDecl? S? '?>'
+static inline paradox_uint64_t paradox_xml1_parser_xml_decl(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if(paradox_xml1_compare(input, index, "<?xml", 5)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index += 5;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_version_info(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_encoding_decl(input, index));
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_sd_decl(input, index));
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+    if(paradox_xml1_compare(input, index, "?>", 2)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index += 2;
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_xml_decl(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_xml_decl);
+}
+// [24] VersionInfo ::= S 'version' Eq ("'" VersionNum "'" | '"' VersionNum '"')
+static inline paradox_uint64_t paradox_xml1_parser_version_info(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    if(paradox_xml1_compare(input, index, "version", 7)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index += 7;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_eq(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    paradox_char8_t quote;
+    if('"' == paradox_xml1_peek(input, index) || '\'' == paradox_xml1_peek(input, index))
     {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
+        quote = paradox_xml1_peek(input, index++);
     }
-
-    return result;
+    else return PARADOX_XML1_PARSER_NO_MATCH;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_version_num(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    if(quote != paradox_xml1_peek(input, index)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index++;
+    return index;
 }
-
-// Element
-
-// [39] element ::= EmptyElemTag | STag content ETag [WFC: Element Type Match][VC: Element Valid]
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_element(paradox_str_t xml_string, paradox_uint64_t* index)
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_version_info(paradox_str_t xml_string, paradox_uint64_t* index)
 {
-    return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_version_info);
 }
-
-// Start-tag
-
-// [40] STag ::= '<' Name (S Attribute)* S? '>' [WFC: Unique Att Spec]
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_s_tag(paradox_str_t xml_string, paradox_uint64_t* index)
+// [25] Eq ::= S? '=' S?
+static inline paradox_uint64_t paradox_xml1_parser_eq(const paradox_xml1_input* input, paradox_uint64_t index)
 {
-    return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+    if('=' != paradox_xml1_peek(input, index)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index++;
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+    return index;
 }
-// [41] Attribute ::= Name Eq AttValue [VC: Attribute Value Type][WFC: No External Entity References][WFC: No < in Attribute Values]
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_attribute(paradox_str_t xml_string, paradox_uint64_t* index)
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_eq(paradox_str_t xml_string, paradox_uint64_t* index)
 {
-    return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_eq);
 }
-
-// End-tag
-
-// [42] ETag ::= '</' Name S? '>'
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_e_tag(paradox_str_t xml_string, paradox_uint64_t* index)
+// [26] VersionNum ::= '1.1'
+static inline paradox_uint64_t paradox_xml1_parser_version_num(const paradox_xml1_input* input, paradox_uint64_t index)
 {
-    return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+    if(paradox_xml1_compare(input, index, "1.1", 3)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index += 3;
+    return index;
 }
-
-// Content of Elements
-
-// [43] content ::= CharData? ((element | Reference | CDSect | PI | Comment) CharData?)*
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_content(paradox_str_t xml_string, paradox_uint64_t* index)
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_version_num(paradox_str_t xml_string, paradox_uint64_t* index)
 {
-    return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_version_num);
 }
-
-// Tags for Empty Elements
-
-// [44] EmptyElemTag ::= '<' Name (S Attribute)* S? '/>' [WFC: Unique Att Spec]
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_empty_elem_tag(paradox_str_t xml_string, paradox_uint64_t* index)
+// [27] Misc ::= Comment | PI | S
+static inline paradox_uint64_t paradox_xml1_parser_misc(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    // The first two bytes select the only alternative that can match.
+    if('<' != paradox_xml1_peek(input, index)) return paradox_xml1_parser_space(input, index);
+    if('?' == paradox_xml1_peek(input, index + 1)) return paradox_xml1_parser_pi(input, index);
+    return paradox_xml1_parser_comment(input, index);
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_misc(paradox_str_t xml_string, paradox_uint64_t* index)
 {
-    return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_misc);
 }
 
-// Element Type Declaration
+// Document Type Definition
 
-// [45] elementdecl ::= '<!ELEMENT' S Name S contentspec S? '>' [VC: Unique Element Type Declaration]
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_elementdecl(paradox_str_t xml_string, paradox_uint64_t* index)
+// [28] doctypedecl ::= '<!DOCTYPE' S Name (S ExternalID)? S? ('[' intSubset ']' S?)? '>' [VC: Root Element Type][WFC: External Subset]
+static inline paradox_uint64_t paradox_xml1_parser_doctypedecl(const paradox_xml1_input* input, paradox_uint64_t index)
 {
-    return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+    if(paradox_xml1_compare(input, index, "<!DOCTYPE", 9)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index += 9;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_name(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    // The S before the ExternalID is the S? after it when there is none.
+    if(paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index))) paradox_xml1_parser_accept(&index, paradox_xml1_parser_external_id(input, index));
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+    if('[' == paradox_xml1_peek(input, index))
+    {
+        index = paradox_xml1_parser_int_subset(input, index + 1);
+        if(']' != paradox_xml1_peek(input, index)) return PARADOX_XML1_PARSER_NO_MATCH;
+        else index++;
+        paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+    }
+    if('>' != paradox_xml1_peek(input, index)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index++;
+    return index;
 }
-// [46] contentspec ::= 'EMPTY' | 'ANY' | Mixed | children
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_contentspec(paradox_str_t xml_string, paradox_uint64_t* index)
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_doctypedecl(paradox_str_t xml_string, paradox_uint64_t* index)
 {
-    return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_doctypedecl);
 }
 
-// Element-content Models
+static paradox_xml1_parser_errno_t paradox_xml1_parser_declarations(const paradox_xml1_input* input, paradox_uint64_t* index, paradox_xml1_entity_table* entities);
 
-// [47] children ::= (choice | seq) ('?' | '*' | '+')?
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_children(paradox_str_t xml_string, paradox_uint64_t* index)
+// Declares the entity of the EntityDecl that markupdecl recognized at index. Only the internal subset is read, where
+// a parameter-entity reference cannot stand inside the EntityValue. [WFC: PEs in Internal Subset]
+static paradox_xml1_parser_errno_t paradox_xml1_parser_declare_entity(const paradox_xml1_input* input, paradox_uint64_t index, paradox_xml1_entity_table* entities)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
+    // '<!ENTITY' S ('%' S)? Name S (EntityValue | ExternalID NDataDecl?)
+    index += 8;
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+    const paradox_bool8_t parameter = '%' == paradox_xml1_peek(input, index);
+    if(PARADOX_TRUE == parameter) paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index + 1));
+    const paradox_uint64_t name_index = index;
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_name(input, index));
+    const paradox_uint64_t name_length = index - name_index;
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+
+    const paradox_char8_t quote = paradox_xml1_peek(input, index);
+    if('"' == quote || '\'' == quote)
+    {
+        const paradox_xml1_slice literal = { input->data + index + 1, paradox_xml1_parser_entity_value(input, index) - index - 2 };
+        if(NULL != memchr(literal.data, '%', literal.length)) return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+        return PARADOX_TRUE == paradox_xml1_entities_declare(entities, input->data + name_index, name_length, parameter, &literal, PARADOX_FALSE) ? PARADOX_XML1_PARSER_SUCCESS : PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+    }
+    index = paradox_xml1_parser_external_id(input, index);
+    const paradox_bool8_t unparsed = PARADOX_XML1_PARSER_NO_MATCH != paradox_xml1_parser_ndata_decl(input, index);
+    return PARADOX_TRUE == paradox_xml1_entities_declare(entities, input->data + name_index, name_length, parameter, NULL, unparsed) ? PARADOX_XML1_PARSER_SUCCESS : PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+}
+
+// Adds the particles of the cp at *index, a Name or a group followed by the particles it holds, and returns the index of
+// its own, or PARADOX_XML1_ELEMENTS_NONE when out of memory. The elementdecl has been recognized already.
+static paradox_uint32_t paradox_xml1_parser_particle(const paradox_xml1_input* input, paradox_uint64_t* index, paradox_xml1_element_table* elements)
+{
+    paradox_uint32_t particle;
+    if('(' != paradox_xml1_peek(input, *index))
     {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
+        const paradox_uint64_t name_index = *index;
+        paradox_xml1_parser_accept(index, paradox_xml1_parser_name(input, *index));
+        const paradox_uint32_t type = paradox_xml1_elements_intern(elements, input->data + name_index, *index - name_index);
+        if(PARADOX_XML1_ELEMENTS_NONE == type) return PARADOX_XML1_ELEMENTS_NONE;
+        particle = paradox_xml1_elements_add_particle(elements, PARADOX_XML1_PARTICLE_NAME, type);
+        if(PARADOX_XML1_ELEMENTS_NONE == particle) return PARADOX_XML1_ELEMENTS_NONE;
     }
-    const paradox_uint64_t base_index = *index;
-
-    if( PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_choice(xml_string, index)
-    &&  PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_seq(xml_string, index))
+    else
     {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
+        // '(' S? cp (S? ('|' | ',') S? cp)* S? ')', where a group of one cp is a sequence.
+        particle = paradox_xml1_elements_add_particle(elements, PARADOX_XML1_PARTICLE_SEQUENCE, PARADOX_XML1_ELEMENTS_NONE);
+        if(PARADOX_XML1_ELEMENTS_NONE == particle) return PARADOX_XML1_ELEMENTS_NONE;
+        (*index)++;
+        paradox_xml1_parser_accept(index, paradox_xml1_parser_space(input, *index));
+        paradox_uint32_t last = PARADOX_XML1_ELEMENTS_NONE;
+        for(;;)
+        {
+            const paradox_uint32_t child = paradox_xml1_parser_particle(input, index, elements);
+            if(PARADOX_XML1_ELEMENTS_NONE == child) return PARADOX_XML1_ELEMENTS_NONE;
+            if(PARADOX_XML1_ELEMENTS_NONE == last) elements->particles[particle].first = child;
+            else elements->particles[last].next = child;
+            last = child;
+            paradox_xml1_parser_accept(index, paradox_xml1_parser_space(input, *index));
+            const paradox_char8_t separator = paradox_xml1_peek(input, (*index)++);
+            if(')' == separator) break;
+            if('|' == separator) elements->particles[particle].kind = PARADOX_XML1_PARTICLE_CHOICE;
+            paradox_xml1_parser_accept(index, paradox_xml1_parser_space(input, *index));
+        }
     }
-    switch(xml_string[*index])
+    const paradox_char8_t occurrence = paradox_xml1_peek(input, *index);
+    if('?' == occurrence || '*' == occurrence || '+' == occurrence)
     {
-    case '?':
-    case '*':
-    case '+':
+        elements->particles[particle].occurrence = occurrence;
         (*index)++;
-        break;
-    default: break;
     }
-    result = PARADOX_XML1_PARSER_SUCCESS;
+    return particle;
+}
 
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
+// Declares the element type of the elementdecl that markupdecl recognized at index and compiles its content model.
+// Every name of a children content model costs as many bytes of the byte budget as there are names, which bounds the
+// transitions of its automaton. [VC: Unique Element Type Declaration]
+static paradox_xml1_parser_errno_t paradox_xml1_parser_declare_element(const paradox_xml1_input* input, paradox_uint64_t index, paradox_xml1_entity_table* entities)
+{
+    paradox_xml1_element_table* elements = entities->elements;
+    // '<!ELEMENT' S Name S contentspec
+    index += 9;
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+    const paradox_uint64_t name_index = index;
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_name(input, index));
+    const paradox_uint32_t type = paradox_xml1_elements_intern(elements, input->data + name_index, index - name_index);
+    if(PARADOX_XML1_ELEMENTS_NONE == type) return PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+    if(PARADOX_TRUE == elements->types[type].declared) return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+
+    if(!paradox_xml1_compare(input, index, "EMPTY", 5)) return paradox_xml1_elements_compile(elements, type, PARADOX_XML1_CONTENT_EMPTY);
+    if(!paradox_xml1_compare(input, index, "ANY", 3)) return paradox_xml1_elements_compile(elements, type, PARADOX_XML1_CONTENT_ANY);
+    elements->particle_count = 0;
+    paradox_uint64_t mixed_index = index + 1;
+    paradox_xml1_parser_accept(&mixed_index, paradox_xml1_parser_space(input, mixed_index));
+    if(!paradox_xml1_compare(input, mixed_index, "#PCDATA", 7))
+    {
+        // '#PCDATA' (S? '|' S? Name)* S? ')*'
+        index = mixed_index + 7;
+        for(;;)
+        {
+            paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+            if('|' != paradox_xml1_peek(input, index)) break;
+            index++;
+            paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+            const paradox_uint64_t child_index = index;
+            paradox_xml1_parser_accept(&index, paradox_xml1_parser_name(input, index));
+            const paradox_uint32_t child = paradox_xml1_elements_intern(elements, input->data + child_index, index - child_index);
+            if(PARADOX_XML1_ELEMENTS_NONE == child) return PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+            if(PARADOX_XML1_ELEMENTS_NONE == paradox_xml1_elements_add_particle(elements, PARADOX_XML1_PARTICLE_NAME, child)) return PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+        }
+        return paradox_xml1_elements_compile(elements, type, PARADOX_XML1_CONTENT_MIXED);
     }
 
-    return result;
+    if(PARADOX_XML1_ELEMENTS_NONE == paradox_xml1_parser_particle(input, &index, elements)) return PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+    paradox_uint64_t names = 0;
+    for(paradox_uint64_t i = 0; i < elements->particle_count; i++) if(PARADOX_XML1_PARTICLE_NAME == elements->particles[i].kind) names++;
+    if(PARADOX_FALSE == paradox_xml1_entities_charge(entities, names * names)) return PARADOX_XML1_PARSER_ENTITY_LIMIT;
+    return paradox_xml1_elements_compile(elements, type, PARADOX_XML1_CONTENT_CHILDREN);
 }
-// [48] cp ::= (Name | choice | seq) ('?' | '*' | '+')?
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_cp(paradox_str_t xml_string, paradox_uint64_t* index)
+
+// Includes the replacement text of the parameter entity the PEReference of length bytes at reference refers to
+// between the declarations, which has to hold whole declarations of its own. One that is not read may declare
+// anything, so the declarations after it are not processed. [WFC: PE Between Declarations][WFC: No Recursion]
+static paradox_xml1_parser_errno_t paradox_xml1_parser_include_declarations(const char* reference, const paradox_uint64_t length, paradox_xml1_entity_table* entities)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
+    entities->incomplete = PARADOX_TRUE;
+    paradox_xml1_entity* entity = paradox_xml1_entities_find(entities, reference + 1, length - 2, PARADOX_TRUE);
+    if(NULL == entity || PARADOX_TRUE == entity->external)
     {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
+        entities->skipped = PARADOX_TRUE;
+        return PARADOX_XML1_PARSER_SUCCESS;
     }
-    const paradox_uint64_t base_index = *index;
+    paradox_xml1_parser_errno_t result = paradox_xml1_parser_expand_entity(entities, entity);
+    if(PARADOX_XML1_PARSER_SUCCESS != result) return result;
+    if(PARADOX_FALSE == paradox_xml1_entities_charge(entities, entity->replacement.length)) return PARADOX_XML1_PARSER_ENTITY_LIMIT;
+    if(entities->depth >= entities->depth_limit) return PARADOX_XML1_PARSER_ENTITY_LIMIT;
 
-    if( PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_name(xml_string, index)
-    &&  PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_choice(xml_string, index)
-    &&  PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_seq(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    switch(xml_string[*index])
-    {
-    case '?':
-    case '*':
-    case '+':
-        (*index)++;
-        break;
-    default: break;
-    }
-    result = PARADOX_XML1_PARSER_SUCCESS;
+    // The declarations may grow the entities, so the entity is found again by its position.
+    const paradox_uint64_t position = (paradox_uint64_t)(entity - entities->entities);
+    const paradox_xml1_input replacement = { entity->replacement.data, entity->replacement.length, PARADOX_FALSE };
+    paradox_uint64_t index = 0;
+    entity->state = PARADOX_XML1_ENTITY_EXPANDING;
+    entities->depth++;
+    result = paradox_xml1_parser_declarations(&replacement, &index, entities);
+    entities->depth--;
+    entities->entities[position].state = PARADOX_XML1_ENTITY_EXPANDED;
+    if(PARADOX_XML1_PARSER_SUCCESS == result && index != replacement.length) result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+    return result;
+}
 
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
+// (markupdecl | DeclSep)*, the intSubset walked up to the first text that is neither. Declares the entities of the
+// EntityDecls until a parameter entity that is not read is referenced, and the element types of the elementdecls
+// when the parse validates.
+static paradox_xml1_parser_errno_t paradox_xml1_parser_declarations(const paradox_xml1_input* input, paradox_uint64_t* index, paradox_xml1_entity_table* entities)
+{
+    paradox_xml1_parser_errno_t result = PARADOX_XML1_PARSER_SUCCESS;
+    while(PARADOX_XML1_PARSER_SUCCESS == result)
     {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
+        const paradox_uint64_t declaration_index = *index;
+        const paradox_char8_t byte = paradox_xml1_peek(input, *index);
+        if('%' == byte)
+        {
+            if(!paradox_xml1_parser_accept(index, paradox_xml1_parser_pe_reference(input, *index))) break;
+            result = paradox_xml1_parser_include_declarations(input->data + declaration_index, *index - declaration_index, entities);
+        }
+        else if('<' == byte)
+        {
+            if(!paradox_xml1_parser_accept(index, paradox_xml1_parser_markupdecl(input, *index))) break;
+            if(PARADOX_FALSE == entities->skipped && !paradox_xml1_compare(input, declaration_index, "<!ENTITY", 8)) result = paradox_xml1_parser_declare_entity(input, declaration_index, entities);
+            else if(NULL != entities->elements && !paradox_xml1_compare(input, declaration_index, "<!ELEMENT", 9)) result = paradox_xml1_parser_declare_element(input, declaration_index, entities);
+        }
+        else if(!paradox_xml1_parser_accept(index, paradox_xml1_parser_space(input, *index))) break;
     }
-
     return result;
 }
-// [49] choice ::= '(' S? cp ( S? '|' S? cp )+ S? ')' [VC: Proper Group/PE Nesting]
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_choice(paradox_str_t xml_string, paradox_uint64_t* index)
+
+// doctypedecl walked at *index, when there is one, with the entities it declares recorded into a table created with
+// the budgets of options, together with the element types it declares when options ask to validate. The external
+// subset is not read, so the entities and element types it declares are not known.
+static paradox_xml1_parser_errno_t paradox_xml1_parser_doctype(const paradox_xml1_input* input, paradox_uint64_t* index, const paradox_xml1_parser_options* options, paradox_xml1_entity_table** entities)
 {
-    return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+    if(paradox_xml1_compare(input, *index, "<!DOCTYPE", 9)) return PARADOX_XML1_PARSER_SUCCESS;
+    paradox_uint64_t next = *index + 9;
+    if(!paradox_xml1_parser_accept(&next, paradox_xml1_parser_space(input, next))) return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+    const paradox_uint64_t name_index = next;
+    if(!paradox_xml1_parser_accept(&next, paradox_xml1_parser_name(input, next))) return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+    *entities = paradox_xml1_entities_create(
+        NULL != options && 0 != options->entity_depth ? options->entity_depth : PARADOX_XML1_PARSER_ENTITY_DEPTH,
+        NULL != options && 0 != options->entity_bytes ? options->entity_bytes : PARADOX_XML1_PARSER_ENTITY_BYTES);
+    if(NULL == *entities) return PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+    if(NULL != options && PARADOX_TRUE == options->validate)
+    {
+        (*entities)->elements = paradox_xml1_elements_create();
+        if(NULL == (*entities)->elements) return PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+        (*entities)->elements->root = paradox_xml1_elements_intern((*entities)->elements, input->data + name_index, next - name_index);
+        if(PARADOX_XML1_ELEMENTS_NONE == (*entities)->elements->root) return PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+    }
+    if(paradox_xml1_parser_accept(&next, paradox_xml1_parser_space(input, next)) && paradox_xml1_parser_accept(&next, paradox_xml1_parser_external_id(input, next))) (*entities)->incomplete = PARADOX_TRUE;
+    paradox_xml1_parser_accept(&next, paradox_xml1_parser_space(input, next));
+    if('[' == paradox_xml1_peek(input, next))
+    {
+        next++;
+        const paradox_xml1_parser_errno_t result = paradox_xml1_parser_declarations(input, &next, *entities);
+        if(PARADOX_XML1_PARSER_SUCCESS != result) return result;
+        if(']' != paradox_xml1_peek(input, next)) return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+        else next++;
+        paradox_xml1_parser_accept(&next, paradox_xml1_parser_space(input, next));
+    }
+    if('>' != paradox_xml1_peek(input, next)) return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+    *index = next + 1;
+    return PARADOX_XML1_PARSER_SUCCESS;
 }
-// [50] seq ::= '(' S? cp ( S? ',' S? cp )* S? ')' [VC: Proper Group/PE Nesting]
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_seq(paradox_str_t xml_string, paradox_uint64_t* index)
+// [28a] DeclSep ::= PEReference | S [WFC: PE Between Declarations]
+static inline paradox_uint64_t paradox_xml1_parser_decl_sep(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if('%' == paradox_xml1_peek(input, index)) return paradox_xml1_parser_pe_reference(input, index);
+    return paradox_xml1_parser_space(input, index);
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_decl_sep(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_decl_sep);
+}
+// [28b] intSubset ::= (markupdecl | DeclSep)*
+static inline paradox_uint64_t paradox_xml1_parser_int_subset(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    // Every markupdecl starts with '<' and no DeclSep does.
+    while(paradox_xml1_parser_accept(&index, '<' == paradox_xml1_peek(input, index)
+        ?   paradox_xml1_parser_markupdecl(input, index)
+        :   paradox_xml1_parser_decl_sep(input, index)));
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_int_subset(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_int_subset);
+}
+// [29] markupdecl ::= elementdecl | AttlistDecl | EntityDecl | NotationDecl | PI | Comment [VC: Proper Declaration/PE Nesting][WFC: PEs in Internal Subset]
+static inline paradox_uint64_t paradox_xml1_parser_markupdecl(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    // '<?', '<!-', '<!EL', '<!EN', '<!A' and '<!N' select the only alternative that can match.
+    if('<' != paradox_xml1_peek(input, index)) return PARADOX_XML1_PARSER_NO_MATCH;
+    const paradox_char8_t marker = paradox_xml1_peek(input, index + 1);
+    if('?' == marker) return paradox_xml1_parser_pi(input, index);
+    if('!' != marker) return PARADOX_XML1_PARSER_NO_MATCH;
+    const paradox_char8_t keyword = paradox_xml1_peek(input, index + 2);
+    if('-' == keyword) return paradox_xml1_parser_comment(input, index);
+    if('A' == keyword) return paradox_xml1_parser_attlist_decl(input, index);
+    if('N' == keyword) return paradox_xml1_parser_notation_decl(input, index);
+    if('E' == keyword && 'L' == paradox_xml1_peek(input, index + 3)) return paradox_xml1_parser_elementdecl(input, index);
+    if('E' == keyword) return paradox_xml1_parser_entity_decl(input, index);
+    return PARADOX_XML1_PARSER_NO_MATCH;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_markupdecl(paradox_str_t xml_string, paradox_uint64_t* index)
 {
-    return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_markupdecl);
 }
 
-// Mixed-content Declaration
+// External Subset
 
-// [51] Mixed ::= '(' S? '#PCDATA' (S? '|' S? Name)* S? ')*' | '(' S? '#PCDATA' S? ')' [VC: Proper Group/PE Nesting][VC: No Duplicate Types]
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_mixed(paradox_str_t xml_string, paradox_uint64_t* index)
+// [30] extSubset ::= TextDecl? extSubsetDecl
+static inline paradox_uint64_t paradox_xml1_parser_ext_subset(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    return PARADOX_XML1_PARSER_NO_MATCH;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_ext_subset(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_ext_subset);
+}
+// [31] extSubsetDecl ::= ( markupdecl | conditionalSect | DeclSep)*
+static inline paradox_uint64_t paradox_xml1_parser_ext_subset_decl(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    // conditionalSect is the markup starting with '<![', DeclSep the only alternative not starting with '<'.
+    while(paradox_xml1_parser_accept(&index, '<' != paradox_xml1_peek(input, index)
+        ?   paradox_xml1_parser_decl_sep(input, index)
+        :   '!' == paradox_xml1_peek(input, index + 1) && '[' == paradox_xml1_peek(input, index + 2)
+        ?   paradox_xml1_parser_conditional_sect(input, index)
+        :   paradox_xml1_parser_markupdecl(input, index)));
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_ext_subset_decl(paradox_str_t xml_string, paradox_uint64_t* index)
 {
-    return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_ext_subset_decl);
 }
 
-// Attribute-list Declaration
+// Standalone Document Declaration
 
-// [52] AttlistDecl ::= '<!ATTLIST' S Name AttDef* S? '>'
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_attlist_decl(paradox_str_t xml_string, paradox_uint64_t* index)
+// [32] SDDecl ::= S 'standalone' Eq (("'" ('yes' | 'no') "'") | ('"' ('yes' | 'no') '"')) [VC: Standalone Document Declaration]
+static inline paradox_uint64_t paradox_xml1_parser_sd_decl(const paradox_xml1_input* input, paradox_uint64_t index)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    if(paradox_xml1_compare(input, index, "standalone", 10)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index += 10;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_eq(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    
+    if(!paradox_xml1_compare(input, index, "\"yes\"", 5) || !paradox_xml1_compare(input, index, "'yes'", 5) )
     {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
+        index += 5;
     }
-    else if(NULL == index)
+    else if(!paradox_xml1_compare(input, index, "\"no\"", 4) || !paradox_xml1_compare(input, index, "'no'", 4) )
     {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
+        index += 4;
     }
+    else return PARADOX_XML1_PARSER_NO_MATCH;
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_sd_decl(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_sd_decl);
+}
+
+// Element
+
+static paradox_xml1_parser_errno_t paradox_xml1_parser_attribute(const paradox_xml1_input* input, paradox_uint64_t* index, paradox_xml1_document* document, paradox_xml1_attribute** attribute, paradox_xml1_slice* name, paradox_xml1_slice* value);
+
+// '<' Name (S Attribute)* S?, the part shared by STag and EmptyElemTag.
+// When a document is given the element and its attributes are allocated from its arena,
+// when events are given the start of the element and its attributes are emitted.
+static paradox_xml1_parser_errno_t paradox_xml1_parser_tag(const paradox_xml1_input* input, paradox_uint64_t* index, paradox_xml1_document* document, paradox_xml1_parser_events* events, paradox_xml1_element** element, paradox_uint64_t* name_length)
+{
+    paradox_xml1_parser_errno_t result;
     const paradox_uint64_t base_index = *index;
+    paradox_xml1_element* created = NULL;
 
-    if(strncmp(xml_string + *index, "<!ATTLIST", 9))
+    if('<' != paradox_xml1_peek(input, *index))
     {
         result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
         goto INVALID_PARSING;
-    } else (*index) += 9;
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_space(xml_string, index))
+    }
+    else (*index)++;
+    const paradox_uint64_t name_index = *index;
+    if(!paradox_xml1_parser_accept(index, paradox_xml1_parser_name(input, *index)))
     {
         result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
         goto INVALID_PARSING;
     }
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_name(xml_string, index))
+    if(NULL != name_length) *name_length = *index - name_index;
+    if(NULL != document)
     {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
+        const paradox_xml1_slice tag = { input->data + name_index, *index - name_index };
+        created = paradox_xml1_parser_create_element(document, tag);
+        if(NULL == created)
+        {
+            result = PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+            goto INVALID_PARSING;
+        }
     }
-    while(PARADOX_XML1_PARSER_SUCCESS == paradox_parse_xml1_att_def(xml_string, index));
-    paradox_parse_xml1_space(xml_string, index);
-    if('>' != xml_string[*index])
+    if(NULL != events && PARADOX_FALSE == paradox_xml1_parser_emit(events, events->handler->start_element, input->data + name_index, *index - name_index))
     {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+        result = PARADOX_XML1_PARSER_ABORTED;
         goto INVALID_PARSING;
-    } else (*index)++;
-    result = PARADOX_XML1_PARSER_SUCCESS;
+    }
 
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
+    paradox_xml1_attribute* last_attribute = NULL;
+    paradox_uint64_t attribute_count = 0;
+    while('\0' != paradox_xml1_peek(input, *index))
     {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
+        paradox_uint64_t next_index = *index;
+        if(!paradox_xml1_parser_accept(&next_index, paradox_xml1_parser_space(input, next_index))) break;
+        paradox_xml1_attribute* attribute = NULL;
+        paradox_xml1_slice attribute_name;
+        paradox_xml1_slice attribute_value;
+        result = paradox_xml1_parser_attribute(input, &next_index, document, &attribute, &attribute_name, &attribute_value);
+        if(PARADOX_XML1_PARSER_INVALID_DOCUMENT == result) break;
+        if(PARADOX_XML1_PARSER_SUCCESS != result) goto INVALID_PARSING;
+        if(NULL != attribute)
+        {
+            result = paradox_xml1_parser_add_attribute(document, created, &last_attribute, attribute);
+            if(PARADOX_XML1_PARSER_SUCCESS != result) goto INVALID_PARSING;
+        }
+        if(NULL != events)
+        {
+            result = paradox_xml1_parser_emit_attribute(events, attribute_count, attribute_name, attribute_value);
+            if(PARADOX_XML1_PARSER_SUCCESS != result) goto INVALID_PARSING;
+        }
+        attribute_count++;
+        *index = next_index;
     }
-
-    return result;
-}
-// [53] AttDef ::= S Name S AttType S DefaultDecl
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_att_def(paradox_str_t xml_string, paradox_uint64_t* index)
-{
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
-    const paradox_uint64_t base_index = *index;
-
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_space(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_name(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_space(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_att_type(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_space(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_default_decl(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    result = PARADOX_XML1_PARSER_SUCCESS;
+    paradox_xml1_parser_accept(index, paradox_xml1_parser_space(input, *index));
+    if(NULL != element) *element = created;
+    result = PARADOX_XML1_PARSER_SUCCESS;
 
     INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
-    }
+    if(result != PARADOX_XML1_PARSER_SUCCESS) *index = base_index;
 
     return result;
 }
 
-// Attribute Types
+// Content of Elements
 
-// [54] AttType ::= StringType | TokenizedType | EnumeratedType
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_att_type(paradox_str_t xml_string, paradox_uint64_t* index)
+// Appends every child element to parent after last_child and gathers the text pieces into text.
+// Each piece is also emitted as its own event, with references decoded on their own.
+// Stops after the first piece that reaches stop, which is the length of the input for a whole element.
+// A reference to an entity is included on its own when there is a tree or events to include it in.
+// Every piece and child element is checked against validation unless it is NULL. [VC: Element Valid]
+static paradox_xml1_parser_errno_t paradox_xml1_parser_content_pieces(const paradox_xml1_input* input, paradox_uint64_t* index, paradox_xml1_document* document, paradox_xml1_parser_events* events, paradox_xml1_element* parent, paradox_xml1_parser_text* text, paradox_xml1_element** last_child, paradox_xml1_parser_validation* validation, const paradox_uint64_t stop)
 {
     paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
     const paradox_uint64_t base_index = *index;
+    const paradox_bool8_t includes = NULL != document || NULL != events;
 
-    if( PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_string_type(xml_string, index)
-    &&  PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_tokenized_type(xml_string, index)
-    &&  PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_enumerated_type(xml_string, index))
+    while(*index < stop && '\0' != paradox_xml1_peek(input, *index))
     {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
+        const paradox_uint64_t data_index = *index;
+        paradox_xml1_parser_accept(index, paradox_xml1_parser_char_data(input, *index));
+        if(data_index != *index)
+        {
+            if(PARADOX_FALSE == paradox_xml1_parser_validate_text(validation, input->data + data_index, *index - data_index))
+            {
+                result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+                goto INVALID_PARSING;
+            }
+            if(NULL != document && PARADOX_FALSE == paradox_xml1_parser_append_text(&document->arena, text, input->data + data_index, *index - data_index))
+            {
+                result = PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+                goto INVALID_PARSING;
+            }
+            if(NULL != events && PARADOX_FALSE == paradox_xml1_parser_emit(events, events->handler->char_data, input->data + data_index, *index - data_index))
+            {
+                result = PARADOX_XML1_PARSER_ABORTED;
+                goto INVALID_PARSING;
+            }
+            if(*index >= stop) break;
+        }
+
+        const paradox_uint64_t markup_index = *index;
+        if('&' == paradox_xml1_peek(input, *index))
+        {
+            // A run of references is taken in one go, up to the first reference to an entity that is included.
+            paradox_uint64_t reference_end;
+            do
+            {
+                reference_end = paradox_xml1_parser_reference(input, *index);
+                if(PARADOX_XML1_PARSER_NO_MATCH == reference_end) break;
+                if(PARADOX_TRUE == includes && PARADOX_TRUE == paradox_xml1_parser_entity_reference(input->data + *index, reference_end - *index)) break;
+                *index = reference_end;
+            }
+            while('&' == paradox_xml1_peek(input, *index));
+            if(markup_index == *index)
+            {
+                if(PARADOX_XML1_PARSER_NO_MATCH == reference_end) break;
+                result = paradox_xml1_parser_include_entity(input->data + markup_index, reference_end - markup_index, document, events, parent, text, last_child, validation);
+                if(PARADOX_XML1_PARSER_SUCCESS != result) goto INVALID_PARSING;
+                *index = reference_end;
+                continue;
+            }
+            if(PARADOX_FALSE == paradox_xml1_parser_validate_text(validation, NULL, 0))
+            {
+                result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+                goto INVALID_PARSING;
+            }
+            if(NULL != document && PARADOX_FALSE == paradox_xml1_parser_append_reference(&document->arena, text, input->data + markup_index, *index - markup_index))
+            {
+                result = PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+                goto INVALID_PARSING;
+            }
+            if(NULL != events)
+            {
+                result = paradox_xml1_parser_emit_references(events, input->data + markup_index, *index - markup_index);
+                if(PARADOX_XML1_PARSER_SUCCESS != result) goto INVALID_PARSING;
+            }
+            continue;
+        }
+        // '</', '<?', '<!-', '<![' and any other '<' select the only alternative that can match.
+        if('<' != paradox_xml1_peek(input, *index)) break;
+        const paradox_char8_t marker = paradox_xml1_peek(input, (*index) + 1);
+        if('/' == marker) break;
+        if('?' == marker || ('!' == marker && '-' == paradox_xml1_peek(input, (*index) + 2)))
+        {
+            if(!paradox_xml1_parser_accept(index, '?' == marker ? paradox_xml1_parser_pi(input, *index) : paradox_xml1_parser_comment(input, *index))) break;
+            if(PARADOX_FALSE == paradox_xml1_parser_validate_misc(validation))
+            {
+                result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+                goto INVALID_PARSING;
+            }
+            if(PARADOX_FALSE == paradox_xml1_parser_emit_markup(input, events, markup_index, *index))
+            {
+                result = PARADOX_XML1_PARSER_ABORTED;
+                goto INVALID_PARSING;
+            }
+            continue;
+        }
+        if('!' == marker)
+        {
+            if(!paradox_xml1_parser_accept(index, paradox_xml1_parser_cd_sect(input, *index))) break;
+            if(PARADOX_FALSE == paradox_xml1_parser_validate_text(validation, NULL, 0))
+            {
+                result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+                goto INVALID_PARSING;
+            }
+            // Only the CData between '<![CDATA[' and ']]>' belongs to the value.
+            if(NULL != document && PARADOX_FALSE == paradox_xml1_parser_append_literal(&document->arena, text, input->data + markup_index + 9, *index - markup_index - 12))
+            {
+                result = PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+                goto INVALID_PARSING;
+            }
+            if(NULL != events && PARADOX_FALSE == paradox_xml1_parser_emit(events, events->handler->cdata, input->data + markup_index + 9, *index - markup_index - 12))
+            {
+                result = PARADOX_XML1_PARSER_ABORTED;
+                goto INVALID_PARSING;
+            }
+            continue;
+        }
+
+        paradox_xml1_element* child = NULL;
+        result = paradox_xml1_parser_element(input, index, document, events, validation, &child);
+        if(PARADOX_XML1_PARSER_INVALID_DOCUMENT == result) break;
+        if(PARADOX_XML1_PARSER_SUCCESS != result) goto INVALID_PARSING;
+        if(NULL != child)
+        {
+            child->parent = parent;
+            if(NULL == *last_child) parent->children = child;
+            else (*last_child)->next = child;
+            *last_child = child;
+        }
     }
     result = PARADOX_XML1_PARSER_SUCCESS;
 
     INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
-    }
+    if(result != PARADOX_XML1_PARSER_SUCCESS) *index = base_index;
 
     return result;
 }
-// [55] StringType ::= 'CDATA'
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_string_type(paradox_str_t xml_string, paradox_uint64_t* index)
-{
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
-    const paradox_uint64_t base_index = *index;
-
-    if(strncmp(xml_string + *index, "CDATA", 5))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else (*index) += 5;
-    result = PARADOX_XML1_PARSER_SUCCESS;
-
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
-    }
 
+// Appends every child element to parent and gathers the text pieces into parent->value.
+static paradox_xml1_parser_errno_t paradox_xml1_parser_content(const paradox_xml1_input* input, paradox_uint64_t* index, paradox_xml1_document* document, paradox_xml1_parser_events* events, paradox_xml1_element* parent, paradox_xml1_parser_validation* validation, const paradox_uint64_t stop)
+{
+    paradox_xml1_parser_text text = { NULL, 0, NULL, 0, PARADOX_FALSE, PARADOX_FALSE };
+    paradox_xml1_element* last_child = NULL;
+    const paradox_xml1_parser_errno_t result = paradox_xml1_parser_content_pieces(input, index, document, events, parent, &text, &last_child, validation, stop);
+    if(PARADOX_XML1_PARSER_SUCCESS == result && NULL != parent) paradox_xml1_parser_set_value(parent, &text);
     return result;
 }
 
-/** [56] TokenizedType ::= 'ID' [VC: ID][VC: One ID per Element Type][VC: ID Attribute Default]
- * | 'IDREF'	[VC: IDREF]
- * | 'IDREFS'	[VC: IDREF]
- * | 'ENTITY'	[VC: Entity Name]
- * | 'ENTITIES'	[VC: Entity Name]
- * | 'NMTOKEN'	[VC: Name Token]
- * | 'NMTOKENS'	[VC: Name Token] */
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_tokenized_type(paradox_str_t xml_string, paradox_uint64_t* index)
+// [39] element ::= EmptyElemTag | STag content ETag [WFC: Element Type Match][VC: Element Valid]
+// When the parse validates, the element is checked against parent_validation, the content it is in, which is NULL
+// for the root, and its own content against its type.
+static paradox_xml1_parser_errno_t paradox_xml1_parser_element(const paradox_xml1_input* input, paradox_uint64_t* index, paradox_xml1_document* document, paradox_xml1_parser_events* events, paradox_xml1_parser_validation* parent_validation, paradox_xml1_element** element)
 {
     paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
     const paradox_uint64_t base_index = *index;
+    const paradox_uint64_t name_index = base_index + 1;
+    paradox_uint64_t name_length = 0;
+    paradox_xml1_element* created = NULL;
+    const paradox_xml1_entity_table* entities = NULL != document ? document->entities : NULL != events ? events->entities : NULL;
+    paradox_xml1_parser_validation validation = { NULL, NULL, 0 };
 
-    if(!strncmp(xml_string + *index, "ID", 2)) (*index) += 2;
-    else if(!strncmp(xml_string + *index, "IDREF", 5)) (*index) += 5;
-    else if(!strncmp(xml_string + *index, "IDREFS", 6)) (*index) += 6;
-    else if(!strncmp(xml_string + *index, "ENTITY", 6)) (*index) += 6;
-    else if(!strncmp(xml_string + *index, "ENTITIES", 8)) (*index) += 8;
-    else if(!strncmp(xml_string + *index, "NMTOKEN", 7)) (*index) += 7;
-    else if(!strncmp(xml_string + *index, "NMTOKENS", 8)) (*index) += 8;
-    else
+    result = paradox_xml1_parser_tag(input, index, document, events, &created, &name_length);
+    if(PARADOX_XML1_PARSER_SUCCESS != result) goto INVALID_PARSING;
+    if(NULL != entities && NULL != entities->elements)
     {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
+        result = paradox_xml1_parser_validate_element(entities, parent_validation, input->data + name_index, name_length, &validation);
+        if(PARADOX_XML1_PARSER_SUCCESS != result) goto INVALID_PARSING;
     }
-    result = PARADOX_XML1_PARSER_SUCCESS;
-
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
+    if(!paradox_xml1_compare(input, *index, "/>", 2)) (*index) += 2;
+    else if('>' == paradox_xml1_peek(input, *index))
     {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
-    }
-    
-    return result;
-}
-
-// Enumerated Attribute Types
+        (*index)++;
+        result = paradox_xml1_parser_content(input, index, document, events, created, NULL != validation.elements ? &validation : NULL, input->length);
+        if(PARADOX_XML1_PARSER_SUCCESS != result) goto INVALID_PARSING;
 
-// [57] EnumeratedType ::= NotationType | Enumeration
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_enumerated_type(paradox_str_t xml_string, paradox_uint64_t* index)
-{
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
+        // [WFC: Element Type Match]
+        const paradox_uint64_t end_name_index = (*index) + 2;
+        if(!paradox_xml1_parser_accept(index, paradox_xml1_parser_e_tag(input, *index)))
+        {
+            result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+            goto INVALID_PARSING;
+        }
+        if(PARADOX_FALSE == paradox_xml1_parser_end_tag_matches(input, end_name_index, input->data + name_index, name_length))
+        {
+            result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+            goto INVALID_PARSING;
+        }
+    }
+    else
     {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
+        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
         goto INVALID_PARSING;
     }
-    else if(NULL == index)
+    if(NULL != validation.elements && PARADOX_FALSE == paradox_xml1_parser_validate_end(&validation))
     {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
+        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
         goto INVALID_PARSING;
     }
-    const paradox_uint64_t base_index = *index;
-
-    if( PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_notation_type(xml_string, index)
-    &&  PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_enumeration(xml_string, index))
+    if(NULL != events && PARADOX_FALSE == paradox_xml1_parser_emit(events, events->handler->end_element, input->data + name_index, name_length))
     {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+        result = PARADOX_XML1_PARSER_ABORTED;
         goto INVALID_PARSING;
     }
+    if(NULL != element) *element = created;
     result = PARADOX_XML1_PARSER_SUCCESS;
 
     INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
-    }
+    if(result != PARADOX_XML1_PARSER_SUCCESS) *index = base_index;
 
     return result;
 }
-// [58] NotationType ::= 'NOTATION' S '(' S? Name (S? '|' S? Name)* S? ')' [VC: Notation Attributes][VC: One Notation Per Element Type][VC: No Notation on Empty Element][VC: No Duplicate Tokens]
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_notation_type(paradox_str_t xml_string, paradox_uint64_t* index)
+
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_element(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    const paradox_xml1_input input = { xml_string, PARADOX_XML1_INPUT_UNBOUNDED, PARADOX_FALSE };
+    if(NULL == xml_string) return PARADOX_XML1_PARSER_NULL_DOCUMENT;
+    if(NULL == index) return PARADOX_XML1_PARSER_NULL_INDEX;
+    return paradox_xml1_parser_element(&input, index, NULL, NULL, NULL, NULL);
+}
+
+// Start-tag
+
+// [40] STag ::= '<' Name (S Attribute)* S? '>' [WFC: Unique Att Spec]
+static inline paradox_uint64_t paradox_xml1_parser_s_tag(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if(PARADOX_XML1_PARSER_SUCCESS != paradox_xml1_parser_tag(input, &index, NULL, NULL, NULL, NULL)) return PARADOX_XML1_PARSER_NO_MATCH;
+    if('>' != paradox_xml1_peek(input, index)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index++;
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_s_tag(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_s_tag);
+}
+// [41] Attribute ::= Name Eq AttValue [VC: Attribute Value Type][WFC: No External Entity References][WFC: No < in Attribute Values]
+static paradox_xml1_parser_errno_t paradox_xml1_parser_attribute(const paradox_xml1_input* input, paradox_uint64_t* index, paradox_xml1_document* document, paradox_xml1_attribute** attribute, paradox_xml1_slice* name, paradox_xml1_slice* value)
 {
     paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
     const paradox_uint64_t base_index = *index;
 
-    if(strncmp(xml_string + *index, "NOTATION", 8))
+    const paradox_uint64_t name_index = *index;
+    if(!paradox_xml1_parser_accept(index, paradox_xml1_parser_name(input, *index)))
     {
         result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
         goto INVALID_PARSING;
     }
-    else (*index) += 8;
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_space(xml_string, index))
+    const paradox_uint64_t name_length = *index - name_index;
+    if(!paradox_xml1_parser_accept(index, paradox_xml1_parser_eq(input, *index)))
     {
         result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
         goto INVALID_PARSING;
     }
-    if('(' != xml_string[*index])
+    const paradox_uint64_t value_index = *index;
+    if(!paradox_xml1_parser_accept(index, paradox_xml1_parser_att_value(input, *index)))
     {
         result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
         goto INVALID_PARSING;
     }
-    else (*index)++;
-    paradox_parse_xml1_space(xml_string, index);
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_name(xml_string, index))
+    if(NULL != document)
     {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
+        const paradox_xml1_slice tag = { input->data + name_index, name_length };
+        const paradox_xml1_slice quoted = { input->data + value_index + 1, *index - value_index - 2 };
+        paradox_xml1_attribute* created = NULL;
+        result = paradox_xml1_parser_create_attribute(document, tag, quoted, NULL != memchr(quoted.data, '&', quoted.length), &created);
+        if(PARADOX_XML1_PARSER_SUCCESS != result) goto INVALID_PARSING;
+        if(NULL != attribute) *attribute = created;
     }
-    while('\0' != xml_string[*index])
+    if(NULL != name)
     {
-        const paradox_uint64_t last_index = *index;
-        paradox_parse_xml1_space(xml_string, index);
-        if('|' != xml_string[*index])
-        {
-            *index = last_index;
-            break;
-        }
-        else (*index)++;
-        paradox_parse_xml1_space(xml_string, index);
-        if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_name(xml_string, index))
-        {
-            *index = last_index;
-            break;
-        }
+        name->data = input->data + name_index;
+        name->length = name_length;
     }
-    paradox_parse_xml1_space(xml_string, index);
-    if(')' != xml_string[*index])
+    if(NULL != value)
     {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
+        value->data = input->data + value_index + 1;
+        value->length = *index - value_index - 2;
     }
-    else (*index)++;
     result = PARADOX_XML1_PARSER_SUCCESS;
 
     INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
-    }
-    
+    if(result != PARADOX_XML1_PARSER_SUCCESS) *index = base_index;
+
     return result;
 }
-// [59] Enumeration ::= '(' S? Nmtoken (S? '|' S? Nmtoken)* S? ')' [VC: Enumeration][VC: No Duplicate Tokens]
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_enumeration(paradox_str_t xml_string, paradox_uint64_t* index)
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_attribute(paradox_str_t xml_string, paradox_uint64_t* index)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
-    const paradox_uint64_t base_index = *index;
+    const paradox_xml1_input input = { xml_string, PARADOX_XML1_INPUT_UNBOUNDED, PARADOX_FALSE };
+    if(NULL == xml_string) return PARADOX_XML1_PARSER_NULL_DOCUMENT;
+    if(NULL == index) return PARADOX_XML1_PARSER_NULL_INDEX;
+    return paradox_xml1_parser_attribute(&input, index, NULL, NULL, NULL, NULL);
+}
 
-    if('(' != xml_string[*index])
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else (*index)++;
-    paradox_parse_xml1_space(xml_string, index);
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_nm_token(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    while('\0' != xml_string[*index])
-    {
-        const paradox_uint64_t last_index = *index;
-        paradox_parse_xml1_space(xml_string, index);
-        if('|' != xml_string[*index])
-        {
-            *index = last_index;
-            break;
-        }
-        else (*index)++;
-        paradox_parse_xml1_space(xml_string, index);
-        if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_nm_token(xml_string, index))
-        {
-            *index = last_index;
-            break;
-        }
-    }
-    paradox_parse_xml1_space(xml_string, index);
-    if(')' != xml_string[*index])
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else (*index)++;
-    result = PARADOX_XML1_PARSER_SUCCESS;
+// End-tag
 
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
-    }
-    
-    return result;
+// [42] ETag ::= '</' Name S? '>'
+static inline paradox_uint64_t paradox_xml1_parser_e_tag(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if(paradox_xml1_compare(input, index, "</", 2)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index += 2;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_name(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+    if('>' != paradox_xml1_peek(input, index)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index++;
+    return index;
 }
-
-// Attribute Defaults
-
-// [60] DefaultDecl ::= '#REQUIRED' | '#IMPLIED' | (('#FIXED' S)? AttValue) [VC: Required Attribute][VC: Attribute Default Value Syntactically Correct][WFC: No < in Attribute Values][VC: Fixed Attribute Default][WFC: No External Entity References]
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_default_decl(paradox_str_t xml_string, paradox_uint64_t* index)
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_e_tag(paradox_str_t xml_string, paradox_uint64_t* index)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
-    const paradox_uint64_t base_index = *index;
-
-    if(!strncmp(xml_string, "#REQUIRED", 9)) (*index) += 9;
-    else if(!strncmp(xml_string, "#IMPLIED", 8)) (*index) += 8;
-    else
-    {
-        if(!strncmp(xml_string, "#FIXED", 6))
-        {
-            (*index) += 6;
-            if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_space(xml_string, index))
-                (*index) = base_index;
-        }
-        if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_att_value(xml_string, index))
-        {
-            result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-            goto INVALID_PARSING;
-        }
-    }
-    result = PARADOX_XML1_PARSER_SUCCESS;
-
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
-    }
-
-    return result;
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_e_tag);
 }
 
-// Conditional Section
-
-// [61] conditionalSect ::= includeSect | ignoreSect
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_conditional_sect(paradox_str_t xml_string, paradox_uint64_t* index)
+// [43] content ::= CharData? ((element | Reference | CDSect | PI | Comment) CharData?)*
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_content(paradox_str_t xml_string, paradox_uint64_t* index)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
-    const paradox_uint64_t base_index = *index;
-
-    if( PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_include_sect(xml_string, index)
-    &&  PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_ignore_sect(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    result = PARADOX_XML1_PARSER_SUCCESS;
+    const paradox_xml1_input input = { xml_string, PARADOX_XML1_INPUT_UNBOUNDED, PARADOX_FALSE };
+    if(NULL == xml_string) return PARADOX_XML1_PARSER_NULL_DOCUMENT;
+    if(NULL == index) return PARADOX_XML1_PARSER_NULL_INDEX;
+    return paradox_xml1_parser_content(&input, index, NULL, NULL, NULL, NULL, input.length);
+}
 
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
-    }
+// Tags for Empty Elements
 
-    return result;
+// [44] EmptyElemTag ::= '<' Name (S Attribute)* S? '/>' [WFC: Unique Att Spec]
+static inline paradox_uint64_t paradox_xml1_parser_empty_elem_tag(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if(PARADOX_XML1_PARSER_SUCCESS != paradox_xml1_parser_tag(input, &index, NULL, NULL, NULL, NULL)) return PARADOX_XML1_PARSER_NO_MATCH;
+    if(paradox_xml1_compare(input, index, "/>", 2)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index += 2;
+    return index;
 }
-// [62] includeSect ::= '<![' S? 'INCLUDE' S? '[' extSubsetDecl ']]>' [VC: Proper Conditional Section/PE Nesting]
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_include_sect(paradox_str_t xml_string, paradox_uint64_t* index)
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_empty_elem_tag(paradox_str_t xml_string, paradox_uint64_t* index)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
-    const paradox_uint64_t base_index = *index;
-
-    if(strncmp(xml_string + *index, "<![", 3))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else (*index) += 3;
-    paradox_parse_xml1_space(xml_string, index);
-    if(strncmp(xml_string + *index, "INCLUDE", 7))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else (*index) += 7;
-    paradox_parse_xml1_space(xml_string, index);
-    if('[' != xml_string[*index])
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else (*index)++;
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_ext_subset_decl(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    if(strncmp(xml_string + *index, "]]>", 3))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else (*index) += 3;
-    result = PARADOX_XML1_PARSER_SUCCESS;
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_empty_elem_tag);
+}
 
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
-    }
+// Element Type Declaration
 
-    return result;
+// [45] elementdecl ::= '<!ELEMENT' S Name S contentspec S? '>' [VC: Unique Element Type Declaration]
+static inline paradox_uint64_t paradox_xml1_parser_elementdecl(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if(paradox_xml1_compare(input, index, "<!ELEMENT", 9)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index += 9;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_name(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_contentspec(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+    if('>' != paradox_xml1_peek(input, index)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index++;
+    return index;
 }
-// [63] ignoreSect ::= '<![' S? 'IGNORE' S? '[' ignoreSectContents* ']]>' [VC: Proper Conditional Section/PE Nesting]
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_ignore_sect(paradox_str_t xml_string, paradox_uint64_t* index)
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_elementdecl(paradox_str_t xml_string, paradox_uint64_t* index)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
-    const paradox_uint64_t base_index = *index;
-
-    if(strncmp(xml_string + *index, "<![", 3))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else (*index) += 3;
-    paradox_parse_xml1_space(xml_string, index);
-    if(strncmp(xml_string + *index, "IGNORE", 6))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else (*index) += 6;
-    paradox_parse_xml1_space(xml_string, index);
-    if('[' != xml_string[*index])
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else (*index)++;
-    while(PARADOX_XML1_PARSER_SUCCESS == paradox_parse_xml1_ignore_sect_contents(xml_string, index));
-    if(strncmp(xml_string + *index, "]]>", 3))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else (*index) += 3;
-    result = PARADOX_XML1_PARSER_SUCCESS;
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_elementdecl);
+}
+// [46] contentspec ::= 'EMPTY' | 'ANY' | Mixed | children
+static inline paradox_uint64_t paradox_xml1_parser_contentspec(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if(!paradox_xml1_compare(input, index, "EMPTY", 5)) return index + 5;
+    if(!paradox_xml1_compare(input, index, "ANY", 3)) return index + 3;
+    // Mixed and children both open with '(', only Mixed goes on with '#PCDATA'.
+    if(paradox_xml1_parser_accept(&index, paradox_xml1_parser_mixed(input, index))) return index;
+    return paradox_xml1_parser_children(input, index);
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_contentspec(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_contentspec);
+}
 
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
-    }
+// Element-content Models
 
-    return result;
-}
-// [64] ignoreSectContents ::= Ignore ('<![' ignoreSectContents ']]>' Ignore)*
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_ignore_sect_contents(paradox_str_t xml_string, paradox_uint64_t* index)
+// [47] children ::= (choice | seq) ('?' | '*' | '+')?
+static inline paradox_uint64_t paradox_xml1_parser_children(const paradox_xml1_input* input, paradox_uint64_t index)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
+    if( !paradox_xml1_parser_accept(&index, paradox_xml1_parser_choice(input, index))
+    &&  !paradox_xml1_parser_accept(&index, paradox_xml1_parser_seq(input, index)))
     {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
+        return PARADOX_XML1_PARSER_NO_MATCH;
     }
-    else if(NULL == index)
+    switch(paradox_xml1_peek(input, index))
     {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
+    case '?':
+    case '*':
+    case '+':
+        index++;
+        break;
+    default: break;
     }
-    const paradox_uint64_t base_index = *index;
-
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_ignore(xml_string, index))
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_children(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_children);
+}
+// [48] cp ::= (Name | choice | seq) ('?' | '*' | '+')?
+static inline paradox_uint64_t paradox_xml1_parser_cp(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if( !paradox_xml1_parser_accept(&index, paradox_xml1_parser_name(input, index))
+    &&  !paradox_xml1_parser_accept(&index, paradox_xml1_parser_choice(input, index))
+    &&  !paradox_xml1_parser_accept(&index, paradox_xml1_parser_seq(input, index)))
     {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
+        return PARADOX_XML1_PARSER_NO_MATCH;
     }
-    while('\0' != xml_string[*index])
+    switch(paradox_xml1_peek(input, index))
     {
-        paradox_uint64_t next_index = *index;
-        if(strncmp(xml_string + next_index, "<![", 3)) break;
-        next_index += 3;
-        if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_ignore_sect_contents(xml_string, &next_index)) break;
-        if(strncmp(xml_string + next_index, "]]>", 3)) break;
-        next_index += 3;
-        if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_ignore(xml_string, &next_index)) break;
-        *index = next_index;
+    case '?':
+    case '*':
+    case '+':
+        index++;
+        break;
+    default: break;
     }
-    result = PARADOX_XML1_PARSER_SUCCESS;
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_cp(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_cp);
+}
+// [49] choice ::= '(' S? cp ( S? '|' S? cp )+ S? ')' [VC: Proper Group/PE Nesting]
+static inline paradox_uint64_t paradox_xml1_parser_choice(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if('(' != paradox_xml1_peek(input, index)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index++;
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_cp(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    paradox_uint64_t alternatives = 0;
+    for(;; alternatives++)
+    {
+        paradox_uint64_t next = index;
+        paradox_xml1_parser_accept(&next, paradox_xml1_parser_space(input, next));
+        if('|' != paradox_xml1_peek(input, next)) break;
+        else next++;
+        paradox_xml1_parser_accept(&next, paradox_xml1_parser_space(input, next));
+        if(!paradox_xml1_parser_accept(&next, paradox_xml1_parser_cp(input, next))) return PARADOX_XML1_PARSER_NO_MATCH;
+        index = next;
+    }
+    if(0 == alternatives) return PARADOX_XML1_PARSER_NO_MATCH;
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+    if(')' != paradox_xml1_peek(input, index)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index++;
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_choice(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_choice);
+}
+// [50] seq ::= '(' S? cp ( S? ',' S? cp )* S? ')' [VC: Proper Group/PE Nesting]
+static inline paradox_uint64_t paradox_xml1_parser_seq(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if('(' != paradox_xml1_peek(input, index)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index++;
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_cp(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    for(;;)
+    {
+        paradox_uint64_t next = index;
+        paradox_xml1_parser_accept(&next, paradox_xml1_parser_space(input, next));
+        if(',' != paradox_xml1_peek(input, next)) break;
+        else next++;
+        paradox_xml1_parser_accept(&next, paradox_xml1_parser_space(input, next));
+        if(!paradox_xml1_parser_accept(&next, paradox_xml1_parser_cp(input, next))) return PARADOX_XML1_PARSER_NO_MATCH;
+        index = next;
+    }
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+    if(')' != paradox_xml1_peek(input, index)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index++;
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_seq(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_seq);
+}
 
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
-    }
+// Mixed-content Declaration
 
-    return result;
+// [51] Mixed ::= '(' S? '#PCDATA' (S? '|' S? Name)* S? ')*' | '(' S? '#PCDATA' S? ')' [VC: Proper Group/PE Nesting][VC: No Duplicate Types]
+static inline paradox_uint64_t paradox_xml1_parser_mixed(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if('(' != paradox_xml1_peek(input, index)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index++;
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+    if(paradox_xml1_compare(input, index, "#PCDATA", 7)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index += 7;
+    paradox_uint64_t names = 0;
+    for(;; names++)
+    {
+        paradox_uint64_t next = index;
+        paradox_xml1_parser_accept(&next, paradox_xml1_parser_space(input, next));
+        if('|' != paradox_xml1_peek(input, next)) break;
+        else next++;
+        paradox_xml1_parser_accept(&next, paradox_xml1_parser_space(input, next));
+        if(!paradox_xml1_parser_accept(&next, paradox_xml1_parser_name(input, next))) return PARADOX_XML1_PARSER_NO_MATCH;
+        index = next;
+    }
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+    // Only '#PCDATA' on its own may close without the '*'.
+    if(!paradox_xml1_compare(input, index, ")*", 2)) return index + 2;
+    if(0 == names && ')' == paradox_xml1_peek(input, index)) return index + 1;
+    return PARADOX_XML1_PARSER_NO_MATCH;
 }
-// [65] Ignore ::= Char* - (Char* ('<![' | ']]>') Char*)
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_ignore(paradox_str_t xml_string, paradox_uint64_t* index)
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_mixed(paradox_str_t xml_string, paradox_uint64_t* index)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
-    const paradox_uint64_t base_index = *index;
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_mixed);
+}
 
-    while('\0' != xml_string[*index])
-    {
-        if(PARADOX_FALSE == paradox_is_xml1_char(xml_string, *index)) break;
-        if(!strncmp(xml_string + *index, "<![", 3)) break;
-        if(!strncmp(xml_string + *index, "]]>", 3)) break;
-        paradox_xml1_parser_next_index(xml_string, index);
-    }
-    result = PARADOX_XML1_PARSER_SUCCESS;
+// Attribute-list Declaration
 
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
-    }
-    
-    return result;
+// [52] AttlistDecl ::= '<!ATTLIST' S Name AttDef* S? '>'
+static inline paradox_uint64_t paradox_xml1_parser_attlist_decl(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if(paradox_xml1_compare(input, index, "<!ATTLIST", 9))
+    {
+        return PARADOX_XML1_PARSER_NO_MATCH;
+    } else index += 9;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_name(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    while(paradox_xml1_parser_accept(&index, paradox_xml1_parser_att_def(input, index)));
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+    if('>' != paradox_xml1_peek(input, index))
+    {
+        return PARADOX_XML1_PARSER_NO_MATCH;
+    } else index++;
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_attlist_decl(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_attlist_decl);
+}
+// [53] AttDef ::= S Name S AttType S DefaultDecl
+static inline paradox_uint64_t paradox_xml1_parser_att_def(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_name(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_att_type(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_default_decl(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_att_def(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_att_def);
 }
 
-// Character Reference
+// Attribute Types
 
-// [66] CharRef ::= '&#' [0-9]+ ';' | '&#x' [0-9a-fA-F]+ ';' [WFC: Legal Character]
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_char_ref(paradox_str_t xml_string, paradox_uint64_t* index)
+// [54] AttType ::= StringType | TokenizedType | EnumeratedType
+static inline paradox_uint64_t paradox_xml1_parser_att_type(const paradox_xml1_input* input, paradox_uint64_t index)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
-    const paradox_uint64_t base_index = *index;
-
-    if(!strncmp(xml_string + *index, "&#x", 3))
-    {
-        (*index) += 3;
-        paradox_bool8_t found = PARADOX_FALSE;
-        while('\0' != xml_string[*index])
-        {
-            if(paradox_char8_ishex(xml_string[*index]))
-            {
-                found = PARADOX_TRUE;
-                (*index)++;
-            }
-            else break;
-        }
-        if(PARADOX_FALSE == found)
-        {
-            result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-            goto INVALID_PARSING;
-        }
-    }
-    else if(!strncmp(xml_string + *index, "&#", 2))
-    {
-        (*index) += 2;
-        paradox_bool8_t found = PARADOX_FALSE;
-        while('\0' != xml_string[*index])
-        {
-            if(paradox_char8_isdigit(xml_string[*index]))
-            {
-                found = PARADOX_TRUE;
-                (*index)++;
-            }
-            else break;
-        }
-        if(PARADOX_FALSE == found)
-        {
-            result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-            goto INVALID_PARSING;
-        }
-    }
-    else
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    if(';' != xml_string[*index])
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else (*index)++;
-    result = PARADOX_XML1_PARSER_SUCCESS;
-
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
-    }
-
-    return result;
+    // 'CDATA', the tokenized types and the enumerated types, which start with 'NOTATION' or '(', differ in their first byte.
+    const paradox_char8_t first = paradox_xml1_peek(input, index);
+    if('C' == first) return paradox_xml1_parser_string_type(input, index);
+    if('(' == first || ('N' == first && 'O' == paradox_xml1_peek(input, index + 1))) return paradox_xml1_parser_enumerated_type(input, index);
+    return paradox_xml1_parser_tokenized_type(input, index);
 }
-
-// Entity Reference
-
-// [67] Reference ::= EntityRef | CharRef
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_reference(paradox_str_t xml_string, paradox_uint64_t* index)
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_att_type(paradox_str_t xml_string, paradox_uint64_t* index)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
-    const paradox_uint64_t base_index = *index;
-
-    if( PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_entity_ref(xml_string, index)
-    &&  PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_char_ref(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    result = PARADOX_XML1_PARSER_SUCCESS;
-
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
-    }
-
-    return result;
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_att_type);
 }
-// [68] EntityRef ::= '&' Name ';' [WFC: Entity Declared][VC: Entity Declared][WFC: Parsed Entity][WFC: No Recursion]
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_entity_ref(paradox_str_t xml_string, paradox_uint64_t* index)
+// [55] StringType ::= 'CDATA'
+static inline paradox_uint64_t paradox_xml1_parser_string_type(const paradox_xml1_input* input, paradox_uint64_t index)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
-    const paradox_uint64_t base_index = *index;
-
-    if('&' != xml_string[*index])
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else (*index)++;
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_name(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    if(';' != xml_string[*index])
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else (*index)++;
-    result = PARADOX_XML1_PARSER_SUCCESS;
-
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
-    }
-
-    return result;
+    if(paradox_xml1_compare(input, index, "CDATA", 5)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index += 5;
+    return index;
 }
-// [69] PEReference ::= '%' Name ';' [VC: Entity Declared][WFC: No Recursion][WFC: In DTD]
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_pe_reference(paradox_str_t xml_string, paradox_uint64_t* index)
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_string_type(paradox_str_t xml_string, paradox_uint64_t* index)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
-    const paradox_uint64_t base_index = *index;
-
-    if('%' != xml_string[*index])
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else (*index)++;
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_name(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    if(';' != xml_string[*index])
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else (*index)++;
-    result = PARADOX_XML1_PARSER_SUCCESS;
-
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
-    }
-
-    return result;
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_string_type);
 }
 
-// Entity Declaration
-
-// [70] EntityDecl ::= GEDecl | PEDecl
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_entity_decl(paradox_str_t xml_string, paradox_uint64_t* index)
-{
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
-    const paradox_uint64_t base_index = *index;
-
-    if( PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_ge_decl(xml_string, index)
-    &&  PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_pe_decl(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    result = PARADOX_XML1_PARSER_SUCCESS;
-
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
-    }
-
-    return result;
-}
-// [71] GEDecl ::= '<!ENTITY' S Name S EntityDef S? '>'
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_ge_decl(paradox_str_t xml_string, paradox_uint64_t* index)
+/** [56] TokenizedType ::= 'ID' [VC: ID][VC: One ID per Element Type][VC: ID Attribute Default]
+ * | 'IDREF'	[VC: IDREF]
+ * | 'IDREFS'	[VC: IDREF]
+ * | 'ENTITY'	[VC: Entity Name]
+ * | 'ENTITIES'	[VC: Entity Name]
+ * | 'NMTOKEN'	[VC: Name Token]
+ * | 'NMTOKENS'	[VC: Name Token] */
+static inline paradox_uint64_t paradox_xml1_parser_tokenized_type(const paradox_xml1_input* input, paradox_uint64_t index)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
-    const paradox_uint64_t base_index = *index;
-
-    if(strncmp(xml_string + *index, "<!ENTITY", 8))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else (*index) += 8;
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_space(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_name(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_space(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_entity_def(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    paradox_parse_xml1_space(xml_string, index);
-    if('>' != xml_string[*index])
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else (*index)++;
-    result = PARADOX_XML1_PARSER_SUCCESS;
-
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
-    }
-
-    return result;
+    // Longer keywords first, each of the shorter ones is a prefix of the next.
+    if(!paradox_xml1_compare(input, index, "IDREFS", 6)) index += 6;
+    else if(!paradox_xml1_compare(input, index, "IDREF", 5)) index += 5;
+    else if(!paradox_xml1_compare(input, index, "ID", 2)) index += 2;
+    else if(!paradox_xml1_compare(input, index, "ENTITIES", 8)) index += 8;
+    else if(!paradox_xml1_compare(input, index, "ENTITY", 6)) index += 6;
+    else if(!paradox_xml1_compare(input, index, "NMTOKENS", 8)) index += 8;
+    else if(!paradox_xml1_compare(input, index, "NMTOKEN", 7)) index += 7;
+    else return PARADOX_XML1_PARSER_NO_MATCH;
+    return index;
 }
-// [72] PEDecl ::= '<!ENTITY' S '%' S Name S PEDef S? '>'
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_pe_decl(paradox_str_t xml_string, paradox_uint64_t* index)
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_tokenized_type(paradox_str_t xml_string, paradox_uint64_t* index)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
-    const paradox_uint64_t base_index = *index;
-
-    if(strncmp(xml_string + *index, "<!ENTITY", 8))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else (*index) += 8;
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_space(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    if('%' != xml_string[*index])
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else (*index)++;
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_space(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_name(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_space(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_pe_def(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    paradox_parse_xml1_space(xml_string, index);
-    if('>' != xml_string[*index])
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else (*index)++;
-    result = PARADOX_XML1_PARSER_SUCCESS;
-
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
-    }
-
-    return result;
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_tokenized_type);
 }
-// [73] EntityDef ::= EntityValue | (ExternalID NDataDecl?)
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_entity_def(paradox_str_t xml_string, paradox_uint64_t* index)
-{
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
-    const paradox_uint64_t base_index = *index;
-
-    if(PARADOX_XML1_PARSER_SUCCESS == paradox_parse_xml1_entity_value(xml_string, index)) {}
-    else if(PARADOX_XML1_PARSER_SUCCESS == paradox_parse_xml1_external_id(xml_string, index))
-    {
-        paradox_parse_xml1_ndata_decl(xml_string, index);
-    }
-    else
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    result = PARADOX_XML1_PARSER_SUCCESS;
 
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
-    }
+// Enumerated Attribute Types
 
-    return result;
-}
-// [74] PEDef ::= EntityValue | ExternalID
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_pe_def(paradox_str_t xml_string, paradox_uint64_t* index)
+// [57] EnumeratedType ::= NotationType | Enumeration
+static inline paradox_uint64_t paradox_xml1_parser_enumerated_type(const paradox_xml1_input* input, paradox_uint64_t index)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
-    const paradox_uint64_t base_index = *index;
-
-    if( PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_entity_value(xml_string, index)
-    &&  PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_external_id(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    result = PARADOX_XML1_PARSER_SUCCESS;
-
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
-    }
-
-    return result;
+    if('(' == paradox_xml1_peek(input, index)) return paradox_xml1_parser_enumeration(input, index);
+    return paradox_xml1_parser_notation_type(input, index);
 }
-
-// External Entity Declaration
-
-// [75] ExternalID ::= 'SYSTEM' S SystemLiteral | 'PUBLIC' S PubidLiteral S SystemLiteral
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_external_id(paradox_str_t xml_string, paradox_uint64_t* index)
-{
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
-    const paradox_uint64_t base_index = *index;
-
-    if(!strncmp(xml_string + *index, "SYSTEM", 6))
-    {
-        (*index) += 6;
-        if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_space(xml_string, index))
-        {
-            result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-            goto INVALID_PARSING;
-        }
-        if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_system_literal(xml_string, index))
-        {
-            result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-            goto INVALID_PARSING;
-        }
-    }
-    else if(!strncmp(xml_string + *index, "PUBLIC", 6))
-    {
-        (*index) += 6;
-        if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_space(xml_string, index))
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_enumerated_type(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_enumerated_type);
+}
+// [58] NotationType ::= 'NOTATION' S '(' S? Name (S? '|' S? Name)* S? ')' [VC: Notation Attributes][VC: One Notation Per Element Type][VC: No Notation on Empty Element][VC: No Duplicate Tokens]
+static inline paradox_uint64_t paradox_xml1_parser_notation_type(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if(paradox_xml1_compare(input, index, "NOTATION", 8)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index += 8;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    if('(' != paradox_xml1_peek(input, index)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index++;
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_name(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    while('\0' != paradox_xml1_peek(input, index))
+    {
+        const paradox_uint64_t last_index = index;
+        paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+        if('|' != paradox_xml1_peek(input, index))
         {
-            result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-            goto INVALID_PARSING;
+            index = last_index;
+            break;
         }
-        if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_pubid_literal(xml_string, index))
+        else index++;
+        paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+        if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_name(input, index)))
         {
-            result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-            goto INVALID_PARSING;
+            index = last_index;
+            break;
         }
-        if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_space(xml_string, index))
+    }
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+    if(')' != paradox_xml1_peek(input, index)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index++;
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_notation_type(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_notation_type);
+}
+// [59] Enumeration ::= '(' S? Nmtoken (S? '|' S? Nmtoken)* S? ')' [VC: Enumeration][VC: No Duplicate Tokens]
+static inline paradox_uint64_t paradox_xml1_parser_enumeration(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if('(' != paradox_xml1_peek(input, index)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index++;
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_nm_token(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    while('\0' != paradox_xml1_peek(input, index))
+    {
+        const paradox_uint64_t last_index = index;
+        paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+        if('|' != paradox_xml1_peek(input, index))
         {
-            result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-            goto INVALID_PARSING;
+            index = last_index;
+            break;
         }
-        if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_system_literal(xml_string, index))
+        else index++;
+        paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+        if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_nm_token(input, index)))
         {
-            result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-            goto INVALID_PARSING;
+            index = last_index;
+            break;
         }
     }
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+    if(')' != paradox_xml1_peek(input, index)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index++;
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_enumeration(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_enumeration);
+}
+
+// Attribute Defaults
+
+// [60] DefaultDecl ::= '#REQUIRED' | '#IMPLIED' | (('#FIXED' S)? AttValue) [VC: Required Attribute][VC: Attribute Default Value Syntactically Correct][WFC: No < in Attribute Values][VC: Fixed Attribute Default][WFC: No External Entity References]
+static inline paradox_uint64_t paradox_xml1_parser_default_decl(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    const paradox_uint64_t base_index = index;
+    if(!paradox_xml1_compare(input, index, "#REQUIRED", 9)) index += 9;
+    else if(!paradox_xml1_compare(input, index, "#IMPLIED", 8)) index += 8;
     else
     {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
+        if(!paradox_xml1_compare(input, index, "#FIXED", 6))
+        {
+            index += 6;
+            if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index)))
+                index = base_index;
+        }
+        if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_att_value(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
     }
-    result = PARADOX_XML1_PARSER_SUCCESS;
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_default_decl(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_default_decl);
+}
 
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
+// Conditional Section
+
+// [61] conditionalSect ::= includeSect | ignoreSect
+static inline paradox_uint64_t paradox_xml1_parser_conditional_sect(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if( !paradox_xml1_parser_accept(&index, paradox_xml1_parser_include_sect(input, index))
+    &&  !paradox_xml1_parser_accept(&index, paradox_xml1_parser_ignore_sect(input, index)))
     {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
+        return PARADOX_XML1_PARSER_NO_MATCH;
     }
-
-    return result;
+    return index;
 }
-// [76] NDataDecl ::= S 'NDATA' S Name [VC: Notation Declared]
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_ndata_decl(paradox_str_t xml_string, paradox_uint64_t* index)
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_conditional_sect(paradox_str_t xml_string, paradox_uint64_t* index)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_conditional_sect);
+}
+// [62] includeSect ::= '<![' S? 'INCLUDE' S? '[' extSubsetDecl ']]>' [VC: Proper Conditional Section/PE Nesting]
+static inline paradox_uint64_t paradox_xml1_parser_include_sect(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if(paradox_xml1_compare(input, index, "<![", 3)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index += 3;
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+    if(paradox_xml1_compare(input, index, "INCLUDE", 7)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index += 7;
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+    if('[' != paradox_xml1_peek(input, index)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index++;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_ext_subset_decl(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    if(paradox_xml1_compare(input, index, "]]>", 3)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index += 3;
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_include_sect(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_include_sect);
+}
+// [63] ignoreSect ::= '<![' S? 'IGNORE' S? '[' ignoreSectContents* ']]>' [VC: Proper Conditional Section/PE Nesting]
+static inline paradox_uint64_t paradox_xml1_parser_ignore_sect(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if(paradox_xml1_compare(input, index, "<![", 3)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index += 3;
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+    if(paradox_xml1_compare(input, index, "IGNORE", 6)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index += 6;
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+    if('[' != paradox_xml1_peek(input, index)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index++;
+    // ignoreSectContents matches the empty string and takes all contents that follow each other at once, so
+    // ignoreSectContents* is a single one of them.
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_ignore_sect_contents(input, index));
+    if(paradox_xml1_compare(input, index, "]]>", 3)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index += 3;
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_ignore_sect(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_ignore_sect);
+}
+// [64] ignoreSectContents ::= Ignore ('<![' ignoreSectContents ']]>' Ignore)*
+static inline paradox_uint64_t paradox_xml1_parser_ignore_sect_contents(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_ignore(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    while('\0' != paradox_xml1_peek(input, index))
     {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
+        paradox_uint64_t next_index = index;
+        if(paradox_xml1_compare(input, next_index, "<![", 3)) break;
+        next_index += 3;
+        if(!paradox_xml1_parser_accept(&next_index, paradox_xml1_parser_ignore_sect_contents(input, next_index))) break;
+        if(paradox_xml1_compare(input, next_index, "]]>", 3)) break;
+        next_index += 3;
+        if(!paradox_xml1_parser_accept(&next_index, paradox_xml1_parser_ignore(input, next_index))) break;
+        index = next_index;
     }
-    else if(NULL == index)
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_ignore_sect_contents(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_ignore_sect_contents);
+}
+// [65] Ignore ::= Char* - (Char* ('<![' | ']]>') Char*)
+static inline paradox_uint64_t paradox_xml1_parser_ignore(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    paradox_xml1_cursor cursor;
+    paradox_xml1_cursor_load(input, &cursor, paradox_xml1_skip_to_terminator(input, index, "<![", "]]>"));
+    while(cursor.classes & PARADOX_XML1_CHARACTER_CHAR)
     {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
+        if('<' == cursor.code && !paradox_xml1_compare(input, cursor.index, "<![", 3)) break;
+        if(']' == cursor.code && !paradox_xml1_compare(input, cursor.index, "]]>", 3)) break;
+        paradox_xml1_cursor_load(input, &cursor, paradox_xml1_skip_to_terminator(input, cursor.index + cursor.width, "<![", "]]>"));
     }
-    const paradox_uint64_t base_index = *index;
+    index = cursor.index;
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_ignore(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_ignore);
+}
 
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_space(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    if(strncmp(xml_string + *index, "NDATA", 5))
+// Character Reference
+
+// [66] CharRef ::= '&#' [0-9]+ ';' | '&#x' [0-9a-fA-F]+ ';' [WFC: Legal Character]
+static inline paradox_uint64_t paradox_xml1_parser_char_ref(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    paradox_uint64_t available = index < input->length ? input->length - index : 0;
+    // The unbounded entry points only know that their terminator ends the reference, so only the bytes before the
+    // first one that cannot continue it are made available.
+    if(PARADOX_XML1_INPUT_UNBOUNDED == input->length)
+    {
+        available = 0;
+        while('\0' != input->data[index + available] && (available < 3 || paradox_char8_ishex(input->data[index + available]))) available++;
+        if(';' == input->data[index + available]) available++;
+    }
+    paradox_uint32_t code;
+    const paradox_uint64_t length = paradox_xml1_decode_char_ref(input->data + index, available, &code);
+    return 0 != length ? index + length : PARADOX_XML1_PARSER_NO_MATCH;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_char_ref(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_char_ref);
+}
+
+// Entity Reference
+
+// [67] Reference ::= EntityRef | CharRef
+static inline paradox_uint64_t paradox_xml1_parser_reference(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if('&' == paradox_xml1_peek(input, index) && '#' == paradox_xml1_peek(input, index + 1)) return paradox_xml1_parser_char_ref(input, index);
+    return paradox_xml1_parser_entity_ref(input, index);
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_reference(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_reference);
+}
+// [68] EntityRef ::= '&' Name ';' [WFC: Entity Declared][VC: Entity Declared][WFC: Parsed Entity][WFC: No Recursion]
+static inline paradox_uint64_t paradox_xml1_parser_entity_ref(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if('&' != paradox_xml1_peek(input, index)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index++;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_name(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    if(';' != paradox_xml1_peek(input, index)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index++;
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_entity_ref(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_entity_ref);
+}
+// [69] PEReference ::= '%' Name ';' [VC: Entity Declared][WFC: No Recursion][WFC: In DTD]
+static inline paradox_uint64_t paradox_xml1_parser_pe_reference(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if('%' != paradox_xml1_peek(input, index)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index++;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_name(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    if(';' != paradox_xml1_peek(input, index)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index++;
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_pe_reference(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_pe_reference);
+}
+
+// Entity Declaration
+
+// [70] EntityDecl ::= GEDecl | PEDecl
+static inline paradox_uint64_t paradox_xml1_parser_entity_decl(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    // Both start with '<!ENTITY' S, the '%' after it tells them apart.
+    if(paradox_xml1_compare(input, index, "<!ENTITY", 8)) return PARADOX_XML1_PARSER_NO_MATCH;
+    paradox_uint64_t keyword_end = index + 8;
+    paradox_xml1_parser_accept(&keyword_end, paradox_xml1_parser_space(input, keyword_end));
+    if('%' == paradox_xml1_peek(input, keyword_end)) return paradox_xml1_parser_pe_decl(input, index);
+    return paradox_xml1_parser_ge_decl(input, index);
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_entity_decl(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_entity_decl);
+}
+// [71] GEDecl ::= '<!ENTITY' S Name S EntityDef S? '>'
+static inline paradox_uint64_t paradox_xml1_parser_ge_decl(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if(paradox_xml1_compare(input, index, "<!ENTITY", 8)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index += 8;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_name(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_entity_def(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+    if('>' != paradox_xml1_peek(input, index)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index++;
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_ge_decl(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_ge_decl);
+}
+// [72] PEDecl ::= '<!ENTITY' S '%' S Name S PEDef S? '>'
+static inline paradox_uint64_t paradox_xml1_parser_pe_decl(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if(paradox_xml1_compare(input, index, "<!ENTITY", 8)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index += 8;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    if('%' != paradox_xml1_peek(input, index)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index++;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_name(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_pe_def(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+    if('>' != paradox_xml1_peek(input, index)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index++;
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_pe_decl(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_pe_decl);
+}
+// [73] EntityDef ::= EntityValue | (ExternalID NDataDecl?)
+static inline paradox_uint64_t paradox_xml1_parser_entity_def(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if('"' == paradox_xml1_peek(input, index) || '\'' == paradox_xml1_peek(input, index))
     {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
+        if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_entity_value(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
     }
-    else (*index) += 5;
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_space(xml_string, index))
+    else if(paradox_xml1_parser_accept(&index, paradox_xml1_parser_external_id(input, index)))
     {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
+        paradox_xml1_parser_accept(&index, paradox_xml1_parser_ndata_decl(input, index));
     }
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_name(xml_string, index))
+    else return PARADOX_XML1_PARSER_NO_MATCH;
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_entity_def(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_entity_def);
+}
+// [74] PEDef ::= EntityValue | ExternalID
+static inline paradox_uint64_t paradox_xml1_parser_pe_def(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if('"' == paradox_xml1_peek(input, index) || '\'' == paradox_xml1_peek(input, index)) return paradox_xml1_parser_entity_value(input, index);
+    return paradox_xml1_parser_external_id(input, index);
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_pe_def(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_pe_def);
+}
+
+// External Entity Declaration
+
+// [75] ExternalID ::= 'SYSTEM' S SystemLiteral | 'PUBLIC' S PubidLiteral S SystemLiteral
+static inline paradox_uint64_t paradox_xml1_parser_external_id(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if(!paradox_xml1_compare(input, index, "SYSTEM", 6))
     {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
+        index += 6;
+        if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+        if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_system_literal(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
     }
-    result = PARADOX_XML1_PARSER_SUCCESS;
-
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
+    else if(!paradox_xml1_compare(input, index, "PUBLIC", 6))
     {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
+        index += 6;
+        if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+        if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_pubid_literal(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+        if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+        if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_system_literal(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
     }
-
-    return result;
+    else return PARADOX_XML1_PARSER_NO_MATCH;
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_external_id(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_external_id);
+}
+// [76] NDataDecl ::= S 'NDATA' S Name [VC: Notation Declared]
+static inline paradox_uint64_t paradox_xml1_parser_ndata_decl(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    if(paradox_xml1_compare(input, index, "NDATA", 5)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index += 5;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_name(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_ndata_decl(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_ndata_decl);
 }
 
 // Text Declaration
 
 // [77] TextDecl ::= '<?xml' VersionInfo? EncodingDecl S? '?>'
+static inline paradox_uint64_t paradox_xml1_parser_text_decl(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if(paradox_xml1_compare(input, index, "<?xml", 5)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index += 5;
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_version_info(input, index));
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_encoding_decl(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+    if(paradox_xml1_compare(input, index, "?>", 2)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index += 2;
+    return index;
+}
 PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_text_decl(paradox_str_t xml_string, paradox_uint64_t* index)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
-    const paradox_uint64_t base_index = *index;
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_text_decl);
+}
 
-    if(strncmp(xml_string + *index, "<?xml", 5))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else (*index) += 5;
-    paradox_parse_xml1_version_info(xml_string, index);
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_encoding_decl(xml_string, index))
+// Well-Formed External Parsed Entity
+
+// [78] extParsedEnt ::= ( TextDecl? content ) - ( Char* RestrictedChar Char* )
+static inline paradox_uint64_t paradox_xml1_parser_ext_parsed_ent(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_text_decl(input, index));
+    if(PARADOX_XML1_PARSER_SUCCESS != paradox_xml1_parser_content(input, &index, NULL, NULL, NULL, NULL, input->length)) return PARADOX_XML1_PARSER_NO_MATCH;
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_ext_parsed_ent(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_ext_parsed_ent);
+}
+
+// Encoding Declaration
+
+// [80] EncodingDecl ::= S 'encoding' Eq ('"' EncName '"' | "'" EncName "'" )
+static inline paradox_uint64_t paradox_xml1_parser_encoding_decl(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    if(paradox_xml1_compare(input, index, "encoding", 8)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index += 8;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_eq(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    paradox_char8_t quote;
+    if('"' == paradox_xml1_peek(input, index) || '\'' == paradox_xml1_peek(input, index))
     {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
+        quote = paradox_xml1_peek(input, index++);
     }
-    paradox_parse_xml1_space(xml_string, index);
-    if(strncmp(xml_string + *index, "?>", 2))
+    else return PARADOX_XML1_PARSER_NO_MATCH;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_enc_name(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    if(quote != paradox_xml1_peek(input, index)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index++;
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_encoding_decl(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_encoding_decl);
+}
+// [81] EncName ::= [A-Za-z] ([A-Za-z0-9._] | '-')*
+static inline paradox_uint64_t paradox_xml1_parser_enc_name(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if(!isalpha(paradox_xml1_peek(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index++;
+    while('\0' != paradox_xml1_peek(input, index))
     {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
+        paradox_bool8_t found = PARADOX_FALSE;
+        switch(paradox_xml1_peek(input, index))
+        {
+        case '-':
+        case '_':
+        case '.':
+        {
+            found = PARADOX_TRUE;
+            break;
+        }
+        default:
+        {
+            if(isalnum(paradox_xml1_peek(input, index))) found = PARADOX_TRUE;
+            break;
+        }
+        }
+        if(PARADOX_TRUE == found) index++;
+        else break;
     }
-    else (*index) += 2;
-    result = PARADOX_XML1_PARSER_SUCCESS;
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_enc_name(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_enc_name);
+}
 
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
-    }
+// Notation Declarations
+
+// [82] NotationDecl ::= '<!NOTATION' S Name S (ExternalID | PublicID) S? '>' [VC: Unique Notation Name]
+static inline paradox_uint64_t paradox_xml1_parser_notation_decl(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if(paradox_xml1_compare(input, index, "<!NOTATION", 10)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index += 10;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_name(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    if( !paradox_xml1_parser_accept(&index, paradox_xml1_parser_external_id(input, index))
+    &&  !paradox_xml1_parser_accept(&index, paradox_xml1_parser_public_id(input, index)))
+    {
+        return PARADOX_XML1_PARSER_NO_MATCH;
+    }
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+    if('>' != paradox_xml1_peek(input, index)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index++;
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_notation_decl(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_notation_decl);
+}
+// [83] PublicID ::= 'PUBLIC' S PubidLiteral
+static inline paradox_uint64_t paradox_xml1_parser_public_id(const paradox_xml1_input* input, paradox_uint64_t index)
+{
+    if(paradox_xml1_compare(input, index, "PUBLIC", 6)) return PARADOX_XML1_PARSER_NO_MATCH;
+    else index += 6;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_pubid_literal(input, index))) return PARADOX_XML1_PARSER_NO_MATCH;
+    return index;
+}
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_public_id(paradox_str_t xml_string, paradox_uint64_t* index)
+{
+    return paradox_xml1_parser_run(xml_string, index, paradox_xml1_parser_public_id);
+}
+// Reader
+
+typedef enum paradox_xml1_reader_phase_t {
+    PARADOX_XML1_READER_PROLOG,
+    PARADOX_XML1_READER_CONTENT,
+    PARADOX_XML1_READER_EPILOG,
+    PARADOX_XML1_READER_DONE
+} paradox_xml1_reader_phase_t;
+
+// An entity whose replacement text the reader reads in place of the reference to it, with the input and index to go
+// back to once it ends and the number of elements that were open at the reference.
+typedef struct paradox_xml1_reader_entity
+{
+    paradox_xml1_entity* entity;
+    paradox_xml1_input input;
+    paradox_uint64_t index;
+    paradox_uint64_t depth;
+} paradox_xml1_reader_entity;
+
+struct paradox_xml1_reader
+{
+    paradox_xml1_input input;
+    paradox_uint64_t index;
+    paradox_xml1_reader_phase_t phase;
+    paradox_xml1_parser_errno_t error;
+    paradox_xml1_token_t token;
+    paradox_xml1_slice name;
+    paradox_xml1_slice text;
+    // Set after the start of an EmptyElemTag so the next token closes it.
+    paradox_bool8_t empty_element;
+    paradox_bool8_t declaration_seen;
+    paradox_bool8_t doctype_seen;
+    // Entities declared by the doctypedecl, NULL without one.
+    paradox_xml1_entity_table* entities;
+    // Entities being read, the innermost last. While there are any, input holds the replacement text of the innermost.
+    paradox_xml1_reader_entity* included;
+    paradox_uint64_t included_count;
+    paradox_uint64_t included_capacity;
+    // Name lengths of the open elements, the innermost last, with their names stacked in names.
+    // The names are copied so a streaming reader can drop the input they were read from.
+    paradox_uint64_t* open;
+    paradox_uint64_t depth;
+    paradox_uint64_t open_capacity;
+    char* names;
+    paradox_uint64_t names_length;
+    paradox_uint64_t names_capacity;
+    // Name and value pairs of the current start element.
+    paradox_xml1_slice* attributes;
+    paradox_uint64_t attribute_count;
+    paradox_uint64_t attributes_capacity;
+    paradox_xml1_parser_name_set unique;
+    // Holds decoded text and attribute values holding references.
+    char* buffer;
+    paradox_uint64_t capacity;
+    // A streaming reader parses out of stream, which holds the input fed to it from the start of the
+    // current token on. input.length only differs from stream_length while a piece of text is read.
+    paradox_bool8_t streaming;
+    paradox_bool8_t final;
+    char* stream;
+    paradox_uint64_t stream_length;
+    paradox_uint64_t stream_capacity;
+    // Where the search for the end of the next token resumes, and whether it stopped inside quotes.
+    paradox_uint64_t scan_index;
+    char scan_quote;
+};
+
+static paradox_bool8_t paradox_xml1_reader_reserve(void** memory, paradox_uint64_t* capacity, const paradox_uint64_t count, const paradox_uint64_t size)
+{
+    if(count <= *capacity) return PARADOX_TRUE;
+    paradox_uint64_t grown = *capacity ? *capacity * 2 : 16;
+    while(grown < count) grown *= 2;
+    void* reallocated = realloc(*memory, grown * size);
+    if(NULL == reallocated) return PARADOX_FALSE;
+    *memory = reallocated;
+    *capacity = grown;
+    return PARADOX_TRUE;
+}
 
-    return result;
+static paradox_xml1_token_t paradox_xml1_reader_fail(paradox_xml1_reader* reader, const paradox_xml1_parser_errno_t error)
+{
+    reader->error = error;
+    reader->attribute_count = 0;
+    reader->phase = PARADOX_XML1_READER_DONE;
+    reader->token = PARADOX_XML1_TOKEN_ERROR;
+    return PARADOX_XML1_TOKEN_ERROR;
 }
 
-// Well-Formed External Parsed Entity
+// Reads a Comment or PI at the current index, PARADOX_XML1_TOKEN_NONE when there is neither.
+static paradox_xml1_token_t paradox_xml1_reader_markup(paradox_xml1_reader* reader)
+{
+    const paradox_xml1_input* input = &reader->input;
+    const paradox_uint64_t markup_index = reader->index;
+    if(paradox_xml1_parser_accept(&reader->index, paradox_xml1_parser_comment(input, reader->index)))
+    {
+        reader->text.data = input->data + markup_index + 4;
+        reader->text.length = reader->index - markup_index - 7;
+        return PARADOX_XML1_TOKEN_COMMENT;
+    }
+    if(paradox_xml1_parser_accept(&reader->index, paradox_xml1_parser_pi(input, reader->index)))
+    {
+        // '<?' PITarget (S data)? '?>'
+        paradox_uint64_t index = markup_index + 2;
+        paradox_xml1_parser_accept(&index, paradox_xml1_parser_name(input, index));
+        reader->name.data = input->data + markup_index + 2;
+        reader->name.length = index - markup_index - 2;
+        paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+        reader->text.data = input->data + index;
+        reader->text.length = reader->index - 2 > index ? reader->index - 2 - index : 0;
+        return PARADOX_XML1_TOKEN_PROCESSING_INSTRUCTION;
+    }
+    return PARADOX_XML1_TOKEN_NONE;
+}
 
-// [78] extParsedEnt ::= ( TextDecl? content ) - ( Char* RestrictedChar Char* )
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_ext_parsed_ent(paradox_str_t xml_string, paradox_uint64_t* index)
+// '<' Name (S Attribute)* S? ('>' | '/>') [WFC: Unique Att Spec]
+static paradox_xml1_token_t paradox_xml1_reader_start_element(paradox_xml1_reader* reader)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
+    const paradox_xml1_input* input = &reader->input;
+    paradox_uint64_t index = reader->index + 1;
+    if(!paradox_xml1_parser_accept(&index, paradox_xml1_parser_name(input, index))) return paradox_xml1_reader_fail(reader, PARADOX_XML1_PARSER_INVALID_DOCUMENT);
+    reader->name.data = input->data + reader->index + 1;
+    reader->name.length = index - reader->index - 1;
+
+    reader->attribute_count = 0;
+    paradox_uint64_t decoded_length = 0;
+    while(PARADOX_TRUE)
+    {
+        paradox_uint64_t next_index = index;
+        if(!paradox_xml1_parser_accept(&next_index, paradox_xml1_parser_space(input, next_index))) break;
+        paradox_xml1_slice name;
+        paradox_xml1_slice value;
+        if(PARADOX_XML1_PARSER_SUCCESS != paradox_xml1_parser_attribute(input, &next_index, NULL, NULL, &name, &value)) break;
+        const paradox_xml1_parser_errno_t unique = paradox_xml1_parser_unique_name(&reader->unique, reader->attributes, 2, reader->attribute_count, name);
+        if(PARADOX_XML1_PARSER_SUCCESS != unique) return paradox_xml1_reader_fail(reader, unique);
+        if(PARADOX_FALSE == paradox_xml1_reader_reserve((void**)&reader->attributes, &reader->attributes_capacity, 2 * reader->attribute_count + 2, sizeof(paradox_xml1_slice))) return paradox_xml1_reader_fail(reader, PARADOX_XML1_PARSER_OUT_OF_MEMORY);
+        reader->attributes[2 * reader->attribute_count] = name;
+        reader->attributes[2 * reader->attribute_count + 1] = value;
+        reader->attribute_count++;
+        if(NULL != memchr(value.data, '&', value.length))
+        {
+            paradox_uint64_t length = value.length;
+            if(PARADOX_TRUE == paradox_xml1_parser_references_entities(value))
+            {
+                const paradox_xml1_parser_errno_t expanded = paradox_xml1_parser_measure_value(reader->entities, value, &length);
+                if(PARADOX_XML1_PARSER_SUCCESS != expanded) return paradox_xml1_reader_fail(reader, expanded);
+            }
+            decoded_length += length;
+        }
+        index = next_index;
     }
-    else if(NULL == index)
+    paradox_xml1_parser_accept(&index, paradox_xml1_parser_space(input, index));
+    if(!paradox_xml1_compare(input, index, "/>", 2))
     {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
+        reader->empty_element = PARADOX_TRUE;
+        index += 2;
     }
-    const paradox_uint64_t base_index = *index;
+    else if('>' == paradox_xml1_peek(input, index)) index++;
+    else return paradox_xml1_reader_fail(reader, PARADOX_XML1_PARSER_INVALID_DOCUMENT);
 
-    paradox_parse_xml1_text_decl(xml_string, index);
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_content(xml_string, index))
+    // Values holding references are decoded side by side into the buffer once it can no longer move.
+    if(decoded_length)
     {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
+        if(PARADOX_FALSE == paradox_xml1_reader_reserve((void**)&reader->buffer, &reader->capacity, decoded_length, 1)) return paradox_xml1_reader_fail(reader, PARADOX_XML1_PARSER_OUT_OF_MEMORY);
+        char* output = reader->buffer;
+        for(paradox_uint64_t i = 0; i < reader->attribute_count; i++)
+        {
+            paradox_xml1_slice* value = &reader->attributes[2 * i + 1];
+            if(NULL == memchr(value->data, '&', value->length)) continue;
+            value->length = PARADOX_TRUE == paradox_xml1_parser_references_entities(*value)
+                ?   paradox_xml1_parser_expand_value(reader->entities, *value, output)
+                :   paradox_xml1_decode_value(value->data, value->length, output);
+            value->data = output;
+            output += value->length;
+        }
     }
-    result = PARADOX_XML1_PARSER_SUCCESS;
 
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
-    }
+    if( PARADOX_FALSE == paradox_xml1_reader_reserve((void**)&reader->open, &reader->open_capacity, reader->depth + 1, sizeof(paradox_uint64_t))
+    ||  PARADOX_FALSE == paradox_xml1_reader_reserve((void**)&reader->names, &reader->names_capacity, reader->names_length + reader->name.length, 1)) return paradox_xml1_reader_fail(reader, PARADOX_XML1_PARSER_OUT_OF_MEMORY);
+    reader->open[reader->depth++] = reader->name.length;
+    memcpy(reader->names + reader->names_length, reader->name.data, reader->name.length);
+    reader->names_length += reader->name.length;
+    reader->phase = PARADOX_XML1_READER_CONTENT;
+    reader->index = index;
+    return PARADOX_XML1_TOKEN_START_ELEMENT;
+}
 
-    return result;
+// Pops the innermost open element, whose name is in reader->name.
+static paradox_xml1_token_t paradox_xml1_reader_end_element(paradox_xml1_reader* reader)
+{
+    reader->name.length = reader->open[--reader->depth];
+    reader->names_length -= reader->name.length;
+    reader->name.data = reader->names + reader->names_length;
+    reader->attribute_count = 0;
+    if(0 == reader->depth) reader->phase = PARADOX_XML1_READER_EPILOG;
+    return PARADOX_XML1_TOKEN_END_ELEMENT;
 }
 
-// Encoding Declaration
+static paradox_xml1_token_t paradox_xml1_reader_content(paradox_xml1_reader* reader);
+static paradox_bool8_t paradox_xml1_reader_buffered(paradox_xml1_reader* reader);
 
-// [80] EncodingDecl ::= S 'encoding' Eq ('"' EncName '"' | "'" EncName "'" )
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_encoding_decl(paradox_str_t xml_string, paradox_uint64_t* index)
+// Reads the replacement text of entity, which holds markup, in place of the reference to it, the way the tree parses
+// it as content. [WFC: No Recursion]
+static paradox_xml1_token_t paradox_xml1_reader_include(paradox_xml1_reader* reader, paradox_xml1_entity* entity)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
-    const paradox_uint64_t base_index = *index;
+    paradox_xml1_entity_table* entities = reader->entities;
+    if(PARADOX_FALSE == paradox_xml1_entities_charge(entities, entity->replacement.length)) return paradox_xml1_reader_fail(reader, PARADOX_XML1_PARSER_ENTITY_LIMIT);
+    if(entities->depth >= entities->depth_limit) return paradox_xml1_reader_fail(reader, PARADOX_XML1_PARSER_ENTITY_LIMIT);
+    if(PARADOX_FALSE == paradox_xml1_reader_reserve((void**)&reader->included, &reader->included_capacity, reader->included_count + 1, sizeof(paradox_xml1_reader_entity))) return paradox_xml1_reader_fail(reader, PARADOX_XML1_PARSER_OUT_OF_MEMORY);
+    paradox_xml1_reader_entity* included = &reader->included[reader->included_count++];
+    included->entity = entity;
+    included->input = reader->input;
+    included->index = reader->index;
+    included->depth = reader->depth;
+    entity->state = PARADOX_XML1_ENTITY_EXPANDING;
+    entities->depth++;
+    reader->input.data = entity->replacement.data;
+    reader->input.length = entity->replacement.length;
+    reader->input.validated = PARADOX_FALSE;
+    reader->index = 0;
+    return paradox_xml1_reader_content(reader);
+}
 
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_space(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    if(strncmp(xml_string + *index, "encoding", 8))
+// Goes back to where the innermost entity was referenced once its replacement text has been read.
+static void paradox_xml1_reader_leave(paradox_xml1_reader* reader)
+{
+    const paradox_xml1_reader_entity* included = &reader->included[--reader->included_count];
+    included->entity->state = PARADOX_XML1_ENTITY_EXPANDED;
+    reader->entities->depth--;
+    reader->input = included->input;
+    reader->index = included->index;
+    // A feed may have moved the stream meanwhile.
+    if(reader->streaming && 0 == reader->included_count)
     {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
+        reader->input.data = NULL != reader->stream ? reader->stream : "";
+        reader->input.length = reader->stream_length;
     }
-    else (*index) += 8;
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_eq(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
+}
+
+// Whether the innermost entity has been read to its end and left the elements open as they were at the reference.
+static inline paradox_bool8_t paradox_xml1_reader_entity_ended(const paradox_xml1_reader* reader)
+{
+    return 0 != reader->included_count
+        && PARADOX_FALSE == reader->empty_element
+        && reader->index == reader->input.length
+        && reader->depth == reader->included[reader->included_count - 1].depth;
+}
+
+// CharData? (Reference CharData?)*, merged into one token and decoded when it holds references. The text stops short of
+// a reference to an entity whose replacement text holds markup, which is read as content in its place, and of one to an
+// entity that is not read, which is a token of its own that keeps the reference as it is written, like the tree does.
+// [WFC: Entity Declared][WFC: Parsed Entity]
+static paradox_xml1_token_t paradox_xml1_reader_text(paradox_xml1_reader* reader)
+{
+    const paradox_xml1_input* input = &reader->input;
+    const paradox_uint64_t text_index = reader->index;
+    paradox_bool8_t has_reference = PARADOX_FALSE;
+    while(PARADOX_TRUE)
+    {
+        paradox_xml1_parser_accept(&reader->index, paradox_xml1_parser_char_data(input, reader->index));
+        if('&' != paradox_xml1_peek(input, reader->index)) break;
+        const paradox_uint64_t reference_index = reader->index;
+        if(!paradox_xml1_parser_accept(&reader->index, paradox_xml1_parser_reference(input, reader->index))) return paradox_xml1_reader_fail(reader, PARADOX_XML1_PARSER_INVALID_DOCUMENT);
+        const char* reference = input->data + reference_index;
+        const paradox_uint64_t reference_length = reader->index - reference_index;
+        if(PARADOX_FALSE == paradox_xml1_parser_entity_reference(reference, reference_length))
+        {
+            has_reference = PARADOX_TRUE;
+            continue;
+        }
+
+        paradox_xml1_entity* entity = paradox_xml1_entities_find(reader->entities, reference + 1, reference_length - 2, PARADOX_FALSE);
+        if(NULL == entity ? NULL == reader->entities || PARADOX_FALSE == reader->entities->incomplete : PARADOX_TRUE == entity->unparsed) return paradox_xml1_reader_fail(reader, PARADOX_XML1_PARSER_INVALID_DOCUMENT);
+        if(NULL != entity && PARADOX_FALSE == entity->external)
+        {
+            const paradox_xml1_parser_errno_t expanded = paradox_xml1_parser_expand_entity(reader->entities, entity);
+            if(PARADOX_XML1_PARSER_SUCCESS != expanded) return paradox_xml1_reader_fail(reader, expanded);
+            if(PARADOX_FALSE == entity->markup)
+            {
+                has_reference = PARADOX_TRUE;
+                continue;
+            }
+        }
+        if(text_index != reference_index)
+        {
+            reader->index = reference_index;
+            break;
+        }
+        if(NULL != entity && PARADOX_FALSE == entity->external) return paradox_xml1_reader_include(reader, entity);
+        reader->text.data = reference;
+        reader->text.length = reference_length;
+        return PARADOX_XML1_TOKEN_TEXT;
+    }
+    // CharData stops short of ']]>' and of characters that are not allowed.
+    if(text_index == reader->index) return paradox_xml1_reader_fail(reader, PARADOX_XML1_PARSER_INVALID_DOCUMENT);
+
+    reader->text.data = input->data + text_index;
+    reader->text.length = reader->index - text_index;
+    if(has_reference)
+    {
+        // The entities left are character data, so the text is expanded like an attribute value.
+        const paradox_bool8_t entities = paradox_xml1_parser_references_entities(reader->text);
+        paradox_uint64_t length = reader->text.length;
+        if(PARADOX_TRUE == entities)
+        {
+            const paradox_xml1_parser_errno_t expanded = paradox_xml1_parser_measure_value(reader->entities, reader->text, &length);
+            if(PARADOX_XML1_PARSER_SUCCESS != expanded) return paradox_xml1_reader_fail(reader, expanded);
+        }
+        if(PARADOX_FALSE == paradox_xml1_reader_reserve((void**)&reader->buffer, &reader->capacity, length, 1)) return paradox_xml1_reader_fail(reader, PARADOX_XML1_PARSER_OUT_OF_MEMORY);
+        reader->text.length = PARADOX_TRUE == entities
+            ?   paradox_xml1_parser_expand_value(reader->entities, reader->text, reader->buffer)
+            :   paradox_xml1_decode_value(reader->text.data, reader->text.length, reader->buffer);
+        reader->text.data = reader->buffer;
+        // Entities may expand to nothing, which is no token. A streaming reader has read all it was fed then.
+        if(0 == reader->text.length)
+        {
+            if(reader->streaming && PARADOX_FALSE == reader->final && 0 == reader->included_count && reader->index == input->length) return PARADOX_XML1_TOKEN_NONE;
+            return paradox_xml1_reader_content(reader);
+        }
     }
-    paradox_char8_t quote;
-    if('"' == xml_string[*index] || '\'' == xml_string[*index])
-    {
-        quote = xml_string[(*index)++];
+    return PARADOX_XML1_TOKEN_TEXT;
+}
+
+static paradox_xml1_token_t paradox_xml1_reader_content(paradox_xml1_reader* reader)
+{
+    const paradox_xml1_input* input = &reader->input;
+    if(0 != reader->included_count && reader->index == input->length)
+    {
+        // An entity that ends with elements open that it started. [WFC: Parsed Entity]
+        if(PARADOX_FALSE == paradox_xml1_reader_entity_ended(reader)) return paradox_xml1_reader_fail(reader, PARADOX_XML1_PARSER_INVALID_DOCUMENT);
+        while(PARADOX_TRUE == paradox_xml1_reader_entity_ended(reader)) paradox_xml1_reader_leave(reader);
+        // Back in the stream, what comes after the reference may not have been fed yet.
+        if(reader->streaming && 0 == reader->included_count)
+        {
+            if(PARADOX_FALSE == paradox_xml1_reader_buffered(reader)) return PARADOX_XML1_TOKEN_NONE;
+            reader->scan_index = 0;
+            reader->scan_quote = 0;
+        }
+        return paradox_xml1_reader_content(reader);
     }
-    else
+    if('<' != paradox_xml1_peek(input, reader->index))
     {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
+        // The root element is still open when the input ends.
+        if(reader->index >= input->length || '\0' == paradox_xml1_peek(input, reader->index)) return paradox_xml1_reader_fail(reader, PARADOX_XML1_PARSER_INVALID_DOCUMENT);
+        return paradox_xml1_reader_text(reader);
     }
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_enc_name(xml_string, index))
+
+    const paradox_uint64_t markup_index = reader->index;
+    if('/' == paradox_xml1_peek(input, markup_index + 1))
     {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
+        // [WFC: Element Type Match]
+        // An entity cannot close an element it did not start. [WFC: Parsed Entity]
+        const paradox_uint64_t open_length = reader->open[reader->depth - 1];
+        const char* open_name = reader->names + reader->names_length - open_length;
+        if( (0 != reader->included_count && reader->depth == reader->included[reader->included_count - 1].depth)
+        ||  !paradox_xml1_parser_accept(&reader->index, paradox_xml1_parser_e_tag(input, reader->index))
+        ||  input->length - (markup_index + 2) < open_length
+        ||  memcmp(input->data + markup_index + 2, open_name, open_length)
+        ||  PARADOX_TRUE == paradox_xml1_is_name_char(input, markup_index + 2 + open_length))
+        {
+            reader->index = markup_index;
+            return paradox_xml1_reader_fail(reader, PARADOX_XML1_PARSER_INVALID_DOCUMENT);
+        }
+        return paradox_xml1_reader_end_element(reader);
     }
-    if(quote != xml_string[*index])
+    const paradox_xml1_token_t markup = paradox_xml1_reader_markup(reader);
+    if(PARADOX_XML1_TOKEN_NONE != markup) return markup;
+    if(paradox_xml1_parser_accept(&reader->index, paradox_xml1_parser_cd_sect(input, reader->index)))
     {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
+        reader->text.data = input->data + markup_index + 9;
+        reader->text.length = reader->index - markup_index - 12;
+        return PARADOX_XML1_TOKEN_CDATA;
     }
-    else (*index)++;
-    result = PARADOX_XML1_PARSER_SUCCESS;
+    return paradox_xml1_reader_start_element(reader);
+}
 
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
+// Misc* around the root element, and the doctypedecl before it.
+static paradox_xml1_token_t paradox_xml1_reader_misc(paradox_xml1_reader* reader)
+{
+    const paradox_xml1_input* input = &reader->input;
+    while(PARADOX_TRUE)
     {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
+        paradox_xml1_parser_accept(&reader->index, paradox_xml1_parser_space(input, reader->index));
+        const paradox_xml1_token_t markup = paradox_xml1_reader_markup(reader);
+        if(PARADOX_XML1_TOKEN_NONE != markup) return markup;
+        if(PARADOX_XML1_READER_EPILOG == reader->phase)
+        {
+            if(reader->index != input->length) return paradox_xml1_reader_fail(reader, PARADOX_XML1_PARSER_INVALID_DOCUMENT);
+            reader->phase = PARADOX_XML1_READER_DONE;
+            return PARADOX_XML1_TOKEN_END_DOCUMENT;
+        }
+        if(PARADOX_FALSE == reader->doctype_seen && !paradox_xml1_compare(input, reader->index, "<!DOCTYPE", 9))
+        {
+            const paradox_xml1_parser_errno_t result = paradox_xml1_parser_doctype(input, &reader->index, NULL, &reader->entities);
+            if(PARADOX_XML1_PARSER_SUCCESS != result) return paradox_xml1_reader_fail(reader, result);
+            reader->doctype_seen = PARADOX_TRUE;
+            continue;
+        }
+        if('<' != paradox_xml1_peek(input, reader->index)) return paradox_xml1_reader_fail(reader, PARADOX_XML1_PARSER_INVALID_DOCUMENT);
+        return paradox_xml1_reader_start_element(reader);
     }
-
-    return result;
 }
-// [81] EncName ::= [A-Za-z] ([A-Za-z0-9._] | '-')*
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_enc_name(paradox_str_t xml_string, paradox_uint64_t* index)
+
+// Streaming
+
+// Returns the end of the markup starting at index, or 0 when the stream ends before it.
+// With resume set the search continues where the previous call for the same markup stopped.
+static paradox_uint64_t paradox_xml1_reader_markup_end(paradox_xml1_reader* reader, const paradox_uint64_t index, const paradox_bool8_t resume)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
+    const char* data = reader->stream;
+    const paradox_uint64_t length = reader->stream_length;
+    const paradox_uint64_t available = length - index;
+    const char* terminator = NULL;
+    paradox_uint64_t from = index + 1;
+
+    // Markup starting with '<!' can only be told apart once its first 9 bytes are in.
+    if(available >= 2 && '!' == data[index + 1] && available < 9) return 0;
+    if(available >= 4 && !strncmp(data + index, "<!--", 4))
     {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
+        terminator = "-->";
+        from = index + 4;
     }
-    else if(NULL == index)
+    else if(available >= 9 && !strncmp(data + index, "<![CDATA[", 9))
     {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
+        terminator = "]]>";
+        from = index + 9;
     }
-    const paradox_uint64_t base_index = *index;
-
-    if(!isalpha(xml_string[*index]))
+    else if(available >= 2 && '?' == data[index + 1])
     {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
+        terminator = "?>";
+        from = index + 2;
     }
-    else (*index)++;
-    while('\0' != xml_string[*index])
+    else if(available >= 9 && !strncmp(data + index, "<!DOCTYPE", 9))
     {
-        paradox_bool8_t found = PARADOX_FALSE;
-        switch(xml_string[*index])
+        // Brackets of the internal subset nest, quoted literals and comments are skipped.
+        paradox_uint64_t depth = 0;
+        char quote = 0;
+        for(paradox_uint64_t i = index + 9; i < length; i++)
         {
-        case '-':
-        case '_':
-        case '.':
-        {
-            found = PARADOX_TRUE;
-            break;
+            const char c = data[i];
+            if(quote)
+            {
+                if(c == quote) quote = 0;
+            }
+            else if('"' == c || '\'' == c) quote = c;
+            else if('[' == c) depth++;
+            else if(']' == c && depth) depth--;
+            else if('>' == c && 0 == depth) return i + 1;
+            else if('<' == c && length - i >= 4 && !strncmp(data + i, "<!--", 4))
+            {
+                i += 4;
+                while(i + 2 < length && strncmp(data + i, "-->", 3)) i++;
+                if(i + 2 >= length) return 0;
+                i += 2;
+            }
         }
-        default:
+        return 0;
+    }
+
+    if(resume && reader->scan_index > from) from = reader->scan_index;
+    if(NULL == terminator)
+    {
+        // Tags end at the first '>' outside of a quoted attribute value.
+        char quote = resume ? reader->scan_quote : 0;
+        for(paradox_uint64_t i = from; i < length; i++)
         {
-            if(isalnum(xml_string[*index])) found = PARADOX_TRUE;
-            break;
+            const char c = data[i];
+            if(quote)
+            {
+                if(c == quote) quote = 0;
+            }
+            else if('"' == c || '\'' == c) quote = c;
+            else if('>' == c) return i + 1;
         }
+        if(resume)
+        {
+            reader->scan_index = length;
+            reader->scan_quote = quote;
         }
-        if(PARADOX_TRUE == found) (*index)++;
-        else break;
+        return 0;
     }
-    result = PARADOX_XML1_PARSER_SUCCESS;
 
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
+    const paradox_uint64_t terminator_length = strlen(terminator);
+    for(paradox_uint64_t i = from; i + terminator_length <= length; i++)
     {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
+        const char* found = memchr(data + i, terminator[0], length - i);
+        if(NULL == found) break;
+        i = found - data;
+        if(i + terminator_length <= length && !strncmp(found, terminator, terminator_length)) return i + terminator_length;
     }
-
-    return result;
+    if(resume) reader->scan_index = length - from >= terminator_length ? length - terminator_length + 1 : from;
+    return 0;
 }
 
-// Notation Declarations
-
-// [82] NotationDecl ::= '<!NOTATION' S Name S (ExternalID | PublicID) S? '>' [VC: Unique Notation Name]
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_notation_decl(paradox_str_t xml_string, paradox_uint64_t* index)
+// Cuts the text starting at index short of an incomplete character, Reference or ']]>' at the end of
+// the stream. Returns index when nothing can be read yet.
+static paradox_uint64_t paradox_xml1_reader_text_end(const paradox_xml1_reader* reader, const paradox_uint64_t index)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
-    const paradox_uint64_t base_index = *index;
+    const unsigned char* data = (const unsigned char*)reader->stream;
+    paradox_uint64_t end = reader->stream_length;
 
-    if(strncmp(xml_string + *index, "<!NOTATION", 10))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else (*index) += 10;
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_space(xml_string, index))
+    paradox_uint64_t lead = end;
+    while(lead > index && lead + 4 > end && 0x80 == (data[lead - 1] & 0xC0)) lead--;
+    if(lead > index && data[lead - 1] >= 0xC0)
     {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
+        const paradox_uint64_t width = data[lead - 1] >= 0xF0 ? 4 : data[lead - 1] >= 0xE0 ? 3 : 2;
+        if(end - (lead - 1) < width) end = lead - 1;
     }
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_name(xml_string, index))
+    for(paradox_uint64_t i = end; i > index; i--)
     {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
+        if(';' == data[i - 1]) break;
+        if('&' == data[i - 1])
+        {
+            end = i - 1;
+            break;
+        }
     }
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_space(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
+    while(end > index && ']' == data[end - 1]) end--;
+    return end;
+}
+
+// Tells whether the next token lies completely in the stream. Text without its end in sight is
+// limited to what can be read already, which splits it across several text tokens.
+static paradox_bool8_t paradox_xml1_reader_buffered(paradox_xml1_reader* reader)
+{
+    // The replacement text of an entity is there as a whole.
+    if(reader->final || 0 != reader->included_count) return PARADOX_TRUE;
+    const char* data = reader->stream;
+    const paradox_uint64_t length = reader->stream_length;
+    paradox_uint64_t index = reader->index;
+
+    if(PARADOX_XML1_READER_CONTENT == reader->phase)
+    {
+        if(reader->empty_element) return PARADOX_TRUE;
+        if(index == length) return PARADOX_FALSE;
+        if('<' == data[index]) return 0 != paradox_xml1_reader_markup_end(reader, index, PARADOX_TRUE);
+
+        paradox_uint64_t from = index > reader->scan_index ? index : reader->scan_index;
+        if(NULL != memchr(data + from, '<', length - from)) return PARADOX_TRUE;
+        reader->scan_index = length;
+        const paradox_uint64_t end = paradox_xml1_reader_text_end(reader, index);
+        if(end == index) return PARADOX_FALSE;
+        reader->input.length = end;
+        return PARADOX_TRUE;
     }
-    if( PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_external_id(xml_string, index)
-    &&  PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_public_id(xml_string, index))
+
+    // The prolog reads the XMLDecl and the doctypedecl together with the token after them.
+    if(PARADOX_XML1_READER_PROLOG == reader->phase && PARADOX_FALSE == reader->declaration_seen)
     {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
+        if(length - index < 2) return PARADOX_FALSE;
+        index = paradox_xml1_reader_markup_end(reader, index, PARADOX_FALSE);
+        if(0 == index) return PARADOX_FALSE;
     }
-    paradox_parse_xml1_space(xml_string, index);
-    if('>' != xml_string[*index])
+    while(PARADOX_TRUE)
     {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
+        while(index < length && (' ' == data[index] || '\t' == data[index] || '\r' == data[index] || '\n' == data[index])) index++;
+        // Only the end of the input tells whether more Misc follows.
+        if(index == length) return PARADOX_FALSE;
+        if('<' != data[index]) return PARADOX_TRUE;
+        if(PARADOX_XML1_READER_PROLOG == reader->phase && PARADOX_FALSE == reader->doctype_seen && length - index >= 2 && '!' == data[index + 1])
+        {
+            if(length - index < 9) return PARADOX_FALSE;
+            if(!strncmp(data + index, "<!DOCTYPE", 9))
+            {
+                index = paradox_xml1_reader_markup_end(reader, index, PARADOX_FALSE);
+                if(0 == index) return PARADOX_FALSE;
+                continue;
+            }
+        }
+        return 0 != paradox_xml1_reader_markup_end(reader, index, PARADOX_TRUE);
     }
-    else (*index)++;
-    result = PARADOX_XML1_PARSER_SUCCESS;
+}
 
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
-    }
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_create_xml1_stream_reader(paradox_xml1_reader** reader)
+{
+    if(NULL == reader) return PARADOX_XML1_PARSER_NULL_DOCUMENT;
+    *reader = NULL;
+    paradox_xml1_reader* created = calloc(1, sizeof(paradox_xml1_reader));
+    if(NULL == created) return PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+    created->input.data = "";
+    created->input.length = 0;
+    created->phase = PARADOX_XML1_READER_PROLOG;
+    created->error = PARADOX_XML1_PARSER_SUCCESS;
+    created->token = PARADOX_XML1_TOKEN_NONE;
+    created->streaming = PARADOX_TRUE;
+    *reader = created;
+    return PARADOX_XML1_PARSER_SUCCESS;
+}
 
-    return result;
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_feed_xml1_reader(paradox_xml1_reader* reader, const char* data, const paradox_uint64_t length, const paradox_bool8_t final)
+{
+    if(NULL == reader || (NULL == data && length)) return PARADOX_XML1_PARSER_NULL_DOCUMENT;
+    if(PARADOX_FALSE == reader->streaming || reader->final) return PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+
+    // Everything before the current token has been read, so it is dropped before the chunk is appended. Inside
+    // an entity, that is everything before the reference to the outermost one.
+    paradox_uint64_t* index = 0 != reader->included_count ? &reader->included[0].index : &reader->index;
+    const paradox_uint64_t consumed = *index;
+    if(consumed)
+    {
+        memmove(reader->stream, reader->stream + consumed, reader->stream_length - consumed);
+        reader->stream_length -= consumed;
+        *index = 0;
+        if(reader->scan_index) reader->scan_index -= consumed;
+    }
+    if(PARADOX_FALSE == paradox_xml1_reader_reserve((void**)&reader->stream, &reader->stream_capacity, reader->stream_length + length, 1)) return PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+    if(length) memcpy(reader->stream + reader->stream_length, data, length);
+    reader->stream_length += length;
+    reader->final = final;
+    // paradox_xml1_reader_leave picks the stream up again.
+    if(0 != reader->included_count) return PARADOX_XML1_PARSER_SUCCESS;
+    reader->input.data = NULL != reader->stream ? reader->stream : "";
+    reader->input.length = reader->stream_length;
+    return PARADOX_XML1_PARSER_SUCCESS;
 }
-// [83] PublicID ::= 'PUBLIC' S PubidLiteral
-PARADOX_XML_API paradox_xml1_parser_errno_t paradox_parse_xml1_public_id(paradox_str_t xml_string, paradox_uint64_t* index)
+
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_create_xml1_reader(const char* data, const paradox_uint64_t length, paradox_xml1_reader** reader)
 {
-    paradox_xml1_parser_errno_t result;
-    if(NULL == xml_string)
-    {
-        result = PARADOX_XML1_PARSER_NULL_DOCUMENT;
-        goto INVALID_PARSING;
-    }
-    else if(NULL == index)
-    {
-        result = PARADOX_XML1_PARSER_NULL_INDEX;
-        goto INVALID_PARSING;
-    }
-    const paradox_uint64_t base_index = *index;
+    if(NULL == reader) return PARADOX_XML1_PARSER_NULL_DOCUMENT;
+    *reader = NULL;
+    if(NULL == data) return PARADOX_XML1_PARSER_NULL_DOCUMENT;
+    paradox_xml1_reader* created = calloc(1, sizeof(paradox_xml1_reader));
+    if(NULL == created) return PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+    created->input.data = data;
+    created->input.length = length;
+    created->phase = PARADOX_XML1_READER_PROLOG;
+    created->error = PARADOX_XML1_PARSER_SUCCESS;
+    created->token = PARADOX_XML1_TOKEN_NONE;
+    *reader = created;
+    return PARADOX_XML1_PARSER_SUCCESS;
+}
 
-    if(strncmp(xml_string + *index, "PUBLIC", 6))
+PARADOX_XML_API void paradox_free_xml1_reader(paradox_xml1_reader* reader)
+{
+    if(NULL == reader) return;
+    free(reader->open);
+    free(reader->names);
+    free(reader->attributes);
+    free(reader->unique.slots);
+    free(reader->stream);
+    free(reader->buffer);
+    free(reader->included);
+    paradox_xml1_entities_free(reader->entities);
+    free(reader);
+}
+
+PARADOX_XML_API paradox_xml1_token_t paradox_next_xml1_token(paradox_xml1_reader* reader)
+{
+    if(NULL == reader) return PARADOX_XML1_TOKEN_ERROR;
+    reader->attribute_count = 0;
+    if(reader->streaming && PARADOX_XML1_READER_DONE != reader->phase)
     {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
+        if(PARADOX_FALSE == paradox_xml1_reader_buffered(reader))
+        {
+            reader->token = PARADOX_XML1_TOKEN_NONE;
+            return reader->token;
+        }
+        reader->scan_index = 0;
+        reader->scan_quote = 0;
     }
-    else (*index) += 6;
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_space(xml_string, index))
+    switch(reader->phase)
     {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
+        case PARADOX_XML1_READER_PROLOG:
+            if(PARADOX_FALSE == reader->declaration_seen)
+            {
+                if(!paradox_xml1_parser_accept(&reader->index, paradox_xml1_parser_xml_decl(&reader->input, reader->index)))
+                {
+                    reader->token = paradox_xml1_reader_fail(reader, PARADOX_XML1_PARSER_INVALID_DOCUMENT);
+                    break;
+                }
+                reader->declaration_seen = PARADOX_TRUE;
+            }
+            reader->token = paradox_xml1_reader_misc(reader);
+            break;
+        case PARADOX_XML1_READER_CONTENT:
+            if(reader->empty_element)
+            {
+                reader->empty_element = PARADOX_FALSE;
+                reader->token = paradox_xml1_reader_end_element(reader);
+            }
+            else reader->token = paradox_xml1_reader_content(reader);
+            break;
+        case PARADOX_XML1_READER_EPILOG:
+            reader->token = paradox_xml1_reader_misc(reader);
+            break;
+        case PARADOX_XML1_READER_DONE:
+            if(PARADOX_XML1_PARSER_SUCCESS == reader->error) reader->token = PARADOX_XML1_TOKEN_END_DOCUMENT;
+            else reader->token = PARADOX_XML1_TOKEN_ERROR;
+            break;
     }
-    if(PARADOX_XML1_PARSER_SUCCESS != paradox_parse_xml1_pubid_literal(xml_string, index))
-    {
-        result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
-        goto INVALID_PARSING;
+    // Entities the token ended are left right away, so a streaming reader checks what follows them in the stream first.
+    while(PARADOX_XML1_TOKEN_ERROR != reader->token && PARADOX_TRUE == paradox_xml1_reader_entity_ended(reader)) paradox_xml1_reader_leave(reader);
+    if(reader->streaming && 0 == reader->included_count) reader->input.length = reader->stream_length;
+    return reader->token;
+}
+
+PARADOX_XML_API paradox_xml1_token_t paradox_skip_xml1_subtree(paradox_xml1_reader* reader)
+{
+    if(NULL == reader) return PARADOX_XML1_TOKEN_ERROR;
+    if(PARADOX_XML1_TOKEN_START_ELEMENT != reader->token) return reader->token;
+    const paradox_uint64_t depth = reader->depth;
+    paradox_xml1_token_t token;
+    do token = paradox_next_xml1_token(reader);
+    while(PARADOX_XML1_TOKEN_ERROR != token && !(PARADOX_XML1_TOKEN_END_ELEMENT == token && reader->depth < depth));
+    return token;
+}
+
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_get_xml1_reader_error(const paradox_xml1_reader* reader)
+{
+    if(NULL == reader) return PARADOX_XML1_PARSER_NULL_DOCUMENT;
+    return reader->error;
+}
+
+PARADOX_XML_API paradox_uint64_t paradox_get_xml1_reader_depth(const paradox_xml1_reader* reader)
+{
+    if(NULL == reader) return 0;
+    return reader->depth;
+}
+
+PARADOX_XML_API paradox_xml1_slice paradox_get_xml1_reader_name(const paradox_xml1_reader* reader)
+{
+    const paradox_xml1_slice empty = { NULL, 0 };
+    if(NULL == reader) return empty;
+    switch(reader->token)
+    {
+        case PARADOX_XML1_TOKEN_START_ELEMENT:
+        case PARADOX_XML1_TOKEN_END_ELEMENT:
+        case PARADOX_XML1_TOKEN_PROCESSING_INSTRUCTION:
+            return reader->name;
+        default:
+            return empty;
     }
-    result = PARADOX_XML1_PARSER_SUCCESS;
+}
 
-    INVALID_PARSING:
-    if(result != PARADOX_XML1_PARSER_SUCCESS)
-    {
-        if(PARADOX_XML1_PARSER_NULL_INDEX != result) *index = base_index;
+PARADOX_XML_API paradox_xml1_slice paradox_get_xml1_reader_text(const paradox_xml1_reader* reader)
+{
+    const paradox_xml1_slice empty = { NULL, 0 };
+    if(NULL == reader) return empty;
+    switch(reader->token)
+    {
+        case PARADOX_XML1_TOKEN_TEXT:
+        case PARADOX_XML1_TOKEN_CDATA:
+        case PARADOX_XML1_TOKEN_PROCESSING_INSTRUCTION:
+        case PARADOX_XML1_TOKEN_COMMENT:
+            return reader->text;
+        default:
+            return empty;
     }
+}
 
-    return result;
-}
\ No newline at end of file
+PARADOX_XML_API paradox_uint64_t paradox_get_xml1_reader_attribute_count(const paradox_xml1_reader* reader)
+{
+    if(NULL == reader) return 0;
+    return reader->attribute_count;
+}
+
+PARADOX_XML_API paradox_bool8_t paradox_get_xml1_reader_attribute(const paradox_xml1_reader* reader, const paradox_uint64_t index, paradox_xml1_slice* name, paradox_xml1_slice* value)
+{
+    if(NULL == reader || index >= reader->attribute_count) return PARADOX_FALSE;
+    if(NULL != name) *name = reader->attributes[2 * index];
+    if(NULL != value) *value = reader->attributes[2 * index + 1];
+    return PARADOX_TRUE;
+}
@@ -0,0 +1,147 @@
+#ifndef PARADOX_SOFTWARE_C_HEADER_XML1_REFERENCES
+#define PARADOX_SOFTWARE_C_HEADER_XML1_REFERENCES
+
+#include <paradox-xml/defines.h>
+#include "xml1_characters.h"
+#include "xml1_scanner.h"
+#include <string.h>
+
+// Digits are read 8 to a word on targets whose words load little-endian, and one at a time elsewhere.
+#if defined(_MSC_VER) || (defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    #define PARADOX_XML1_REFERENCES_SWAR
+#endif
+
+#ifdef PARADOX_XML1_REFERENCES_SWAR
+// Sets bit 7 of every byte of word that lies between low and high, both ASCII.
+static inline paradox_uint64_t paradox_xml1_references_between(const paradox_uint64_t word, const unsigned char low, const unsigned char high)
+{
+    // Without their top bit the bytes cannot carry into each other; bytes that had it are not ASCII.
+    const paradox_uint64_t ascii = word & 0x7F7F7F7F7F7F7F7FULL;
+    return (ascii + (0x80 - low) * 0x0101010101010101ULL) & ~(ascii + (0x7F - high) * 0x0101010101010101ULL) & ~word & 0x8080808080808080ULL;
+}
+
+// Value of the first count decimal digits of word, with 0 < count <= 8.
+static inline paradox_uint32_t paradox_xml1_references_decimal(paradox_uint64_t word, const paradox_uint64_t count)
+{
+    // The digits move to the top, behind as many zeros as they are short of 8.
+    word = (word & 0x0F0F0F0F0F0F0F0FULL) << (8 * (8 - count));
+    word = (word * 10 + (word >> 8)) & 0x00FF00FF00FF00FFULL;
+    word = (word * 100 + (word >> 16)) & 0x0000FFFF0000FFFFULL;
+    return (paradox_uint32_t)(word * 10000 + (word >> 32));
+}
+
+// Value of the first count hexadecimal digits of word, with 0 < count <= 8.
+static inline paradox_uint32_t paradox_xml1_references_hexadecimal(paradox_uint64_t word, const paradox_uint64_t count)
+{
+    // Letters have bit 6 set and their low nibble 9 short of their value.
+    word = ((word & 0x0F0F0F0F0F0F0F0FULL) + 9 * ((word >> 6) & 0x0101010101010101ULL)) << (8 * (8 - count));
+    word = ((word << 4) | (word >> 8)) & 0x00FF00FF00FF00FFULL;
+    word = ((word << 8) | (word >> 16)) & 0x0000FFFF0000FFFFULL;
+    return (paradox_uint32_t)((word << 16) | (word >> 32));
+}
+#endif
+
+// Decodes the CharRef at reference, of which available bytes may be read, into code. Returns its length up to and
+// including the ';', or 0 when there is none or it refers to a character that [WFC: Legal Character] rules out.
+static inline paradox_uint64_t paradox_xml1_decode_char_ref(const char* reference, const paradox_uint64_t available, paradox_uint32_t* code)
+{
+    if(available < 4 || '&' != reference[0] || '#' != reference[1]) return 0;
+    const paradox_bool8_t hexadecimal = 'x' == reference[2];
+    const paradox_uint64_t digits = hexadecimal ? 3 : 2;
+    paradox_uint64_t index = digits;
+    paradox_uint32_t value = 0;
+#ifdef PARADOX_XML1_REFERENCES_SWAR
+    // Up to 8 digits and the ';' after them in one word. Longer references have leading zeros and are left to the loop.
+    if(available - digits > 8)
+    {
+        paradox_uint64_t word;
+        memcpy(&word, reference + digits, 8);
+        const paradox_uint64_t matched = hexadecimal
+            ?   paradox_xml1_references_between(word, '0', '9') | paradox_xml1_references_between(word | 0x2020202020202020ULL, 'a', 'f')
+            :   paradox_xml1_references_between(word, '0', '9');
+        const paradox_uint64_t others = ~matched & 0x8080808080808080ULL;
+        if(0 != others)
+        {
+            const paradox_uint64_t count = paradox_xml1_scanner_first_bit(others) / 8;
+            if(0 == count || ';' != reference[digits + count]) return 0;
+            *code = hexadecimal ? paradox_xml1_references_hexadecimal(word, count) : paradox_xml1_references_decimal(word, count);
+            return paradox_xml1_classify(*code) & (PARADOX_XML1_CHARACTER_CHAR | PARADOX_XML1_CHARACTER_RESTRICTED) ? digits + count + 1 : 0;
+        }
+    }
+#endif
+    for(; index < available; index++)
+    {
+        const char digit = reference[index];
+        if('0' <= digit && digit <= '9') value = value * (hexadecimal ? 16 : 10) + (paradox_uint32_t)(digit - '0');
+        else if(PARADOX_TRUE == hexadecimal && 'a' <= (digit | 0x20) && (digit | 0x20) <= 'f') value = value * 16 + (paradox_uint32_t)((digit | 0x20) - 'a' + 10);
+        else break;
+        // Past the last code point every value is as illegal as any other, and leading zeros can make it arbitrarily long.
+        if(value > 0x10FFFF) value = 0x110000;
+    }
+    if(digits == index || index == available || ';' != reference[index]) return 0;
+    *code = value;
+    return paradox_xml1_classify(value) & (PARADOX_XML1_CHARACTER_CHAR | PARADOX_XML1_CHARACTER_RESTRICTED) ? index + 1 : 0;
+}
+
+// The character the EntityRef of length bytes at reference stands for when it names a predefined entity, or '\0'.
+static inline char paradox_xml1_decode_predefined(const char* reference, const paradox_uint64_t length)
+{
+    if(4 == length && !strncmp(reference, "&lt;", 4)) return '<';
+    if(4 == length && !strncmp(reference, "&gt;", 4)) return '>';
+    if(5 == length && !strncmp(reference, "&amp;", 5)) return '&';
+    if(6 == length && !strncmp(reference, "&apos;", 6)) return '\'';
+    if(6 == length && !strncmp(reference, "&quot;", 6)) return '"';
+    return '\0';
+}
+
+// Decodes the run of References that have already been recognized at references, of which available bytes may be
+// read, appending their replacement to output at output_length. Character references are written to output as UTF-8
+// straight away. The parsers resolve references to the other entities through the entity table of the document, and
+// only leave behind those to entities that were not read, which are kept as they are written. Returns the bytes the run spans.
+static inline paradox_uint64_t paradox_xml1_decode_references(const char* references, const paradox_uint64_t available, char* output, paradox_uint64_t* output_length)
+{
+    paradox_uint64_t index = 0;
+    do
+    {
+        const char* reference = references + index;
+        paradox_uint32_t code = 0;
+        paradox_uint64_t length = '#' == reference[1] ? paradox_xml1_decode_char_ref(reference, available - index, &code) : 0;
+        if(0 != length) *output_length += paradox_xml1_encode_utf8(code, output + *output_length);
+        else
+        {
+            length = (paradox_uint64_t)((const char*)memchr(reference, ';', available - index) - reference) + 1;
+            const char replacement = paradox_xml1_decode_predefined(reference, length);
+            if('\0' != replacement) output[(*output_length)++] = replacement;
+            else
+            {
+                memmove(output + *output_length, reference, length);
+                *output_length += length;
+            }
+        }
+        index += length;
+    }
+    while(index < available && '&' == references[index]);
+    return index;
+}
+
+// Decodes the references of an attribute value or character data that has already been recognized into output.
+// A reference never decodes to more bytes than it is written with, so output needs at most length bytes and may
+// be value itself to decode in place.
+static inline paradox_uint64_t paradox_xml1_decode_value(const char* value, const paradox_uint64_t length, char* output)
+{
+    paradox_uint64_t index = 0;
+    paradox_uint64_t output_length = 0;
+    const char* reference = (const char*)memchr(value, '&', length);
+    while(NULL != reference)
+    {
+        const paradox_uint64_t reference_index = (paradox_uint64_t)(reference - value);
+        memmove(output + output_length, value + index, reference_index - index);
+        output_length += reference_index - index;
+        index = reference_index + paradox_xml1_decode_references(reference, length - reference_index, output, &output_length);
+        reference = (const char*)memchr(value + index, '&', length - index);
+    }
+    memmove(output + output_length, value + index, length - index);
+    return output_length + (length - index);
+}
+
+#endif
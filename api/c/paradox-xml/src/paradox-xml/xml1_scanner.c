@@ -0,0 +1,622 @@
+#include <paradox-xml/xml1_parser.h>
+#include "xml1_scanner.h"
+#include "xml1_characters.h"
+#include <string.h>
+
+// Every kernel set is compiled into the library and the best one the CPU supports is selected at
+// load time. GCC and Clang need the instruction set of each kernel as a target attribute, MSVC
+// accepts the intrinsics anywhere.
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    #define PARADOX_XML1_SCANNER_X86
+    #include <immintrin.h>
+    #ifdef _MSC_VER
+        #include <intrin.h>
+    #else
+        #include <cpuid.h>
+    #endif
+#endif
+#if defined(__GNUC__) || defined(__clang__)
+    #define PARADOX_XML1_SCANNER_TARGET(isa) __attribute__((target(isa)))
+#else
+    #define PARADOX_XML1_SCANNER_TARGET(isa)
+#endif
+
+// Scalar
+
+static inline paradox_bool8_t paradox_xml1_scanner_invalid(const unsigned char byte)
+{
+    if(byte < 0x20) return 0x9 != byte && 0xA != byte && 0xD != byte;
+    return byte >= 0x7F;
+}
+
+static inline paradox_bool8_t paradox_xml1_scanner_char_data_stop(const unsigned char byte, const paradox_bool8_t validated)
+{
+    if('<' == byte || '&' == byte || ']' == byte) return PARADOX_TRUE;
+    return !validated && paradox_xml1_scanner_invalid(byte);
+}
+
+static paradox_uint64_t paradox_xml1_scan_char_data_scalar(const char* data, const paradox_uint64_t length, const paradox_bool8_t validated)
+{
+    paradox_uint64_t offset = 0;
+    while(offset < length && !paradox_xml1_scanner_char_data_stop((unsigned char)data[offset], validated)) offset++;
+    return offset;
+}
+
+typedef struct paradox_xml1_scanner_terminators
+{
+    const char* terminator;
+    paradox_uint64_t terminator_length;
+    const char* alternative;
+    paradox_uint64_t alternative_length;
+    paradox_bool8_t validated;
+
+} paradox_xml1_scanner_terminators;
+
+// Whether one of the terminators starts at offset.
+static inline paradox_bool8_t paradox_xml1_scanner_terminates(const char* data, const paradox_uint64_t length, const paradox_uint64_t offset, const paradox_xml1_scanner_terminators* terminators)
+{
+    const paradox_uint64_t available = length - offset;
+    if(available >= terminators->terminator_length && !memcmp(data + offset, terminators->terminator, terminators->terminator_length)) return PARADOX_TRUE;
+    if(NULL == terminators->alternative) return PARADOX_FALSE;
+    return available >= terminators->alternative_length && !memcmp(data + offset, terminators->alternative, terminators->alternative_length);
+}
+
+// Finishes a terminator scan from offset one byte at a time, for the scalar kernel and the tails of the vector kernels.
+static paradox_uint64_t paradox_xml1_scanner_terminator_tail(const char* data, const paradox_uint64_t length, const paradox_uint64_t from, const paradox_xml1_scanner_terminators* terminators)
+{
+    const char first = terminators->terminator[0];
+    const char alternative_first = NULL != terminators->alternative ? terminators->alternative[0] : first;
+    for(paradox_uint64_t offset = from; offset < length; offset++)
+    {
+        const char byte = data[offset];
+        if(!terminators->validated && paradox_xml1_scanner_invalid((unsigned char)byte)) return offset;
+        if((first == byte || alternative_first == byte) && paradox_xml1_scanner_terminates(data, length, offset, terminators)) return offset;
+    }
+    return length;
+}
+
+static paradox_uint64_t paradox_xml1_scan_terminator_scalar(const char* data, const paradox_uint64_t length, const paradox_xml1_scanner_terminators* terminators)
+{
+    return paradox_xml1_scanner_terminator_tail(data, length, 0, terminators);
+}
+
+// Walks the candidate and invalid bits of one vector of bytes starting at offset in order.
+// Returns the offset of the first hit, or length when the vector holds none.
+static inline paradox_uint64_t paradox_xml1_scanner_resolve(const char* data, const paradox_uint64_t length, const paradox_uint64_t offset, paradox_uint64_t candidates, const paradox_uint64_t invalid, const paradox_xml1_scanner_terminators* terminators)
+{
+    const paradox_uint32_t first_invalid = invalid ? paradox_xml1_scanner_first_bit(invalid) : 64;
+    while(candidates)
+    {
+        const paradox_uint32_t bit = paradox_xml1_scanner_first_bit(candidates);
+        if(bit > first_invalid) break;
+        if(paradox_xml1_scanner_terminates(data, length, offset + bit, terminators)) return offset + bit;
+        candidates &= candidates - 1;
+    }
+    return invalid ? offset + first_invalid : length;
+}
+
+// Validates the multi-byte sequences and ASCII exceptions from offset up to the next byte that
+// starts a plain ASCII character again. Returns that offset, or the offset of the first byte that
+// does not start a Char.
+static paradox_uint64_t paradox_xml1_validate_sequences(const char* data, const paradox_uint64_t length, paradox_uint64_t offset)
+{
+    while(offset < length)
+    {
+        const unsigned char byte = (unsigned char)data[offset];
+        if(byte < 0x80 && !paradox_xml1_scanner_invalid(byte)) return offset;
+        size_t width;
+        const paradox_uint32_t code = paradox_xml1_decode_utf8((const unsigned char*)data + offset, length - offset, &width);
+        if(0 == width || !(paradox_xml1_classify(code) & PARADOX_XML1_CHARACTER_CHAR)) return offset;
+        offset += width;
+    }
+    return length;
+}
+
+static paradox_uint64_t paradox_xml1_validate_scalar(const char* data, const paradox_uint64_t length)
+{
+    paradox_uint64_t offset = 0;
+    while(offset < length)
+    {
+        while(offset < length && !paradox_xml1_scanner_invalid((unsigned char)data[offset])) offset++;
+        const paradox_uint64_t end = paradox_xml1_validate_sequences(data, length, offset);
+        if(end == offset) return offset;
+        offset = end;
+    }
+    return length;
+}
+
+static inline paradox_bool8_t paradox_xml1_scanner_structural(const unsigned char byte)
+{
+    switch(byte)
+    {
+        case '<': case '>': case '&': case '=': case '"': case '\'': case '/': case ']': return PARADOX_TRUE;
+    }
+    return PARADOX_FALSE;
+}
+
+// Sets the bit of every structural byte among length bytes, one word per 64 of them.
+static void paradox_xml1_scan_structurals_scalar(const char* data, const paradox_uint64_t length, paradox_uint64_t* bitmap)
+{
+    for(paradox_uint64_t word = 0; word * 64 < length; word++) bitmap[word] = 0;
+    for(paradox_uint64_t offset = 0; offset < length; offset++)
+    {
+        if(paradox_xml1_scanner_structural((unsigned char)data[offset])) bitmap[offset / 64] |= (paradox_uint64_t)1 << (offset % 64);
+    }
+}
+
+#ifdef PARADOX_XML1_SCANNER_X86
+
+// SSE2
+
+// A signed comparison against #x20 catches the control characters and, since they are negative,
+// every byte from #x80 up. Tab, line feed and carriage return are taken back out.
+PARADOX_XML1_SCANNER_TARGET("sse2")
+static inline paradox_uint64_t paradox_xml1_scanner_invalid_mask_sse2(const __m128i bytes)
+{
+    const __m128i space = _mm_or_si128(
+        _mm_cmpeq_epi8(bytes, _mm_set1_epi8(0x9)),
+        _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8(0xA)), _mm_cmpeq_epi8(bytes, _mm_set1_epi8(0xD))));
+    const __m128i other = _mm_andnot_si128(space, _mm_cmplt_epi8(bytes, _mm_set1_epi8(0x20)));
+    return (paradox_uint32_t)_mm_movemask_epi8(_mm_or_si128(other, _mm_cmpeq_epi8(bytes, _mm_set1_epi8(0x7F))));
+}
+
+// Validated input only needs the markup bytes.
+PARADOX_XML1_SCANNER_TARGET("sse2")
+static inline paradox_uint64_t paradox_xml1_scanner_char_data_mask_sse2(const __m128i bytes, const paradox_bool8_t validated)
+{
+    const __m128i markup = _mm_or_si128(
+        _mm_cmpeq_epi8(bytes, _mm_set1_epi8('<')),
+        _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('&')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8(']'))));
+    const paradox_uint64_t mask = (paradox_uint32_t)_mm_movemask_epi8(markup);
+    return validated ? mask : mask | paradox_xml1_scanner_invalid_mask_sse2(bytes);
+}
+
+PARADOX_XML1_SCANNER_TARGET("sse2")
+static paradox_uint64_t paradox_xml1_scan_char_data_sse2(const char* data, const paradox_uint64_t length, const paradox_bool8_t validated)
+{
+    paradox_uint64_t offset = 0;
+    for(; length - offset >= 16; offset += 16)
+    {
+        const paradox_uint64_t mask = paradox_xml1_scanner_char_data_mask_sse2(_mm_loadu_si128((const __m128i*)(data + offset)), validated);
+        if(mask) return offset + paradox_xml1_scanner_first_bit(mask);
+    }
+    return offset + paradox_xml1_scan_char_data_scalar(data + offset, length - offset, validated);
+}
+
+PARADOX_XML1_SCANNER_TARGET("sse2")
+static paradox_uint64_t paradox_xml1_scan_terminator_sse2(const char* data, const paradox_uint64_t length, const paradox_xml1_scanner_terminators* terminators)
+{
+    const __m128i first = _mm_set1_epi8(terminators->terminator[0]);
+    const __m128i alternative_first = _mm_set1_epi8(NULL != terminators->alternative ? terminators->alternative[0] : terminators->terminator[0]);
+    paradox_uint64_t offset = 0;
+    for(; length - offset >= 16; offset += 16)
+    {
+        const __m128i bytes = _mm_loadu_si128((const __m128i*)(data + offset));
+        const paradox_uint64_t candidates = (paradox_uint32_t)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(bytes, first), _mm_cmpeq_epi8(bytes, alternative_first)));
+        const paradox_uint64_t invalid = terminators->validated ? 0 : paradox_xml1_scanner_invalid_mask_sse2(bytes);
+        if(0 == (candidates | invalid)) continue;
+        const paradox_uint64_t found = paradox_xml1_scanner_resolve(data, length, offset, candidates, invalid, terminators);
+        if(found != length) return found;
+    }
+    return paradox_xml1_scanner_terminator_tail(data, length, offset, terminators);
+}
+
+PARADOX_XML1_SCANNER_TARGET("sse2")
+static paradox_uint64_t paradox_xml1_validate_sse2(const char* data, const paradox_uint64_t length)
+{
+    paradox_uint64_t offset = 0;
+    while(length - offset >= 16)
+    {
+        const paradox_uint64_t mask = paradox_xml1_scanner_invalid_mask_sse2(_mm_loadu_si128((const __m128i*)(data + offset)));
+        if(0 == mask)
+        {
+            offset += 16;
+            continue;
+        }
+        offset += paradox_xml1_scanner_first_bit(mask);
+        const paradox_uint64_t end = paradox_xml1_validate_sequences(data, length, offset);
+        if(end == offset) return offset;
+        offset = end;
+    }
+    return offset + paradox_xml1_validate_scalar(data + offset, length - offset);
+}
+
+PARADOX_XML1_SCANNER_TARGET("sse2")
+static inline paradox_uint64_t paradox_xml1_scanner_structural_mask_sse2(const __m128i bytes)
+{
+    const __m128i tags = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('<')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('>'))),
+        _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('/')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('='))));
+    const __m128i values = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('"')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\''))),
+        _mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('&')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8(']'))));
+    return (paradox_uint32_t)_mm_movemask_epi8(_mm_or_si128(tags, values));
+}
+
+PARADOX_XML1_SCANNER_TARGET("sse2")
+static void paradox_xml1_scan_structurals_sse2(const char* data, const paradox_uint64_t length, paradox_uint64_t* bitmap)
+{
+    paradox_uint64_t offset = 0;
+    for(; length - offset >= 64; offset += 64)
+    {
+        bitmap[offset / 64] = paradox_xml1_scanner_structural_mask_sse2(_mm_loadu_si128((const __m128i*)(data + offset)))
+            | paradox_xml1_scanner_structural_mask_sse2(_mm_loadu_si128((const __m128i*)(data + offset + 16))) << 16
+            | paradox_xml1_scanner_structural_mask_sse2(_mm_loadu_si128((const __m128i*)(data + offset + 32))) << 32
+            | paradox_xml1_scanner_structural_mask_sse2(_mm_loadu_si128((const __m128i*)(data + offset + 48))) << 48;
+    }
+    paradox_xml1_scan_structurals_scalar(data + offset, length - offset, bitmap + offset / 64);
+}
+
+// SSE4.2
+
+// PCMPESTRI matches all stops of CharData as byte ranges in one instruction. The terminator and
+// validation kernels gain nothing from it and stay with SSE2.
+PARADOX_XML1_SCANNER_TARGET("sse4.2")
+static paradox_uint64_t paradox_xml1_scan_char_data_sse42(const char* data, const paradox_uint64_t length, const paradox_bool8_t validated)
+{
+    const __m128i markup = _mm_setr_epi8('<', '&', ']', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i ranges = _mm_setr_epi8('<', '<', '&', '&', ']', ']', 0x00, 0x08, 0x0B, 0x0C, 0x0E, 0x1F, 0x7F, (char)0xFF, 0, 0);
+    paradox_uint64_t offset = 0;
+    for(; length - offset >= 16; offset += 16)
+    {
+        const __m128i bytes = _mm_loadu_si128((const __m128i*)(data + offset));
+        const int found = validated
+            ? _mm_cmpestri(markup, 3, bytes, 16, _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_LEAST_SIGNIFICANT)
+            : _mm_cmpestri(ranges, 14, bytes, 16, _SIDD_UBYTE_OPS | _SIDD_CMP_RANGES | _SIDD_LEAST_SIGNIFICANT);
+        if(found < 16) return offset + (paradox_uint64_t)found;
+    }
+    return offset + paradox_xml1_scan_char_data_scalar(data + offset, length - offset, validated);
+}
+
+// PCMPESTRM matches the eight structural bytes in one instruction and returns their bits.
+PARADOX_XML1_SCANNER_TARGET("sse4.2")
+static inline paradox_uint64_t paradox_xml1_scanner_structural_mask_sse42(const __m128i bytes)
+{
+    const __m128i structurals = _mm_setr_epi8('<', '>', '&', '=', '"', '\'', '/', ']', 0, 0, 0, 0, 0, 0, 0, 0);
+    return (paradox_uint32_t)_mm_cvtsi128_si32(_mm_cmpestrm(structurals, 8, bytes, 16, _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ANY | _SIDD_BIT_MASK));
+}
+
+PARADOX_XML1_SCANNER_TARGET("sse4.2")
+static void paradox_xml1_scan_structurals_sse42(const char* data, const paradox_uint64_t length, paradox_uint64_t* bitmap)
+{
+    paradox_uint64_t offset = 0;
+    for(; length - offset >= 64; offset += 64)
+    {
+        bitmap[offset / 64] = paradox_xml1_scanner_structural_mask_sse42(_mm_loadu_si128((const __m128i*)(data + offset)))
+            | paradox_xml1_scanner_structural_mask_sse42(_mm_loadu_si128((const __m128i*)(data + offset + 16))) << 16
+            | paradox_xml1_scanner_structural_mask_sse42(_mm_loadu_si128((const __m128i*)(data + offset + 32))) << 32
+            | paradox_xml1_scanner_structural_mask_sse42(_mm_loadu_si128((const __m128i*)(data + offset + 48))) << 48;
+    }
+    paradox_xml1_scan_structurals_scalar(data + offset, length - offset, bitmap + offset / 64);
+}
+
+// AVX2
+
+// Same classification as the SSE2 kernels, 32 bytes at a time.
+PARADOX_XML1_SCANNER_TARGET("avx2")
+static inline paradox_uint64_t paradox_xml1_scanner_invalid_mask_avx2(const __m256i bytes)
+{
+    const __m256i space = _mm256_or_si256(
+        _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(0x9)),
+        _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(0xA)), _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(0xD))));
+    const __m256i other = _mm256_andnot_si256(space, _mm256_cmpgt_epi8(_mm256_set1_epi8(0x20), bytes));
+    return (paradox_uint32_t)_mm256_movemask_epi8(_mm256_or_si256(other, _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(0x7F))));
+}
+
+PARADOX_XML1_SCANNER_TARGET("avx2")
+static inline paradox_uint64_t paradox_xml1_scanner_char_data_mask_avx2(const __m256i bytes, const paradox_bool8_t validated)
+{
+    const __m256i markup = _mm256_or_si256(
+        _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('<')),
+        _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('&')), _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(']'))));
+    const paradox_uint64_t mask = (paradox_uint32_t)_mm256_movemask_epi8(markup);
+    return validated ? mask : mask | paradox_xml1_scanner_invalid_mask_avx2(bytes);
+}
+
+PARADOX_XML1_SCANNER_TARGET("avx2")
+static paradox_uint64_t paradox_xml1_scan_char_data_avx2(const char* data, const paradox_uint64_t length, const paradox_bool8_t validated)
+{
+    paradox_uint64_t offset = 0;
+    for(; length - offset >= 32; offset += 32)
+    {
+        const paradox_uint64_t mask = paradox_xml1_scanner_char_data_mask_avx2(_mm256_loadu_si256((const __m256i*)(data + offset)), validated);
+        if(mask) return offset + paradox_xml1_scanner_first_bit(mask);
+    }
+    return offset + paradox_xml1_scan_char_data_scalar(data + offset, length - offset, validated);
+}
+
+PARADOX_XML1_SCANNER_TARGET("avx2")
+static paradox_uint64_t paradox_xml1_scan_terminator_avx2(const char* data, const paradox_uint64_t length, const paradox_xml1_scanner_terminators* terminators)
+{
+    const __m256i first = _mm256_set1_epi8(terminators->terminator[0]);
+    const __m256i alternative_first = _mm256_set1_epi8(NULL != terminators->alternative ? terminators->alternative[0] : terminators->terminator[0]);
+    paradox_uint64_t offset = 0;
+    for(; length - offset >= 32; offset += 32)
+    {
+        const __m256i bytes = _mm256_loadu_si256((const __m256i*)(data + offset));
+        const paradox_uint64_t candidates = (paradox_uint32_t)_mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(bytes, first), _mm256_cmpeq_epi8(bytes, alternative_first)));
+        const paradox_uint64_t invalid = terminators->validated ? 0 : paradox_xml1_scanner_invalid_mask_avx2(bytes);
+        if(0 == (candidates | invalid)) continue;
+        const paradox_uint64_t found = paradox_xml1_scanner_resolve(data, length, offset, candidates, invalid, terminators);
+        if(found != length) return found;
+    }
+    return paradox_xml1_scanner_terminator_tail(data, length, offset, terminators);
+}
+
+PARADOX_XML1_SCANNER_TARGET("avx2")
+static paradox_uint64_t paradox_xml1_validate_avx2(const char* data, const paradox_uint64_t length)
+{
+    paradox_uint64_t offset = 0;
+    while(length - offset >= 32)
+    {
+        const paradox_uint64_t mask = paradox_xml1_scanner_invalid_mask_avx2(_mm256_loadu_si256((const __m256i*)(data + offset)));
+        if(0 == mask)
+        {
+            offset += 32;
+            continue;
+        }
+        offset += paradox_xml1_scanner_first_bit(mask);
+        const paradox_uint64_t end = paradox_xml1_validate_sequences(data, length, offset);
+        if(end == offset) return offset;
+        offset = end;
+    }
+    return offset + paradox_xml1_validate_scalar(data + offset, length - offset);
+}
+
+PARADOX_XML1_SCANNER_TARGET("avx2")
+static inline paradox_uint64_t paradox_xml1_scanner_structural_mask_avx2(const __m256i bytes)
+{
+    const __m256i tags = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('<')), _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('>'))),
+        _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('/')), _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('='))));
+    const __m256i values = _mm256_or_si256(
+        _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('"')), _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('\''))),
+        _mm256_or_si256(_mm256_cmpeq_epi8(bytes, _mm256_set1_epi8('&')), _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(']'))));
+    return (paradox_uint32_t)_mm256_movemask_epi8(_mm256_or_si256(tags, values));
+}
+
+PARADOX_XML1_SCANNER_TARGET("avx2")
+static void paradox_xml1_scan_structurals_avx2(const char* data, const paradox_uint64_t length, paradox_uint64_t* bitmap)
+{
+    paradox_uint64_t offset = 0;
+    for(; length - offset >= 64; offset += 64)
+    {
+        bitmap[offset / 64] = paradox_xml1_scanner_structural_mask_avx2(_mm256_loadu_si256((const __m256i*)(data + offset)))
+            | paradox_xml1_scanner_structural_mask_avx2(_mm256_loadu_si256((const __m256i*)(data + offset + 32))) << 32;
+    }
+    paradox_xml1_scan_structurals_scalar(data + offset, length - offset, bitmap + offset / 64);
+}
+
+// AVX-512BW
+
+// Same classification again, 64 bytes at a time straight into mask registers.
+PARADOX_XML1_SCANNER_TARGET("avx512bw")
+static inline paradox_uint64_t paradox_xml1_scanner_invalid_mask_avx512(const __m512i bytes)
+{
+    const __mmask64 space = _mm512_cmpeq_epi8_mask(bytes, _mm512_set1_epi8(0x9))
+        | _mm512_cmpeq_epi8_mask(bytes, _mm512_set1_epi8(0xA))
+        | _mm512_cmpeq_epi8_mask(bytes, _mm512_set1_epi8(0xD));
+    return (_mm512_cmplt_epi8_mask(bytes, _mm512_set1_epi8(0x20)) & ~space) | _mm512_cmpeq_epi8_mask(bytes, _mm512_set1_epi8(0x7F));
+}
+
+PARADOX_XML1_SCANNER_TARGET("avx512bw")
+static inline paradox_uint64_t paradox_xml1_scanner_char_data_mask_avx512(const __m512i bytes, const paradox_bool8_t validated)
+{
+    const paradox_uint64_t mask = _mm512_cmpeq_epi8_mask(bytes, _mm512_set1_epi8('<'))
+        | _mm512_cmpeq_epi8_mask(bytes, _mm512_set1_epi8('&'))
+        | _mm512_cmpeq_epi8_mask(bytes, _mm512_set1_epi8(']'));
+    return validated ? mask : mask | paradox_xml1_scanner_invalid_mask_avx512(bytes);
+}
+
+PARADOX_XML1_SCANNER_TARGET("avx512bw")
+static paradox_uint64_t paradox_xml1_scan_char_data_avx512(const char* data, const paradox_uint64_t length, const paradox_bool8_t validated)
+{
+    paradox_uint64_t offset = 0;
+    for(; length - offset >= 64; offset += 64)
+    {
+        const paradox_uint64_t mask = paradox_xml1_scanner_char_data_mask_avx512(_mm512_loadu_si512((const void*)(data + offset)), validated);
+        if(mask) return offset + paradox_xml1_scanner_first_bit(mask);
+    }
+    return offset + paradox_xml1_scan_char_data_scalar(data + offset, length - offset, validated);
+}
+
+PARADOX_XML1_SCANNER_TARGET("avx512bw")
+static paradox_uint64_t paradox_xml1_scan_terminator_avx512(const char* data, const paradox_uint64_t length, const paradox_xml1_scanner_terminators* terminators)
+{
+    const __m512i first = _mm512_set1_epi8(terminators->terminator[0]);
+    const __m512i alternative_first = _mm512_set1_epi8(NULL != terminators->alternative ? terminators->alternative[0] : terminators->terminator[0]);
+    paradox_uint64_t offset = 0;
+    for(; length - offset >= 64; offset += 64)
+    {
+        const __m512i bytes = _mm512_loadu_si512((const void*)(data + offset));
+        const paradox_uint64_t candidates = _mm512_cmpeq_epi8_mask(bytes, first) | _mm512_cmpeq_epi8_mask(bytes, alternative_first);
+        const paradox_uint64_t invalid = terminators->validated ? 0 : paradox_xml1_scanner_invalid_mask_avx512(bytes);
+        if(0 == (candidates | invalid)) continue;
+        const paradox_uint64_t found = paradox_xml1_scanner_resolve(data, length, offset, candidates, invalid, terminators);
+        if(found != length) return found;
+    }
+    return paradox_xml1_scanner_terminator_tail(data, length, offset, terminators);
+}
+
+PARADOX_XML1_SCANNER_TARGET("avx512bw")
+static paradox_uint64_t paradox_xml1_validate_avx512(const char* data, const paradox_uint64_t length)
+{
+    paradox_uint64_t offset = 0;
+    while(length - offset >= 64)
+    {
+        const paradox_uint64_t mask = paradox_xml1_scanner_invalid_mask_avx512(_mm512_loadu_si512((const void*)(data + offset)));
+        if(0 == mask)
+        {
+            offset += 64;
+            continue;
+        }
+        offset += paradox_xml1_scanner_first_bit(mask);
+        const paradox_uint64_t end = paradox_xml1_validate_sequences(data, length, offset);
+        if(end == offset) return offset;
+        offset = end;
+    }
+    return offset + paradox_xml1_validate_scalar(data + offset, length - offset);
+}
+
+PARADOX_XML1_SCANNER_TARGET("avx512bw")
+static void paradox_xml1_scan_structurals_avx512(const char* data, const paradox_uint64_t length, paradox_uint64_t* bitmap)
+{
+    paradox_uint64_t offset = 0;
+    for(; length - offset >= 64; offset += 64)
+    {
+        const __m512i bytes = _mm512_loadu_si512((const void*)(data + offset));
+        bitmap[offset / 64] = _mm512_cmpeq_epi8_mask(bytes, _mm512_set1_epi8('<'))
+            | _mm512_cmpeq_epi8_mask(bytes, _mm512_set1_epi8('>'))
+            | _mm512_cmpeq_epi8_mask(bytes, _mm512_set1_epi8('&'))
+            | _mm512_cmpeq_epi8_mask(bytes, _mm512_set1_epi8('='))
+            | _mm512_cmpeq_epi8_mask(bytes, _mm512_set1_epi8('"'))
+            | _mm512_cmpeq_epi8_mask(bytes, _mm512_set1_epi8('\''))
+            | _mm512_cmpeq_epi8_mask(bytes, _mm512_set1_epi8('/'))
+            | _mm512_cmpeq_epi8_mask(bytes, _mm512_set1_epi8(']'));
+    }
+    paradox_xml1_scan_structurals_scalar(data + offset, length - offset, bitmap + offset / 64);
+}
+
+#endif
+
+// Dispatch
+
+typedef struct paradox_xml1_scanner_kernels
+{
+    paradox_uint64_t (*scan_char_data)(const char* data, const paradox_uint64_t length, const paradox_bool8_t validated);
+    paradox_uint64_t (*scan_terminator)(const char* data, const paradox_uint64_t length, const paradox_xml1_scanner_terminators* terminators);
+    paradox_uint64_t (*validate)(const char* data, const paradox_uint64_t length);
+    void (*scan_structurals)(const char* data, const paradox_uint64_t length, paradox_uint64_t* bitmap);
+
+} paradox_xml1_scanner_kernels;
+
+// Indexed by paradox_xml1_kernel_t.
+static const paradox_xml1_scanner_kernels paradox_xml1_scanner_kernel_sets[] =
+{
+    { paradox_xml1_scan_char_data_scalar, paradox_xml1_scan_terminator_scalar, paradox_xml1_validate_scalar, paradox_xml1_scan_structurals_scalar },
+#ifdef PARADOX_XML1_SCANNER_X86
+    { paradox_xml1_scan_char_data_sse2, paradox_xml1_scan_terminator_sse2, paradox_xml1_validate_sse2, paradox_xml1_scan_structurals_sse2 },
+    { paradox_xml1_scan_char_data_sse42, paradox_xml1_scan_terminator_sse2, paradox_xml1_validate_sse2, paradox_xml1_scan_structurals_sse42 },
+    { paradox_xml1_scan_char_data_avx2, paradox_xml1_scan_terminator_avx2, paradox_xml1_validate_avx2, paradox_xml1_scan_structurals_avx2 },
+    { paradox_xml1_scan_char_data_avx512, paradox_xml1_scan_terminator_avx512, paradox_xml1_validate_avx512, paradox_xml1_scan_structurals_avx512 }
+#endif
+};
+
+#ifdef PARADOX_XML1_SCANNER_X86
+// Queries leaf, subleaf 0, into eax, ebx, ecx and edx. Fails when the CPU does not have the leaf.
+static paradox_bool8_t paradox_xml1_scanner_cpuid(const unsigned int leaf, unsigned int registers[4])
+{
+#ifdef _MSC_VER
+    int values[4];
+    __cpuid(values, 0);
+    if((unsigned int)values[0] < leaf) return PARADOX_FALSE;
+    __cpuidex(values, (int)leaf, 0);
+    for(int i = 0; i < 4; i++) registers[i] = (unsigned int)values[i];
+#else
+    if(__get_cpuid_max(0, NULL) < leaf) return PARADOX_FALSE;
+    __cpuid_count(leaf, 0, registers[0], registers[1], registers[2], registers[3]);
+#endif
+    return PARADOX_TRUE;
+}
+
+// The register states the operating system saves on context switches, XCR0.
+static paradox_uint64_t paradox_xml1_scanner_xgetbv(void)
+{
+#ifdef _MSC_VER
+    return _xgetbv(0);
+#else
+    unsigned int eax, edx;
+    __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return ((paradox_uint64_t)edx << 32) | eax;
+#endif
+}
+#endif
+
+// The wider kernels also need the operating system to save their registers, which XCR0 reports:
+// the SSE and AVX state for AVX2, and the opmask and upper ZMM state on top for AVX-512.
+static paradox_xml1_kernel_t paradox_xml1_scanner_detect(void)
+{
+    paradox_xml1_kernel_t kernel = PARADOX_XML1_KERNEL_SCALAR;
+#ifdef PARADOX_XML1_SCANNER_X86
+    unsigned int leaf1[4];
+    unsigned int leaf7[4];
+    if(PARADOX_FALSE == paradox_xml1_scanner_cpuid(1, leaf1) || !(leaf1[3] & (1u << 26))) return kernel;
+    kernel = PARADOX_XML1_KERNEL_SSE2;
+    if(leaf1[2] & (1u << 20)) kernel = PARADOX_XML1_KERNEL_SSE42;
+    if(!(leaf1[2] & (1u << 27)) || !(leaf1[2] & (1u << 28))) return kernel;
+    const paradox_uint64_t xcr0 = paradox_xml1_scanner_xgetbv();
+    if(0x6 != (xcr0 & 0x6) || PARADOX_FALSE == paradox_xml1_scanner_cpuid(7, leaf7)) return kernel;
+    if(leaf7[1] & (1u << 5)) kernel = PARADOX_XML1_KERNEL_AVX2;
+    if(0xE6 == (xcr0 & 0xE6) && (leaf7[1] & (1u << 16)) && (leaf7[1] & (1u << 30))) kernel = PARADOX_XML1_KERNEL_AVX512BW;
+#endif
+    return kernel;
+}
+
+static const paradox_xml1_scanner_kernels* paradox_xml1_scanner_selected = NULL;
+
+// Runs when the library is loaded where the compiler supports it, and on first use otherwise.
+// Concurrent first uses detect the same kernel set, so the race between them is harmless.
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((constructor))
+#endif
+static void paradox_xml1_scanner_select(void)
+{
+    paradox_xml1_scanner_selected = &paradox_xml1_scanner_kernel_sets[paradox_xml1_scanner_detect()];
+}
+
+static inline const paradox_xml1_scanner_kernels* paradox_xml1_scanner_kernels_get(void)
+{
+    if(NULL == paradox_xml1_scanner_selected) paradox_xml1_scanner_select();
+    return paradox_xml1_scanner_selected;
+}
+
+PARADOX_XML_API paradox_xml1_kernel_t paradox_get_xml1_kernel(void)
+{
+    return (paradox_xml1_kernel_t)(paradox_xml1_scanner_kernels_get() - paradox_xml1_scanner_kernel_sets);
+}
+
+PARADOX_XML_API paradox_bool8_t paradox_set_xml1_kernel(const paradox_xml1_kernel_t kernel)
+{
+    if(kernel > paradox_xml1_scanner_detect()) return PARADOX_FALSE;
+    paradox_xml1_scanner_selected = &paradox_xml1_scanner_kernel_sets[kernel];
+    return PARADOX_TRUE;
+}
+
+PARADOX_XML_API paradox_str_t paradox_get_xml1_kernel_name(const paradox_xml1_kernel_t kernel)
+{
+    switch(kernel)
+    {
+        case PARADOX_XML1_KERNEL_SCALAR: return "scalar";
+        case PARADOX_XML1_KERNEL_SSE2: return "sse2";
+        case PARADOX_XML1_KERNEL_SSE42: return "sse4.2";
+        case PARADOX_XML1_KERNEL_AVX2: return "avx2";
+        case PARADOX_XML1_KERNEL_AVX512BW: return "avx512bw";
+    }
+    return "unknown";
+}
+
+paradox_uint64_t paradox_xml1_scan_char_data(const char* data, const paradox_uint64_t length, const paradox_bool8_t validated)
+{
+    return paradox_xml1_scanner_kernels_get()->scan_char_data(data, length, validated);
+}
+
+paradox_uint64_t paradox_xml1_scan_terminator(const char* data, const paradox_uint64_t length, const char* terminator, const char* alternative, const paradox_bool8_t validated)
+{
+    const paradox_xml1_scanner_terminators terminators =
+    {
+        terminator, strlen(terminator),
+        alternative, NULL != alternative ? strlen(alternative) : 0,
+        validated
+    };
+    return paradox_xml1_scanner_kernels_get()->scan_terminator(data, length, &terminators);
+}
+
+paradox_uint64_t paradox_xml1_validate(const char* data, const paradox_uint64_t length)
+{
+    return paradox_xml1_scanner_kernels_get()->validate(data, length);
+}
+
+void paradox_xml1_scan_structurals(const char* data, const paradox_uint64_t length, paradox_uint64_t* bitmap)
+{
+    paradox_xml1_scanner_kernels_get()->scan_structurals(data, length, bitmap);
+}
@@ -0,0 +1,55 @@
+#ifndef PARADOX_SOFTWARE_C_HEADER_XML1_SCANNER
+#define PARADOX_SOFTWARE_C_HEADER_XML1_SCANNER
+
+#include <paradox-xml/defines.h>
+#ifdef _MSC_VER
+    #include <intrin.h>
+#endif
+
+// Returns the offset of the first of length bytes that CharData cannot skip without a closer look:
+// '<', '&', ']', #x7F, control characters other than #x9, #xA and #xD, and every non-ASCII byte.
+// Returns length when there is none. Validated input only stops at '<', '&' and ']'.
+paradox_uint64_t paradox_xml1_scan_char_data(const char* data, const paradox_uint64_t length, const paradox_bool8_t validated);
+// Returns the offset of the first occurrence of terminator, or of alternative unless it is NULL,
+// among length bytes. Stops earlier at the first byte that Char needs a closer look at: #x7F,
+// control characters other than #x9, #xA and #xD, and every non-ASCII byte, unless the input is validated.
+// Returns length when there is none.
+paradox_uint64_t paradox_xml1_scan_terminator(const char* data, const paradox_uint64_t length, const char* terminator, const char* alternative, const paradox_bool8_t validated);
+// Returns the offset of the first byte that does not start a well-formed UTF-8 sequence of a Char,
+// which rules out RestrictedChar as well, or length when all bytes do.
+paradox_uint64_t paradox_xml1_validate(const char* data, const paradox_uint64_t length);
+// Sets bit i % 64 of bitmap[i / 64] when byte i of length bytes is structural: '<', '>', '&', '=', '"',
+// "'", '/' or ']'. Every other bit of the (length + 63) / 64 words is cleared.
+void paradox_xml1_scan_structurals(const char* data, const paradox_uint64_t length, paradox_uint64_t* bitmap);
+
+// Index of the lowest set bit of a mask that is not zero.
+static inline paradox_uint32_t paradox_xml1_scanner_first_bit(const paradox_uint64_t mask)
+{
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long bit;
+    _BitScanForward64(&bit, mask);
+    return (paradox_uint32_t)bit;
+#elif defined(_MSC_VER)
+    unsigned long bit;
+    if(_BitScanForward(&bit, (unsigned long)mask)) return (paradox_uint32_t)bit;
+    _BitScanForward(&bit, (unsigned long)(mask >> 32));
+    return 32 + (paradox_uint32_t)bit;
+#else
+    return (paradox_uint32_t)__builtin_ctzll(mask);
+#endif
+}
+
+// Number of set bits of a mask. MSVC only has an intrinsic that requires POPCNT, so it counts by halves instead.
+static inline paradox_uint32_t paradox_xml1_scanner_count_bits(paradox_uint64_t mask)
+{
+#ifdef _MSC_VER
+    mask -= (mask >> 1) & 0x5555555555555555ULL;
+    mask = (mask & 0x3333333333333333ULL) + ((mask >> 2) & 0x3333333333333333ULL);
+    mask = (mask + (mask >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (paradox_uint32_t)((mask * 0x0101010101010101ULL) >> 56);
+#else
+    return (paradox_uint32_t)__builtin_popcountll(mask);
+#endif
+}
+
+#endif
@@ -0,0 +1,191 @@
+#include "xml1_symbols.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+static inline paradox_xml1_symbol_slots* paradox_xml1_symbols_current(const paradox_xml1_symbol_table* table)
+{
+    return (paradox_xml1_symbol_slots*)(uintptr_t)paradox_xml1_atomic_load((volatile paradox_uint64_t*)&table->slots);
+}
+
+static inline paradox_bool8_t paradox_xml1_symbols_is(const paradox_xml1_symbol* symbol, const char* name, const paradox_uint64_t length, const paradox_uint64_t hash)
+{
+    return symbol->hash == hash && symbol->name.length == length && PARADOX_TRUE == paradox_xml1_symbols_equal(symbol->name.data, name, length);
+}
+
+// Slot of name: the one holding its symbol, or the empty one it would be put into. Only for the thread that
+// adds to the table, which no other thread does meanwhile.
+static inline paradox_uint64_t paradox_xml1_symbols_slot(const paradox_xml1_symbol_slots* slots, const char* name, const paradox_uint64_t length, const paradox_uint64_t hash)
+{
+    for(paradox_uint64_t slot = hash & slots->mask;; slot = (slot + 1) & slots->mask)
+    {
+        const paradox_xml1_symbol* symbol = (const paradox_xml1_symbol*)(uintptr_t)slots->entries[slot];
+        if(NULL == symbol || PARADOX_TRUE == paradox_xml1_symbols_is(symbol, name, length, hash)) return slot;
+    }
+}
+
+// Id of name, or PARADOX_XML1_SYMBOL_NONE when it is not there, safe while another thread adds to the table.
+static paradox_uint32_t paradox_xml1_symbols_find(const paradox_xml1_symbol_table* table, const char* name, const paradox_uint64_t length, const paradox_uint64_t hash)
+{
+    const paradox_xml1_symbol_slots* slots = paradox_xml1_symbols_current(table);
+    if(NULL == slots) return PARADOX_XML1_SYMBOL_NONE;
+    for(paradox_uint64_t slot = hash & slots->mask;; slot = (slot + 1) & slots->mask)
+    {
+        const paradox_xml1_symbol* symbol = (const paradox_xml1_symbol*)(uintptr_t)paradox_xml1_atomic_load(&slots->entries[slot]);
+        if(NULL == symbol) return PARADOX_XML1_SYMBOL_NONE;
+        if(PARADOX_TRUE == paradox_xml1_symbols_is(symbol, name, length, hash)) return symbol->id;
+    }
+}
+
+// Segment of id and its position in it. Segment k holds the ids from 32 * (2^k - 1) on.
+static inline paradox_uint32_t paradox_xml1_symbols_segment(const paradox_uint64_t id, paradox_uint64_t* offset)
+{
+    const paradox_uint64_t position = id + ((paradox_uint64_t)1 << PARADOX_XML1_SYMBOLS_SEGMENT_SHIFT);
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long bit;
+    _BitScanReverse64(&bit, position);
+#elif defined(_MSC_VER)
+    unsigned long bit;
+    if(!_BitScanReverse(&bit, (unsigned long)(position >> 32))) _BitScanReverse(&bit, (unsigned long)position);
+    else bit += 32;
+#else
+    const paradox_uint32_t bit = 63 - (paradox_uint32_t)__builtin_clzll(position);
+#endif
+    *offset = position - ((paradox_uint64_t)1 << bit);
+    return (paradox_uint32_t)bit - PARADOX_XML1_SYMBOLS_SEGMENT_SHIFT;
+}
+
+// Doubles the slots once they are half full, which keeps the probe sequences short. The slots replaced are
+// released right away unless threads may still be probing them.
+static paradox_bool8_t paradox_xml1_symbols_rehash(paradox_xml1_symbol_table* table)
+{
+    paradox_xml1_symbol_slots* current = paradox_xml1_symbols_current(table);
+    const paradox_uint64_t slot_count = NULL != current ? (current->mask + 1) * 2 : 64;
+    paradox_xml1_symbol_slots* slots = calloc(1, sizeof(paradox_xml1_symbol_slots) + slot_count * sizeof(paradox_uint64_t));
+    if(NULL == slots) return PARADOX_FALSE;
+    slots->entries = (volatile paradox_uint64_t*)(slots + 1);
+    slots->mask = slot_count - 1;
+    if(NULL != current)
+    {
+        for(paradox_uint64_t slot = 0; slot <= current->mask; slot++)
+        {
+            const paradox_xml1_symbol* symbol = (const paradox_xml1_symbol*)(uintptr_t)current->entries[slot];
+            if(NULL != symbol) slots->entries[paradox_xml1_symbols_slot(slots, symbol->name.data, symbol->name.length, symbol->hash)] = current->entries[slot];
+        }
+    }
+    if(PARADOX_TRUE == table->shared || PARADOX_TRUE == table->concurrent) slots->retired = current;
+    else free(current);
+    paradox_xml1_atomic_store(&table->slots, (paradox_uint64_t)(uintptr_t)slots);
+    return PARADOX_TRUE;
+}
+
+static paradox_uint32_t paradox_xml1_symbols_add(paradox_xml1_symbol_table* table, const char* name, const paradox_uint64_t length, const paradox_uint64_t hash)
+{
+    paradox_xml1_symbol_slots* slots = paradox_xml1_symbols_current(table);
+    paradox_uint64_t slot = 0;
+    if(NULL != slots)
+    {
+        slot = paradox_xml1_symbols_slot(slots, name, length, hash);
+        if(0 != slots->entries[slot]) return ((const paradox_xml1_symbol*)(uintptr_t)slots->entries[slot])->id;
+    }
+    const paradox_uint64_t id = table->count;
+    if(id >= PARADOX_XML1_SYMBOL_NONE - 1) return PARADOX_XML1_SYMBOL_NONE;
+    if(NULL == slots || (id + 1) * 2 > slots->mask + 1)
+    {
+        if(PARADOX_FALSE == paradox_xml1_symbols_rehash(table)) return PARADOX_XML1_SYMBOL_NONE;
+        slots = paradox_xml1_symbols_current(table);
+        slot = paradox_xml1_symbols_slot(slots, name, length, hash);
+    }
+    paradox_uint64_t offset;
+    const paradox_uint32_t segment = paradox_xml1_symbols_segment(id, &offset);
+    if(NULL == table->segments[segment])
+    {
+        table->segments[segment] = malloc(((paradox_uint64_t)1 << (segment + PARADOX_XML1_SYMBOLS_SEGMENT_SHIFT)) * sizeof(paradox_xml1_symbol*));
+        if(NULL == table->segments[segment]) return PARADOX_XML1_SYMBOL_NONE;
+    }
+    paradox_xml1_symbol* symbol = paradox_xml1_arena_alloc(&table->arena, sizeof(paradox_xml1_symbol));
+    if(NULL == symbol) return PARADOX_XML1_SYMBOL_NONE;
+    if(PARADOX_TRUE == table->shared)
+    {
+        name = paradox_xml1_arena_strndup(&table->arena, name, length);
+        if(NULL == name) return PARADOX_XML1_SYMBOL_NONE;
+    }
+
+    symbol->name.data = name;
+    symbol->name.length = length;
+    symbol->hash = hash;
+    symbol->id = (paradox_uint32_t)id;
+    table->segments[segment][offset] = symbol;
+    paradox_xml1_atomic_store(&table->count, id + 1);
+    paradox_xml1_atomic_store(&slots->entries[slot], (paradox_uint64_t)(uintptr_t)symbol);
+    return (paradox_uint32_t)id;
+}
+
+paradox_xml1_symbol_table* paradox_xml1_symbols_create(const paradox_bool8_t shared)
+{
+    paradox_xml1_symbol_table* table = calloc(1, sizeof(paradox_xml1_symbol_table));
+    if(NULL == table) return NULL;
+    paradox_xml1_arena_init(&table->arena);
+    paradox_xml1_mutex_init(&table->lock);
+    table->shared = shared;
+    return table;
+}
+
+void paradox_xml1_symbols_free(paradox_xml1_symbol_table* table)
+{
+    if(NULL == table) return;
+    paradox_xml1_mutex_destroy(&table->lock);
+    paradox_xml1_arena_free(&table->arena);
+    for(paradox_uint32_t segment = 0; segment < PARADOX_XML1_SYMBOLS_SEGMENTS; segment++)
+    {
+        free(table->segments[segment]);
+    }
+    paradox_xml1_symbol_slots* slots = paradox_xml1_symbols_current(table);
+    while(NULL != slots)
+    {
+        paradox_xml1_symbol_slots* retired = slots->retired;
+        free(slots);
+        slots = retired;
+    }
+    free(table);
+}
+
+paradox_uint32_t paradox_xml1_symbols_intern(paradox_xml1_symbol_table* table, const char* name, const paradox_uint64_t length)
+{
+    const paradox_uint64_t hash = paradox_xml1_symbols_hash(name, length);
+    if(PARADOX_FALSE == table->shared && PARADOX_FALSE == table->concurrent) return paradox_xml1_symbols_add(table, name, length, hash);
+    // Names repeat far more often than they are new, so almost every call ends here without the lock.
+    paradox_uint32_t id = paradox_xml1_symbols_find(table, name, length, hash);
+    if(PARADOX_XML1_SYMBOL_NONE != id) return id;
+    paradox_xml1_mutex_lock(&table->lock);
+    id = paradox_xml1_symbols_add(table, name, length, hash);
+    paradox_xml1_mutex_unlock(&table->lock);
+    return id;
+}
+
+PARADOX_XML_API paradox_uint32_t paradox_find_xml1_symbol(const paradox_xml1_symbol_table* table, const char* name, const paradox_uint64_t length)
+{
+    if(NULL == table || NULL == name) return PARADOX_XML1_SYMBOL_NONE;
+    return paradox_xml1_symbols_find(table, name, length, paradox_xml1_symbols_hash(name, length));
+}
+
+PARADOX_XML_API paradox_xml1_slice paradox_get_xml1_symbol_name(const paradox_xml1_symbol_table* table, const paradox_uint32_t symbol)
+{
+    paradox_xml1_slice name = { NULL, 0 };
+    if(NULL == table || symbol >= paradox_xml1_atomic_load((volatile paradox_uint64_t*)&table->count)) return name;
+    paradox_uint64_t offset;
+    const paradox_uint32_t segment = paradox_xml1_symbols_segment(symbol, &offset);
+    return table->segments[segment][offset]->name;
+}
+
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_create_xml1_symbol_table(paradox_xml1_symbol_table** table)
+{
+    if(NULL == table) return PARADOX_XML1_PARSER_NULL_DOCUMENT;
+    *table = paradox_xml1_symbols_create(PARADOX_TRUE);
+    return NULL != *table ? PARADOX_XML1_PARSER_SUCCESS : PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+}
+
+PARADOX_XML_API void paradox_free_xml1_symbol_table(paradox_xml1_symbol_table* table)
+{
+    paradox_xml1_symbols_free(table);
+}
@@ -0,0 +1,94 @@
+#ifndef PARADOX_SOFTWARE_C_HEADER_XML1_SYMBOLS
+#define PARADOX_SOFTWARE_C_HEADER_XML1_SYMBOLS
+
+#include <paradox-xml/xml1_symbol.h>
+#include <paradox-xml/xml1_arena.h>
+#include "xml1_thread.h"
+#include <string.h>
+
+// Names are short, so they are hashed a word at a time and the words are mixed by a single multiply.
+// The bytes past the last full word are gathered one by one rather than copied, which would call into memcpy.
+// The low bits of a product only depend on the low bits of the word, while tables mask the low bits of the
+// hash, so the high bits are folded down before it is returned.
+static inline paradox_uint64_t paradox_xml1_symbols_hash(const char* name, paradox_uint64_t length)
+{
+    paradox_uint64_t hash = 0xCBF29CE484222325ULL ^ length;
+    paradox_uint64_t word;
+    for(; length >= 8; name += 8, length -= 8)
+    {
+        memcpy(&word, name, 8);
+        hash = (hash ^ word) * 0x9E3779B97F4A7C15ULL;
+    }
+    if(length)
+    {
+        word = 0;
+        for(paradox_uint64_t i = 0; i < length; i++) word |= (paradox_uint64_t)(unsigned char)name[i] << (i * 8);
+        hash = (hash ^ word) * 0x9E3779B97F4A7C15ULL;
+    }
+    hash ^= hash >> 32;
+    hash *= 0xD6E8FEB86659FD93ULL;
+    return hash ^ (hash >> 32);
+}
+
+// Names that hash the same are almost always equal, and short, so they are compared in place.
+static inline paradox_bool8_t paradox_xml1_symbols_equal(const char* left, const char* right, const paradox_uint64_t length)
+{
+    for(paradox_uint64_t i = 0; i < length; i++)
+    {
+        if(left[i] != right[i]) return PARADOX_FALSE;
+    }
+    return PARADOX_TRUE;
+}
+
+typedef struct paradox_xml1_symbol
+{
+    paradox_xml1_slice name;
+    paradox_uint64_t hash;
+    paradox_uint32_t id;
+
+} paradox_xml1_symbol;
+
+// Open addressing over the hashes, a power of two of slots that hold a paradox_xml1_symbol* or 0 when empty.
+// Growing the table publishes a new array of slots; the ones it replaces are kept until the table is freed,
+// as threads that find names without the lock may still probe them.
+typedef struct paradox_xml1_symbol_slots
+{
+    struct paradox_xml1_symbol_slots* retired;
+    paradox_uint64_t mask;
+    // Follow the struct in the same allocation.
+    volatile paradox_uint64_t* entries;
+
+} paradox_xml1_symbol_slots;
+
+// The symbols by id sit in segments of 32, 64, 128... pointers that never move once they are allocated,
+// so an id below the published count is read without the lock.
+#define PARADOX_XML1_SYMBOLS_SEGMENT_SHIFT 5
+#define PARADOX_XML1_SYMBOLS_SEGMENTS (33 - PARADOX_XML1_SYMBOLS_SEGMENT_SHIFT)
+
+struct paradox_xml1_symbol_table
+{
+    paradox_xml1_symbol** segments[PARADOX_XML1_SYMBOLS_SEGMENTS];
+    // Symbols handed out, stored with release once the segment of the last one holds it.
+    volatile paradox_uint64_t count;
+    // paradox_xml1_symbol_slots*, stored with release once every slot it holds is filled in.
+    volatile paradox_uint64_t slots;
+    // Holds the symbols, and for a shared table, which outlives the inputs of its documents, copies of their names.
+    paradox_xml1_arena arena;
+    paradox_bool8_t shared;
+    // Set while the documents parsed into a table of their own do so from several threads.
+    paradox_bool8_t concurrent;
+    // Taken by the threads that add a name, after they have not found it without the lock.
+    paradox_xml1_mutex lock;
+
+};
+
+// A table of its own for a document, whose names point into the input, or a shared one that copies them.
+// Returns NULL when out of memory.
+paradox_xml1_symbol_table* paradox_xml1_symbols_create(const paradox_bool8_t shared);
+void paradox_xml1_symbols_free(paradox_xml1_symbol_table* table);
+// Id of the name of length bytes, which is added to the table when it is not there yet. While the table is
+// shared or concurrent, a name it holds is found without taking the lock, and only adding one takes it.
+// Returns PARADOX_XML1_SYMBOL_NONE when out of memory.
+paradox_uint32_t paradox_xml1_symbols_intern(paradox_xml1_symbol_table* table, const char* name, const paradox_uint64_t length);
+
+#endif
@@ -0,0 +1,14 @@
+#include <paradox-xml/xml1_tape.h>
+#include "xml1_symbols.h"
+#include <stdlib.h>
+
+PARADOX_XML_API void paradox_free_xml1_tape(paradox_xml1_tape* tape)
+{
+    if(NULL == tape) return;
+    free(tape->nodes);
+    free(tape->attributes);
+    if(PARADOX_TRUE == tape->owns_symbols) paradox_xml1_symbols_free(tape->symbols);
+    // The tape lives inside its own arena, so copy the arena out before releasing it.
+    paradox_xml1_arena arena = tape->arena;
+    paradox_xml1_arena_free(&arena);
+}
@@ -0,0 +1,203 @@
+#include "xml1_thread.h"
+#include <stdlib.h>
+
+#ifdef _WIN32
+static DWORD WINAPI paradox_xml1_thread_main(LPVOID argument)
+{
+    paradox_xml1_thread* thread = argument;
+    thread->routine(thread->argument);
+    return 0;
+}
+#else
+static void* paradox_xml1_thread_main(void* argument)
+{
+    paradox_xml1_thread* thread = argument;
+    thread->routine(thread->argument);
+    return NULL;
+}
+#endif
+
+paradox_bool8_t paradox_xml1_thread_start(paradox_xml1_thread* thread, void (*routine)(void* argument), void* argument)
+{
+    thread->routine = routine;
+    thread->argument = argument;
+#ifdef _WIN32
+    thread->handle = CreateThread(NULL, 0, paradox_xml1_thread_main, thread, 0, NULL);
+    return NULL != thread->handle;
+#else
+    return 0 == pthread_create(&thread->handle, NULL, paradox_xml1_thread_main, thread);
+#endif
+}
+
+void paradox_xml1_thread_join(paradox_xml1_thread* thread)
+{
+#ifdef _WIN32
+    WaitForSingleObject(thread->handle, INFINITE);
+    CloseHandle(thread->handle);
+#else
+    pthread_join(thread->handle, NULL);
+#endif
+}
+
+
+// Mutex
+
+void paradox_xml1_mutex_init(paradox_xml1_mutex* mutex)
+{
+#ifdef _WIN32
+    InitializeSRWLock(&mutex->lock);
+#else
+    pthread_mutex_init(&mutex->lock, NULL);
+#endif
+}
+
+void paradox_xml1_mutex_lock(paradox_xml1_mutex* mutex)
+{
+#ifdef _WIN32
+    AcquireSRWLockExclusive(&mutex->lock);
+#else
+    pthread_mutex_lock(&mutex->lock);
+#endif
+}
+
+void paradox_xml1_mutex_unlock(paradox_xml1_mutex* mutex)
+{
+#ifdef _WIN32
+    ReleaseSRWLockExclusive(&mutex->lock);
+#else
+    pthread_mutex_unlock(&mutex->lock);
+#endif
+}
+
+void paradox_xml1_mutex_destroy(paradox_xml1_mutex* mutex)
+{
+#ifdef _WIN32
+    (void)mutex;
+#else
+    pthread_mutex_destroy(&mutex->lock);
+#endif
+}
+
+
+// Pool
+
+#ifdef _WIN32
+    #define PARADOX_XML1_POOL_LOCK(lock) AcquireSRWLockExclusive(&(lock))
+    #define PARADOX_XML1_POOL_UNLOCK(lock) ReleaseSRWLockExclusive(&(lock))
+    #define PARADOX_XML1_POOL_WAIT(condition, lock) SleepConditionVariableSRW(&(condition), &(lock), INFINITE, 0)
+    #define PARADOX_XML1_POOL_WAKE_ALL(condition) WakeAllConditionVariable(&(condition))
+#else
+    #define PARADOX_XML1_POOL_LOCK(lock) pthread_mutex_lock(&(lock))
+    #define PARADOX_XML1_POOL_UNLOCK(lock) pthread_mutex_unlock(&(lock))
+    #define PARADOX_XML1_POOL_WAIT(condition, lock) pthread_cond_wait(&(condition), &(lock))
+    #define PARADOX_XML1_POOL_WAKE_ALL(condition) pthread_cond_broadcast(&(condition))
+#endif
+
+static void paradox_xml1_pool_main(void* argument)
+{
+    paradox_xml1_pool_worker* worker = argument;
+    paradox_xml1_parser_pool* pool = worker->pool;
+    paradox_uint64_t job = 0;
+    for(;;)
+    {
+        PARADOX_XML1_POOL_LOCK(pool->lock);
+        while(PARADOX_FALSE == pool->stopping && job == pool->job) PARADOX_XML1_POOL_WAIT(pool->job_posted, pool->lock);
+        if(PARADOX_TRUE == pool->stopping)
+        {
+            PARADOX_XML1_POOL_UNLOCK(pool->lock);
+            return;
+        }
+        job = pool->job;
+        void (*routine)(void* argument, const paradox_uint32_t worker) = pool->routine;
+        void* routine_argument = pool->argument;
+        PARADOX_XML1_POOL_UNLOCK(pool->lock);
+
+        routine(routine_argument, worker->index);
+
+        PARADOX_XML1_POOL_LOCK(pool->lock);
+        if(0 == --pool->running) PARADOX_XML1_POOL_WAKE_ALL(pool->job_done);
+        PARADOX_XML1_POOL_UNLOCK(pool->lock);
+    }
+}
+
+paradox_xml1_parser_pool* paradox_xml1_pool_create(const paradox_uint32_t size)
+{
+    paradox_xml1_parser_pool* pool = calloc(1, sizeof(paradox_xml1_parser_pool));
+    if(NULL == pool) return NULL;
+    pool->workers = calloc(size > 1 ? size - 1 : 1, sizeof(paradox_xml1_pool_worker));
+    if(NULL == pool->workers)
+    {
+        free(pool);
+        return NULL;
+    }
+#ifdef _WIN32
+    InitializeSRWLock(&pool->lock);
+    InitializeSRWLock(&pool->submit);
+    InitializeConditionVariable(&pool->job_posted);
+    InitializeConditionVariable(&pool->job_done);
+#else
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_mutex_init(&pool->submit, NULL);
+    pthread_cond_init(&pool->job_posted, NULL);
+    pthread_cond_init(&pool->job_done, NULL);
+#endif
+    pool->size = 1;
+    for(paradox_uint32_t index = 1; index < size; index++)
+    {
+        paradox_xml1_pool_worker* worker = &pool->workers[index - 1];
+        worker->pool = pool;
+        worker->index = index;
+        if(PARADOX_FALSE == paradox_xml1_thread_start(&worker->thread, paradox_xml1_pool_main, worker)) break;
+        pool->size++;
+    }
+    return pool;
+}
+
+void paradox_xml1_pool_run(paradox_xml1_parser_pool* pool, void (*routine)(void* argument, const paradox_uint32_t worker), void* argument)
+{
+    PARADOX_XML1_POOL_LOCK(pool->submit);
+    PARADOX_XML1_POOL_LOCK(pool->lock);
+    pool->routine = routine;
+    pool->argument = argument;
+    pool->running = pool->size - 1;
+    pool->job++;
+    PARADOX_XML1_POOL_WAKE_ALL(pool->job_posted);
+    PARADOX_XML1_POOL_UNLOCK(pool->lock);
+
+    routine(argument, 0);
+
+    PARADOX_XML1_POOL_LOCK(pool->lock);
+    while(0 != pool->running) PARADOX_XML1_POOL_WAIT(pool->job_done, pool->lock);
+    PARADOX_XML1_POOL_UNLOCK(pool->lock);
+    PARADOX_XML1_POOL_UNLOCK(pool->submit);
+}
+
+void paradox_xml1_pool_free(paradox_xml1_parser_pool* pool)
+{
+    if(NULL == pool) return;
+    PARADOX_XML1_POOL_LOCK(pool->lock);
+    pool->stopping = PARADOX_TRUE;
+    PARADOX_XML1_POOL_WAKE_ALL(pool->job_posted);
+    PARADOX_XML1_POOL_UNLOCK(pool->lock);
+    for(paradox_uint32_t index = 1; index < pool->size; index++) paradox_xml1_thread_join(&pool->workers[index - 1].thread);
+#ifndef _WIN32
+    pthread_mutex_destroy(&pool->lock);
+    pthread_mutex_destroy(&pool->submit);
+    pthread_cond_destroy(&pool->job_posted);
+    pthread_cond_destroy(&pool->job_done);
+#endif
+    free(pool->workers);
+    free(pool);
+}
+
+PARADOX_XML_API paradox_xml1_parser_errno_t paradox_create_xml1_parser_pool(const paradox_uint32_t threads, paradox_xml1_parser_pool** pool)
+{
+    if(NULL == pool) return PARADOX_XML1_PARSER_NULL_DOCUMENT;
+    *pool = paradox_xml1_pool_create(threads);
+    return NULL != *pool ? PARADOX_XML1_PARSER_SUCCESS : PARADOX_XML1_PARSER_OUT_OF_MEMORY;
+}
+
+PARADOX_XML_API void paradox_free_xml1_parser_pool(paradox_xml1_parser_pool* pool)
+{
+    paradox_xml1_pool_free(pool);
+}
@@ -0,0 +1,123 @@
+#ifndef PARADOX_SOFTWARE_C_HEADER_XML1_THREAD
+#define PARADOX_SOFTWARE_C_HEADER_XML1_THREAD
+
+#include <paradox-xml/xml1_parser.h>
+#ifdef _WIN32
+    #include <windows.h>
+#else
+    #include <pthread.h>
+#endif
+#ifdef _MSC_VER
+    #include <intrin.h>
+#endif
+
+// Thread that runs routine on argument. The struct is read by the new thread, so it has to stay in
+// place until the thread is joined.
+typedef struct paradox_xml1_thread
+{
+#ifdef _WIN32
+    HANDLE handle;
+#else
+    pthread_t handle;
+#endif
+    void (*routine)(void* argument);
+    void* argument;
+
+} paradox_xml1_thread;
+
+// Returns PARADOX_FALSE when the system could not create another thread.
+paradox_bool8_t paradox_xml1_thread_start(paradox_xml1_thread* thread, void (*routine)(void* argument), void* argument);
+void paradox_xml1_thread_join(paradox_xml1_thread* thread);
+
+// Mutex
+
+typedef struct paradox_xml1_mutex
+{
+#ifdef _WIN32
+    SRWLOCK lock;
+#else
+    pthread_mutex_t lock;
+#endif
+
+} paradox_xml1_mutex;
+
+void paradox_xml1_mutex_init(paradox_xml1_mutex* mutex);
+void paradox_xml1_mutex_lock(paradox_xml1_mutex* mutex);
+void paradox_xml1_mutex_unlock(paradox_xml1_mutex* mutex);
+void paradox_xml1_mutex_destroy(paradox_xml1_mutex* mutex);
+
+// Pool
+
+typedef struct paradox_xml1_pool_worker
+{
+    paradox_xml1_parser_pool* pool;
+    paradox_uint32_t index;
+    paradox_xml1_thread thread;
+
+} paradox_xml1_pool_worker;
+
+// Workers that sleep between the jobs they run together. The calling thread of a job is worker 0,
+// so a pool of size workers keeps size - 1 threads of its own.
+struct paradox_xml1_parser_pool
+{
+    paradox_xml1_pool_worker* workers;
+    paradox_uint32_t size;
+#ifdef _WIN32
+    SRWLOCK lock;
+    SRWLOCK submit;
+    CONDITION_VARIABLE job_posted;
+    CONDITION_VARIABLE job_done;
+#else
+    pthread_mutex_t lock;
+    // Held for a whole job, which queues the jobs posted from several threads at once.
+    pthread_mutex_t submit;
+    pthread_cond_t job_posted;
+    pthread_cond_t job_done;
+#endif
+    // Counts the jobs posted, so a worker tells a new job from the one it has already run.
+    paradox_uint64_t job;
+    // Threads that have not finished the current job yet.
+    paradox_uint32_t running;
+    paradox_bool8_t stopping;
+    void (*routine)(void* argument, const paradox_uint32_t worker);
+    void* argument;
+
+};
+
+// Returns NULL when out of memory. Ends up with fewer workers when the system runs out of threads.
+paradox_xml1_parser_pool* paradox_xml1_pool_create(const paradox_uint32_t size);
+// Runs routine on every worker of the pool, the calling thread included, and returns once all of them returned.
+void paradox_xml1_pool_run(paradox_xml1_parser_pool* pool, void (*routine)(void* argument, const paradox_uint32_t worker), void* argument);
+void paradox_xml1_pool_free(paradox_xml1_parser_pool* pool);
+
+// Atomics
+
+static inline paradox_uint64_t paradox_xml1_atomic_load(volatile paradox_uint64_t* target)
+{
+#ifdef _MSC_VER
+    return (paradox_uint64_t)_InterlockedCompareExchange64((volatile long long*)target, 0, 0);
+#else
+    return __atomic_load_n(target, __ATOMIC_ACQUIRE);
+#endif
+}
+
+static inline void paradox_xml1_atomic_store(volatile paradox_uint64_t* target, const paradox_uint64_t value)
+{
+#ifdef _MSC_VER
+    _InterlockedExchange64((volatile long long*)target, (long long)value);
+#else
+    __atomic_store_n(target, value, __ATOMIC_RELEASE);
+#endif
+}
+
+// Replaces *target with desired when it still holds expected. Returns whether it did.
+static inline paradox_bool8_t paradox_xml1_atomic_compare_exchange(volatile paradox_uint64_t* target, paradox_uint64_t expected, const paradox_uint64_t desired)
+{
+#ifdef _MSC_VER
+    return expected == (paradox_uint64_t)_InterlockedCompareExchange64((volatile long long*)target, (long long)desired, (long long)expected);
+#else
+    return __atomic_compare_exchange_n(target, &expected, desired, PARADOX_FALSE, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+#endif
+}
+
+#endif
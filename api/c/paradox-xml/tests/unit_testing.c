@@ -1,3 +1,1795 @@
-int main(void) {
-    return 0;
-}
\ No newline at end of file
+#include <paradox-xml/xml1_parser.h>
+#include <paradox-xml/xml1_reader.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Checks
+
+static int paradox_test_failures = 0;
+
+static void paradox_test_expect(const int condition, const char* text, const char* file, const int line)
+{
+    if(condition) return;
+    printf("%s:%d: expected %s\n", file, line, text);
+    paradox_test_failures++;
+}
+
+#define PARADOX_TEST_EXPECT(condition) paradox_test_expect((condition) ? 1 : 0, #condition, __FILE__, __LINE__)
+
+static paradox_bool8_t paradox_test_equals(const paradox_xml1_slice slice, const char* string)
+{
+    return strlen(string) == slice.length && 0 == memcmp(slice.data, string, slice.length);
+}
+
+// Canonical Form
+
+// The elements of a document in post-order, one line each: the name, the attributes and the text of the
+// element, that is its character data and CDATA sections in document order. Comments and processing
+// instructions are left out, as a tree does not keep them. Every way of parsing a document agrees on it.
+typedef struct paradox_test_buffer
+{
+    char data[1 << 16];
+    paradox_uint64_t length;
+
+} paradox_test_buffer;
+
+static void paradox_test_append(paradox_test_buffer* buffer, const char* data, const paradox_uint64_t length)
+{
+    if(0 == length || buffer->length + length >= sizeof(buffer->data)) return;
+    memcpy(buffer->data + buffer->length, data, length);
+    buffer->length += length;
+    buffer->data[buffer->length] = '\0';
+}
+
+static void paradox_test_append_slice(paradox_test_buffer* buffer, const paradox_xml1_slice slice)
+{
+    paradox_test_append(buffer, slice.data, slice.length);
+}
+
+static void paradox_test_append_string(paradox_test_buffer* buffer, const char* string)
+{
+    paradox_test_append(buffer, string, strlen(string));
+}
+
+static void paradox_test_append_attribute(paradox_test_buffer* buffer, const paradox_xml1_slice name, const paradox_xml1_slice value)
+{
+    paradox_test_append_string(buffer, " ");
+    paradox_test_append_slice(buffer, name);
+    paradox_test_append_string(buffer, "=\"");
+    paradox_test_append_slice(buffer, value);
+    paradox_test_append_string(buffer, "\"");
+}
+
+static void paradox_test_canonical_tree(paradox_xml1_document* document, paradox_xml1_element* element, paradox_test_buffer* buffer)
+{
+    for(paradox_xml1_element* child = element->children; NULL != child; child = child->next)
+    {
+        paradox_test_canonical_tree(document, child, buffer);
+    }
+    paradox_test_append_slice(buffer, element->tag);
+    for(paradox_xml1_attribute* attribute = element->attributes; NULL != attribute; attribute = attribute->next)
+    {
+        paradox_xml1_slice value;
+        paradox_get_xml1_attribute_value(document, attribute, &value);
+        paradox_test_append_attribute(buffer, attribute->tag, value);
+    }
+    paradox_xml1_slice value;
+    paradox_get_xml1_element_value(document, element, &value);
+    paradox_test_append_string(buffer, "|");
+    paradox_test_append_slice(buffer, value);
+    paradox_test_append_string(buffer, "\n");
+}
+
+// Parses length bytes of data into buffer with options, and returns the result of the parse.
+static paradox_xml1_parser_errno_t paradox_test_tree(const char* data, const paradox_uint64_t length, const paradox_xml1_parser_options* options, paradox_test_buffer* buffer)
+{
+    paradox_xml1_document* document = NULL;
+    buffer->length = 0;
+    buffer->data[0] = '\0';
+    const paradox_xml1_parser_errno_t result = paradox_parse_xml1_document_with_options(data, length, options, &document);
+    if(PARADOX_XML1_PARSER_SUCCESS != result) return result;
+    paradox_test_canonical_tree(document, document->root, buffer);
+    paradox_free_xml1_document(document);
+    return result;
+}
+
+// Documents every way of parsing is checked against.
+static const char* paradox_test_corpus[] =
+{
+    "<?xml version=\"1.1\"?><r/>",
+    "<?xml version=\"1.1\"?><r a='1' b=\"x&amp;y\">t<c>u</c>v<![CDATA[<w>]]><!--c--><?p d?></r>",
+    "<?xml version=\"1.1\"?>\n<!-- lead -->\n<doc>\n  <item id=\"1\">one &lt; two</item>\n  <item id=\"2\">&#x41;&#66;</item>\n  <empty/>\n</doc>\n<?tail?>\n",
+    "<?xml version=\"1.1\"?><n\xC3\xA9 \xCE\xB1='\xE2\x82\xAC'>\xF0\x9F\x98\x80<x\xE2\x80\xBF/>&#x1F600;</n\xC3\xA9>",
+    "<?xml version=\"1.1\"?><r a1='1' a2='2' a3='3' a4='4' a5='5' a6='6' a7='7' a8='8' a9='9' a10='&#x31;0'><a><b><c><d>deep</d></c></b></a></r>",
+    "<?xml version=\"1.1\"?><!DOCTYPE r [<!ENTITY e 'text'><!ENTITY m '<b>in&e;</b>'>]><r a='&e;'>a&e;b&m;c</r>"
+};
+
+#define PARADOX_TEST_CORPUS_COUNT (sizeof(paradox_test_corpus) / sizeof(paradox_test_corpus[0]))
+
+// The canonical form of the trees of paradox_test_corpus.
+static const char* paradox_test_corpus_trees[] =
+{
+    "r|\n",
+    "c|u\nr a=\"1\" b=\"x&y\"|tv<w>\n",
+    "item id=\"1\"|one < two\nitem id=\"2\"|AB\nempty|\ndoc|\n  \n  \n  \n\n",
+    "x\xE2\x80\xBF|\nn\xC3\xA9 \xCE\xB1=\"\xE2\x82\xAC\"|\xF0\x9F\x98\x80\xF0\x9F\x98\x80\n",
+    "d|deep\nc|\nb|\na|\nr a1=\"1\" a2=\"2\" a3=\"3\" a4=\"4\" a5=\"5\" a6=\"6\" a7=\"7\" a8=\"8\" a9=\"9\" a10=\"10\"|\n",
+    "b|intext\nr a=\"text\"|atextbc\n"
+};
+
+// Arena and Tree
+
+static void paradox_test_arena(void)
+{
+    paradox_xml1_arena arena;
+    paradox_xml1_arena other;
+    paradox_xml1_arena_init(&arena);
+    paradox_xml1_arena_init(&other);
+    for(paradox_uint64_t size = 1; size < 100000; size = size * 3 + 1)
+    {
+        char* allocated = paradox_xml1_arena_alloc(&arena, size);
+        PARADOX_TEST_EXPECT(NULL != allocated && 0 == (paradox_uint64_t)(size_t)allocated % 8);
+        if(NULL != allocated) memset(allocated, 'a', size);
+    }
+    paradox_str_t copy = paradox_xml1_arena_strndup(&other, "name and more", 4);
+    PARADOX_TEST_EXPECT(NULL != copy && 0 == strcmp(copy, "name"));
+    paradox_xml1_arena_merge(&arena, &other);
+    PARADOX_TEST_EXPECT(NULL == other.chunks);
+    PARADOX_TEST_EXPECT(0 == strcmp(copy, "name"));
+    paradox_xml1_arena_free(&other);
+    paradox_xml1_arena_free(&arena);
+}
+
+static void paradox_test_document_tree(void)
+{
+    for(paradox_uint64_t i = 0; i < PARADOX_TEST_CORPUS_COUNT; i++)
+    {
+        static paradox_test_buffer buffer;
+        PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_test_tree(paradox_test_corpus[i], strlen(paradox_test_corpus[i]), NULL, &buffer));
+        PARADOX_TEST_EXPECT(0 == strcmp(buffer.data, paradox_test_corpus_trees[i]));
+    }
+
+    // Every element links back to its parent, and the children keep the order of the document.
+    paradox_xml1_document* document = NULL;
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_parse_xml1_document("<?xml version=\"1.1\"?><r><a/><b/><c/></r>", &document));
+    if(NULL == document) return;
+    paradox_xml1_element* root = document->root;
+    PARADOX_TEST_EXPECT(NULL == root->parent && NULL == root->next);
+    const char* names[] = { "a", "b", "c" };
+    paradox_uint64_t count = 0;
+    for(paradox_xml1_element* child = root->children; NULL != child; child = child->next, count++)
+    {
+        PARADOX_TEST_EXPECT(root == child->parent);
+        PARADOX_TEST_EXPECT(count < 3 && paradox_test_equals(child->tag, names[count]));
+    }
+    PARADOX_TEST_EXPECT(3 == count);
+    paradox_free_xml1_document(document);
+
+    document = NULL;
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_INVALID_DOCUMENT == paradox_parse_xml1_document("<?xml version=\"1.1\"?><r><a></r>", &document));
+    PARADOX_TEST_EXPECT(NULL == document);
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_NULL_DOCUMENT == paradox_parse_xml1_document(NULL, &document));
+}
+
+// Slices
+
+static paradox_bool8_t paradox_test_inside(const paradox_xml1_slice slice, const char* data, const paradox_uint64_t length)
+{
+    return slice.data >= data && slice.data + slice.length <= data + length;
+}
+
+static void paradox_test_slices(void)
+{
+    paradox_str_t data = "<?xml version=\"1.1\"?><root name='value'>text<child/></root>";
+    paradox_xml1_document* document = NULL;
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_parse_xml1_document(data, &document));
+    if(NULL == document) return;
+    const paradox_uint64_t length = strlen(data);
+    paradox_xml1_element* root = document->root;
+    PARADOX_TEST_EXPECT(paradox_test_equals(root->tag, "root") && paradox_test_inside(root->tag, data, length));
+    PARADOX_TEST_EXPECT(paradox_test_equals(root->value, "text") && paradox_test_inside(root->value, data, length));
+    PARADOX_TEST_EXPECT(paradox_test_equals(root->attributes->tag, "name") && paradox_test_inside(root->attributes->tag, data, length));
+    PARADOX_TEST_EXPECT(paradox_test_equals(root->attributes->value, "value") && paradox_test_inside(root->attributes->value, data, length));
+    PARADOX_TEST_EXPECT(paradox_test_equals(root->children->tag, "child") && paradox_test_inside(root->children->tag, data, length));
+    paradox_free_xml1_document(document);
+
+    // Text split by a child is joined into a copy.
+    data = "<?xml version=\"1.1\"?><root>te<child/>xt</root>";
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_parse_xml1_document(data, &document));
+    if(NULL == document) return;
+    PARADOX_TEST_EXPECT(paradox_test_equals(document->root->value, "text"));
+    PARADOX_TEST_EXPECT(PARADOX_FALSE == paradox_test_inside(document->root->value, data, strlen(data)));
+    paradox_free_xml1_document(document);
+}
+
+// Length-Delimited Input
+
+// Copies the first length bytes of data into a buffer of exactly that size, without a terminator, so that
+// reading past the end is caught by the address sanitizer.
+static char* paradox_test_copy(const char* data, const paradox_uint64_t length)
+{
+    char* copy = malloc(0 == length ? 1 : length);
+    if(NULL != copy) memcpy(copy, data, length);
+    return copy;
+}
+
+static void paradox_test_length_delimited(void)
+{
+    static paradox_test_buffer buffer;
+    for(paradox_uint64_t i = 0; i < PARADOX_TEST_CORPUS_COUNT; i++)
+    {
+        const paradox_uint64_t length = strlen(paradox_test_corpus[i]);
+        char* copy = paradox_test_copy(paradox_test_corpus[i], length);
+        PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_test_tree(copy, length, NULL, &buffer));
+        PARADOX_TEST_EXPECT(0 == strcmp(buffer.data, paradox_test_corpus_trees[i]));
+        free(copy);
+    }
+
+    // Every prefix of a document that ends with its root element cuts the root element short.
+    for(paradox_uint64_t i = 0; i < PARADOX_TEST_CORPUS_COUNT; i++)
+    {
+        const paradox_uint64_t length = strlen(paradox_test_corpus[i]);
+        if('>' != paradox_test_corpus[i][length - 1]) continue;
+        for(paradox_uint64_t prefix = 0; prefix < length; prefix++)
+        {
+            char* copy = paradox_test_copy(paradox_test_corpus[i], prefix);
+            paradox_xml1_document* document = NULL;
+            PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_INVALID_DOCUMENT == paradox_parse_xml1_document_n(copy, prefix, &document));
+            PARADOX_TEST_EXPECT(NULL == document);
+            free(copy);
+        }
+    }
+
+    // Bytes past length are not read, and a NUL inside it is not a Char.
+    const char trailing[] = "<?xml version=\"1.1\"?><r>a</r><unclosed";
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_test_tree(trailing, strlen(trailing) - 9, NULL, &buffer));
+    PARADOX_TEST_EXPECT(0 == strcmp(buffer.data, "r|a\n"));
+    const char nul[] = "<?xml version=\"1.1\"?><r>a\0b</r>";
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_INVALID_DOCUMENT == paradox_test_tree(nul, sizeof(nul) - 1, NULL, &buffer));
+}
+
+// Memory-Mapped Files
+
+static paradox_bool8_t paradox_test_write_file(const char* path, const char* data, const paradox_uint64_t length)
+{
+    FILE* file = fopen(path, "wb");
+    if(NULL == file) return PARADOX_FALSE;
+    const paradox_bool8_t written = length == fwrite(data, 1, length, file) ? PARADOX_TRUE : PARADOX_FALSE;
+    return 0 == fclose(file) && PARADOX_TRUE == written ? PARADOX_TRUE : PARADOX_FALSE;
+}
+
+static void paradox_test_file(void)
+{
+    static paradox_test_buffer buffer;
+    static char page[4096];
+    char path[] = "paradox_xml1_unit_testing.xml";
+    paradox_xml1_document* document = NULL;
+
+    for(paradox_uint64_t i = 0; i < PARADOX_TEST_CORPUS_COUNT; i++)
+    {
+        PARADOX_TEST_EXPECT(PARADOX_TRUE == paradox_test_write_file(path, paradox_test_corpus[i], strlen(paradox_test_corpus[i])));
+        PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_parse_xml1_file(path, &document));
+        if(NULL == document) continue;
+        buffer.length = 0;
+        buffer.data[0] = '\0';
+        paradox_test_canonical_tree(document, document->root, &buffer);
+        PARADOX_TEST_EXPECT(0 == strcmp(buffer.data, paradox_test_corpus_trees[i]));
+        paradox_free_xml1_document(document);
+        document = NULL;
+    }
+
+    // A file that fills its last page exactly is mapped without a byte behind it.
+    const char* head = "<?xml version=\"1.1\"?><r>";
+    memset(page, 'x', sizeof(page));
+    memcpy(page, head, strlen(head));
+    memcpy(page + sizeof(page) - 4, "</r>", 4);
+    PARADOX_TEST_EXPECT(PARADOX_TRUE == paradox_test_write_file(path, page, sizeof(page)));
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_parse_xml1_file(path, &document));
+    if(NULL != document)
+    {
+        PARADOX_TEST_EXPECT(sizeof(page) - strlen(head) - 4 == document->root->value.length);
+        paradox_free_xml1_document(document);
+        document = NULL;
+    }
+    page[sizeof(page) - 1] = 'x';
+    PARADOX_TEST_EXPECT(PARADOX_TRUE == paradox_test_write_file(path, page, sizeof(page)));
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_INVALID_DOCUMENT == paradox_parse_xml1_file(path, &document));
+
+    PARADOX_TEST_EXPECT(PARADOX_TRUE == paradox_test_write_file(path, "", 0));
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_INVALID_DOCUMENT == paradox_parse_xml1_file(path, &document));
+    remove(path);
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_FILE_ERROR == paradox_parse_xml1_file(path, &document));
+    PARADOX_TEST_EXPECT(NULL == document);
+}
+
+// Events
+
+// Builds the canonical form from events, which only know the text of an element once it ends.
+typedef struct paradox_test_events
+{
+    paradox_test_buffer* buffer;
+    // Start-tag and text of every open element.
+    paradox_test_buffer tags[16];
+    paradox_test_buffer texts[16];
+    paradox_uint64_t depth;
+
+} paradox_test_events;
+
+static paradox_bool8_t paradox_test_start_element(void* user_data, paradox_xml1_slice name)
+{
+    paradox_test_events* events = user_data;
+    if(16 == events->depth) return PARADOX_FALSE;
+    events->tags[events->depth].length = 0;
+    events->texts[events->depth].length = 0;
+    paradox_test_append_slice(&events->tags[events->depth], name);
+    events->depth++;
+    return PARADOX_TRUE;
+}
+
+static paradox_bool8_t paradox_test_attribute(void* user_data, paradox_xml1_slice name, paradox_xml1_slice value)
+{
+    paradox_test_events* events = user_data;
+    paradox_test_append_attribute(&events->tags[events->depth - 1], name, value);
+    return PARADOX_TRUE;
+}
+
+static paradox_bool8_t paradox_test_text(void* user_data, paradox_xml1_slice text)
+{
+    paradox_test_events* events = user_data;
+    paradox_test_append_slice(&events->texts[events->depth - 1], text);
+    return PARADOX_TRUE;
+}
+
+static paradox_bool8_t paradox_test_end_element(void* user_data, paradox_xml1_slice name)
+{
+    paradox_test_events* events = user_data;
+    (void)name;
+    events->depth--;
+    paradox_test_append(events->buffer, events->tags[events->depth].data, events->tags[events->depth].length);
+    paradox_test_append_string(events->buffer, "|");
+    paradox_test_append(events->buffer, events->texts[events->depth].data, events->texts[events->depth].length);
+    paradox_test_append_string(events->buffer, "\n");
+    return PARADOX_TRUE;
+}
+
+static paradox_xml1_parser_errno_t paradox_test_events_of(const char* data, const paradox_uint64_t length, const paradox_xml1_parser_options* options, paradox_test_buffer* buffer)
+{
+    static paradox_test_events events;
+    paradox_xml1_sax_handler handler = { &events, paradox_test_start_element, paradox_test_attribute, paradox_test_end_element, paradox_test_text, paradox_test_text, NULL, NULL };
+    events.buffer = buffer;
+    events.depth = 0;
+    buffer->length = 0;
+    buffer->data[0] = '\0';
+    return paradox_parse_xml1_events_with_options(data, length, options, &handler);
+}
+
+// Writes every event into a buffer as it comes, and stops the parse at the start-tag named stop.
+typedef struct paradox_test_log
+{
+    paradox_test_buffer buffer;
+    const char* stop;
+
+} paradox_test_log;
+
+static paradox_bool8_t paradox_test_log_event(paradox_test_log* log, const char* kind, const paradox_xml1_slice first, const paradox_xml1_slice* second)
+{
+    paradox_test_append_string(&log->buffer, kind);
+    paradox_test_append_string(&log->buffer, "(");
+    paradox_test_append_slice(&log->buffer, first);
+    if(NULL != second)
+    {
+        paradox_test_append_string(&log->buffer, ",");
+        paradox_test_append_slice(&log->buffer, *second);
+    }
+    paradox_test_append_string(&log->buffer, ")");
+    return PARADOX_TRUE;
+}
+
+static paradox_bool8_t paradox_test_log_start(void* user_data, paradox_xml1_slice name)
+{
+    paradox_test_log* log = user_data;
+    paradox_test_log_event(log, "S", name, NULL);
+    return NULL == log->stop || PARADOX_FALSE == paradox_test_equals(name, log->stop) ? PARADOX_TRUE : PARADOX_FALSE;
+}
+
+static paradox_bool8_t paradox_test_log_attribute(void* user_data, paradox_xml1_slice name, paradox_xml1_slice value)
+{
+    return paradox_test_log_event(user_data, "A", name, &value);
+}
+
+static paradox_bool8_t paradox_test_log_end(void* user_data, paradox_xml1_slice name)
+{
+    return paradox_test_log_event(user_data, "E", name, NULL);
+}
+
+static paradox_bool8_t paradox_test_log_char_data(void* user_data, paradox_xml1_slice text)
+{
+    return paradox_test_log_event(user_data, "T", text, NULL);
+}
+
+static paradox_bool8_t paradox_test_log_cdata(void* user_data, paradox_xml1_slice text)
+{
+    return paradox_test_log_event(user_data, "D", text, NULL);
+}
+
+static paradox_bool8_t paradox_test_log_pi(void* user_data, paradox_xml1_slice target, paradox_xml1_slice data)
+{
+    return paradox_test_log_event(user_data, "P", target, &data);
+}
+
+static paradox_bool8_t paradox_test_log_comment(void* user_data, paradox_xml1_slice text)
+{
+    return paradox_test_log_event(user_data, "C", text, NULL);
+}
+
+static paradox_xml1_parser_errno_t paradox_test_log_of(paradox_str_t data, const char* stop, paradox_test_log* log)
+{
+    paradox_xml1_sax_handler handler = { log, paradox_test_log_start, paradox_test_log_attribute, paradox_test_log_end, paradox_test_log_char_data, paradox_test_log_cdata, paradox_test_log_pi, paradox_test_log_comment };
+    log->buffer.length = 0;
+    log->buffer.data[0] = '\0';
+    log->stop = stop;
+    return paradox_parse_xml1_events(data, &handler);
+}
+
+static void paradox_test_events_agree(void)
+{
+    static paradox_test_buffer buffer;
+    for(paradox_uint64_t i = 0; i < PARADOX_TEST_CORPUS_COUNT; i++)
+    {
+        PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_test_events_of(paradox_test_corpus[i], strlen(paradox_test_corpus[i]), NULL, &buffer));
+        PARADOX_TEST_EXPECT(0 == strcmp(buffer.data, paradox_test_corpus_trees[i]));
+    }
+
+    static paradox_test_log log;
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_test_log_of("<?xml version=\"1.1\"?><r a='1' b=\"x&amp;y\">t<c>u</c>v<![CDATA[<w>]]><!--c--><?p d?></r><!--after-->", NULL, &log));
+    PARADOX_TEST_EXPECT(0 == strcmp(log.buffer.data, "S(r)A(a,1)A(b,x&y)T(t)S(c)T(u)E(c)T(v)D(<w>)C(c)P(p,d)E(r)C(after)"));
+
+    // A callback stops the parse, and the events up to an error are emitted all the same.
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_ABORTED == paradox_test_log_of("<?xml version=\"1.1\"?><r><a/><b/><c/></r>", "b", &log));
+    PARADOX_TEST_EXPECT(0 == strcmp(log.buffer.data, "S(r)S(a)E(a)S(b)"));
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_INVALID_DOCUMENT == paradox_test_log_of("<?xml version=\"1.1\"?><r><a/><b></r>", NULL, &log));
+    PARADOX_TEST_EXPECT(0 == strncmp(log.buffer.data, "S(r)S(a)E(a)S(b)", 16));
+}
+
+// Pull Reader
+
+// Adds the token the reader is on to the canonical form events builds.
+static void paradox_test_read(paradox_test_events* events, const paradox_xml1_reader* reader, const paradox_xml1_token_t token)
+{
+    paradox_xml1_slice name;
+    paradox_xml1_slice value;
+    switch(token)
+    {
+        case PARADOX_XML1_TOKEN_START_ELEMENT:
+            paradox_test_start_element(events, paradox_get_xml1_reader_name(reader));
+            for(paradox_uint64_t i = 0; PARADOX_TRUE == paradox_get_xml1_reader_attribute(reader, i, &name, &value); i++)
+            {
+                paradox_test_attribute(events, name, value);
+            }
+            break;
+        case PARADOX_XML1_TOKEN_END_ELEMENT:
+            paradox_test_end_element(events, paradox_get_xml1_reader_name(reader));
+            break;
+        case PARADOX_XML1_TOKEN_TEXT:
+        case PARADOX_XML1_TOKEN_CDATA:
+            paradox_test_text(events, paradox_get_xml1_reader_text(reader));
+            break;
+        default:
+            break;
+    }
+}
+
+static paradox_xml1_parser_errno_t paradox_test_reader_of(const char* data, const paradox_uint64_t length, paradox_test_buffer* buffer)
+{
+    static paradox_test_events events;
+    paradox_xml1_reader* reader = NULL;
+    events.buffer = buffer;
+    events.depth = 0;
+    buffer->length = 0;
+    buffer->data[0] = '\0';
+    paradox_xml1_parser_errno_t result = paradox_create_xml1_reader(data, length, &reader);
+    if(PARADOX_XML1_PARSER_SUCCESS != result) return result;
+    paradox_xml1_token_t token;
+    while(PARADOX_XML1_TOKEN_END_DOCUMENT != (token = paradox_next_xml1_token(reader)) && PARADOX_XML1_TOKEN_ERROR != token)
+    {
+        paradox_test_read(&events, reader, token);
+    }
+    result = paradox_get_xml1_reader_error(reader);
+    paradox_free_xml1_reader(reader);
+    return result;
+}
+
+static void paradox_test_reader(void)
+{
+    static paradox_test_buffer buffer;
+    for(paradox_uint64_t i = 0; i < PARADOX_TEST_CORPUS_COUNT; i++)
+    {
+        PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_test_reader_of(paradox_test_corpus[i], strlen(paradox_test_corpus[i]), &buffer));
+        PARADOX_TEST_EXPECT(0 == strcmp(buffer.data, paradox_test_corpus_trees[i]));
+    }
+
+    const char* data = "<?xml version=\"1.1\"?>\n<r a='1'><s><t>x</t><!--c--></s><?p d?><e/>y</r>\n";
+    paradox_xml1_reader* reader = NULL;
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_create_xml1_reader(data, strlen(data), &reader));
+    if(NULL == reader) return;
+    PARADOX_TEST_EXPECT(PARADOX_XML1_TOKEN_START_ELEMENT == paradox_next_xml1_token(reader));
+    PARADOX_TEST_EXPECT(paradox_test_equals(paradox_get_xml1_reader_name(reader), "r") && 1 == paradox_get_xml1_reader_depth(reader));
+    PARADOX_TEST_EXPECT(1 == paradox_get_xml1_reader_attribute_count(reader));
+    PARADOX_TEST_EXPECT(PARADOX_XML1_TOKEN_START_ELEMENT == paradox_next_xml1_token(reader));
+    PARADOX_TEST_EXPECT(paradox_test_equals(paradox_get_xml1_reader_name(reader), "s") && 2 == paradox_get_xml1_reader_depth(reader));
+    // Skips everything up to the end-tag of s.
+    PARADOX_TEST_EXPECT(PARADOX_XML1_TOKEN_END_ELEMENT == paradox_skip_xml1_subtree(reader));
+    PARADOX_TEST_EXPECT(paradox_test_equals(paradox_get_xml1_reader_name(reader), "s"));
+    PARADOX_TEST_EXPECT(PARADOX_XML1_TOKEN_PROCESSING_INSTRUCTION == paradox_next_xml1_token(reader));
+    PARADOX_TEST_EXPECT(paradox_test_equals(paradox_get_xml1_reader_name(reader), "p") && paradox_test_equals(paradox_get_xml1_reader_text(reader), "d"));
+    // An empty element is a start followed by an end.
+    PARADOX_TEST_EXPECT(PARADOX_XML1_TOKEN_START_ELEMENT == paradox_next_xml1_token(reader));
+    PARADOX_TEST_EXPECT(PARADOX_XML1_TOKEN_END_ELEMENT == paradox_next_xml1_token(reader));
+    PARADOX_TEST_EXPECT(paradox_test_equals(paradox_get_xml1_reader_name(reader), "e"));
+    PARADOX_TEST_EXPECT(PARADOX_XML1_TOKEN_TEXT == paradox_next_xml1_token(reader));
+    PARADOX_TEST_EXPECT(paradox_test_equals(paradox_get_xml1_reader_text(reader), "y"));
+    PARADOX_TEST_EXPECT(PARADOX_XML1_TOKEN_END_ELEMENT == paradox_next_xml1_token(reader));
+    PARADOX_TEST_EXPECT(0 == paradox_get_xml1_reader_depth(reader));
+    PARADOX_TEST_EXPECT(PARADOX_XML1_TOKEN_END_DOCUMENT == paradox_next_xml1_token(reader));
+    paradox_free_xml1_reader(reader);
+
+    // An error sticks.
+    data = "<?xml version=\"1.1\"?><r><a></b></r>";
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_create_xml1_reader(data, strlen(data), &reader));
+    if(NULL == reader) return;
+    PARADOX_TEST_EXPECT(PARADOX_XML1_TOKEN_START_ELEMENT == paradox_next_xml1_token(reader));
+    PARADOX_TEST_EXPECT(PARADOX_XML1_TOKEN_START_ELEMENT == paradox_next_xml1_token(reader));
+    PARADOX_TEST_EXPECT(PARADOX_XML1_TOKEN_ERROR == paradox_next_xml1_token(reader));
+    PARADOX_TEST_EXPECT(PARADOX_XML1_TOKEN_ERROR == paradox_next_xml1_token(reader));
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_INVALID_DOCUMENT == paradox_get_xml1_reader_error(reader));
+    paradox_free_xml1_reader(reader);
+}
+
+// Streaming Reader
+
+// Feeds data to a streaming reader chunk bytes at a time, each chunk from a buffer of its own that is released
+// right after the feed, and reads the tokens after every chunk.
+static paradox_xml1_parser_errno_t paradox_test_stream_of(const char* data, const paradox_uint64_t length, const paradox_uint64_t chunk, paradox_test_buffer* buffer)
+{
+    static paradox_test_events events;
+    paradox_xml1_reader* reader = NULL;
+    events.buffer = buffer;
+    events.depth = 0;
+    buffer->length = 0;
+    buffer->data[0] = '\0';
+    paradox_xml1_parser_errno_t result = paradox_create_xml1_stream_reader(&reader);
+    if(PARADOX_XML1_PARSER_SUCCESS != result) return result;
+    paradox_xml1_token_t token = PARADOX_XML1_TOKEN_NONE;
+    for(paradox_uint64_t fed = 0; PARADOX_XML1_TOKEN_END_DOCUMENT != token && PARADOX_XML1_TOKEN_ERROR != token;)
+    {
+        const paradox_uint64_t size = length - fed < chunk ? length - fed : chunk;
+        char* copy = paradox_test_copy(data + fed, size);
+        result = paradox_feed_xml1_reader(reader, copy, size, fed + size == length ? PARADOX_TRUE : PARADOX_FALSE);
+        free(copy);
+        fed += size;
+        if(PARADOX_XML1_PARSER_SUCCESS != result) break;
+        while(PARADOX_XML1_TOKEN_NONE != (token = paradox_next_xml1_token(reader)) && PARADOX_XML1_TOKEN_END_DOCUMENT != token && PARADOX_XML1_TOKEN_ERROR != token)
+        {
+            paradox_test_read(&events, reader, token);
+        }
+        if(PARADOX_XML1_TOKEN_NONE == token && fed == length) break;
+    }
+    if(PARADOX_XML1_PARSER_SUCCESS == result) result = paradox_get_xml1_reader_error(reader);
+    if(PARADOX_XML1_PARSER_SUCCESS == result && PARADOX_XML1_TOKEN_END_DOCUMENT != token) result = PARADOX_XML1_PARSER_INVALID_DOCUMENT;
+    paradox_free_xml1_reader(reader);
+    return result;
+}
+
+static void paradox_test_stream(void)
+{
+    static paradox_test_buffer buffer;
+    const paradox_uint64_t chunks[] = { 1, 2, 3, 7, 16, 64, 4096 };
+    for(paradox_uint64_t i = 0; i < PARADOX_TEST_CORPUS_COUNT; i++)
+    {
+        for(paradox_uint64_t chunk = 0; chunk < sizeof(chunks) / sizeof(chunks[0]); chunk++)
+        {
+            PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_test_stream_of(paradox_test_corpus[i], strlen(paradox_test_corpus[i]), chunks[chunk], &buffer));
+            PARADOX_TEST_EXPECT(0 == strcmp(buffer.data, paradox_test_corpus_trees[i]));
+        }
+    }
+
+    // A document cut short is only rejected once the final chunk says so.
+    const char* data = "<?xml version=\"1.1\"?><r><a>text";
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_INVALID_DOCUMENT == paradox_test_stream_of(data, strlen(data), 5, &buffer));
+    paradox_xml1_reader* reader = NULL;
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_create_xml1_stream_reader(&reader));
+    if(NULL == reader) return;
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_feed_xml1_reader(reader, data, strlen(data), PARADOX_FALSE));
+    PARADOX_TEST_EXPECT(PARADOX_XML1_TOKEN_START_ELEMENT == paradox_next_xml1_token(reader));
+    PARADOX_TEST_EXPECT(PARADOX_XML1_TOKEN_START_ELEMENT == paradox_next_xml1_token(reader));
+    paradox_xml1_token_t token = paradox_next_xml1_token(reader);
+    PARADOX_TEST_EXPECT(PARADOX_XML1_TOKEN_NONE == token || PARADOX_XML1_TOKEN_TEXT == token);
+    while(PARADOX_XML1_TOKEN_TEXT == token) token = paradox_next_xml1_token(reader);
+    PARADOX_TEST_EXPECT(PARADOX_XML1_TOKEN_NONE == token);
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_feed_xml1_reader(reader, "</a></r>", 8, PARADOX_TRUE));
+    while(PARADOX_XML1_TOKEN_TEXT == (token = paradox_next_xml1_token(reader)));
+    PARADOX_TEST_EXPECT(PARADOX_XML1_TOKEN_END_ELEMENT == token);
+    PARADOX_TEST_EXPECT(PARADOX_XML1_TOKEN_END_ELEMENT == paradox_next_xml1_token(reader));
+    PARADOX_TEST_EXPECT(PARADOX_XML1_TOKEN_END_DOCUMENT == paradox_next_xml1_token(reader));
+    paradox_free_xml1_reader(reader);
+}
+
+// Character Classes
+
+static paradox_uint64_t paradox_test_encode(const paradox_uint32_t code_point, char* utf8)
+{
+    unsigned char* bytes = (unsigned char*)utf8;
+    if(code_point < 0x80)
+    {
+        bytes[0] = (unsigned char)code_point;
+        return 1;
+    }
+    if(code_point < 0x800)
+    {
+        bytes[0] = (unsigned char)(0xC0 | (code_point >> 6));
+        bytes[1] = (unsigned char)(0x80 | (code_point & 0x3F));
+        return 2;
+    }
+    if(code_point < 0x10000)
+    {
+        bytes[0] = (unsigned char)(0xE0 | (code_point >> 12));
+        bytes[1] = (unsigned char)(0x80 | ((code_point >> 6) & 0x3F));
+        bytes[2] = (unsigned char)(0x80 | (code_point & 0x3F));
+        return 3;
+    }
+    bytes[0] = (unsigned char)(0xF0 | (code_point >> 18));
+    bytes[1] = (unsigned char)(0x80 | ((code_point >> 12) & 0x3F));
+    bytes[2] = (unsigned char)(0x80 | ((code_point >> 6) & 0x3F));
+    bytes[3] = (unsigned char)(0x80 | (code_point & 0x3F));
+    return 4;
+}
+
+// The ranges of the productions as the specification writes them.
+static paradox_bool8_t paradox_test_in(const paradox_uint32_t code_point, const paradox_uint32_t first, const paradox_uint32_t last)
+{
+    return code_point >= first && code_point <= last ? PARADOX_TRUE : PARADOX_FALSE;
+}
+
+static paradox_bool8_t paradox_test_restricted_char(const paradox_uint32_t c)
+{
+    return paradox_test_in(c, 0x1, 0x8) || paradox_test_in(c, 0xB, 0xC) || paradox_test_in(c, 0xE, 0x1F) || paradox_test_in(c, 0x7F, 0x84) || paradox_test_in(c, 0x86, 0x9F);
+}
+
+static paradox_bool8_t paradox_test_char(const paradox_uint32_t c)
+{
+    return (paradox_test_in(c, 0x1, 0xD7FF) || paradox_test_in(c, 0xE000, 0xFFFD) || paradox_test_in(c, 0x10000, 0x10FFFF)) && !paradox_test_restricted_char(c);
+}
+
+static paradox_bool8_t paradox_test_name_start_char(const paradox_uint32_t c)
+{
+    return ':' == c || paradox_test_in(c, 'A', 'Z') || '_' == c || paradox_test_in(c, 'a', 'z') || paradox_test_in(c, 0xC0, 0xD6) || paradox_test_in(c, 0xD8, 0xF6)
+        || paradox_test_in(c, 0xF8, 0x2FF) || paradox_test_in(c, 0x370, 0x37D) || paradox_test_in(c, 0x37F, 0x1FFF) || paradox_test_in(c, 0x200C, 0x200D)
+        || paradox_test_in(c, 0x2070, 0x218F) || paradox_test_in(c, 0x2C00, 0x2FEF) || paradox_test_in(c, 0x3001, 0xD7FF) || paradox_test_in(c, 0xF900, 0xFDCF)
+        || paradox_test_in(c, 0xFDF0, 0xFFFD) || paradox_test_in(c, 0x10000, 0xEFFFF);
+}
+
+static paradox_bool8_t paradox_test_name_char(const paradox_uint32_t c)
+{
+    return paradox_test_name_start_char(c) || '-' == c || '.' == c || paradox_test_in(c, '0', '9') || 0xB7 == c || paradox_test_in(c, 0x300, 0x36F) || paradox_test_in(c, 0x203F, 0x2040);
+}
+
+static void paradox_test_character_classes(void)
+{
+    char utf8[5];
+    paradox_uint64_t mismatches = 0;
+    for(paradox_uint32_t code_point = 1; code_point <= 0x10FFFF; code_point++)
+    {
+        utf8[paradox_test_encode(code_point, utf8)] = '\0';
+        if( !paradox_is_xml1_char(utf8, 0) != !paradox_test_char(code_point)
+        ||  !paradox_is_xml1_restricted_char(utf8, 0) != !paradox_test_restricted_char(code_point)
+        ||  !paradox_is_xml1_name_start_char(utf8, 0) != !paradox_test_name_start_char(code_point)
+        ||  !paradox_is_xml1_name_char(utf8, 0) != !paradox_test_name_char(code_point))
+        {
+            if(0 == mismatches++) printf("character class of U+%04X differs\n", (unsigned)code_point);
+        }
+    }
+    PARADOX_TEST_EXPECT(0 == mismatches);
+
+    // Bytes that are not UTF-8 are no Char: a lone continuation byte, an overlong form and a truncated sequence.
+    PARADOX_TEST_EXPECT(PARADOX_FALSE == paradox_is_xml1_char("\x80", 0));
+    PARADOX_TEST_EXPECT(PARADOX_FALSE == paradox_is_xml1_char("\xC0\x80", 0));
+    PARADOX_TEST_EXPECT(PARADOX_FALSE == paradox_is_xml1_char("\xE2\x82", 0));
+    PARADOX_TEST_EXPECT(PARADOX_FALSE == paradox_is_xml1_name_start_char("\xF4\x90\x80\x80", 0));
+}
+
+// UTF-8 Decoding
+
+static void paradox_test_utf8(void)
+{
+    const char* contexts[] = { "<r%s/>", "<r a='%s'/>", "<r>%s</r>", "<r><!--%s--></r>", "<r><?p %s?></r>", "<r><![CDATA[%s]]></r>" };
+    const char* valid[] = { "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80", "a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80z" };
+    // A lone continuation byte, overlong forms, a surrogate, a code point above U+10FFFF, truncated sequences
+    // and a RestrictedChar, which is well-formed UTF-8 but no Char.
+    const char* invalid[] = { "\x80", "\xC1\xBF", "\xE0\x80\xAF", "\xED\xA0\x80", "\xF4\x90\x80\x80", "\xE2\x82", "\xF0\x9F\x98", "\xC2\x84" };
+    char data[128];
+    for(paradox_uint64_t context = 0; context < sizeof(contexts) / sizeof(contexts[0]); context++)
+    {
+        for(int validate = 0; validate < 2; validate++)
+        {
+            paradox_xml1_parser_options options = { 0 };
+            options.validate_input = (paradox_bool8_t)validate;
+            for(paradox_uint64_t i = 0; i < sizeof(valid) / sizeof(valid[0]); i++)
+            {
+                paradox_xml1_document* document = NULL;
+                const int length = sprintf(data, "<?xml version=\"1.1\"?>");
+                const int written = sprintf(data + length, contexts[context], valid[i]);
+                PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_parse_xml1_document_with_options(data, (paradox_uint64_t)(length + written), &options, &document));
+                paradox_free_xml1_document(document);
+            }
+            for(paradox_uint64_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++)
+            {
+                paradox_xml1_document* document = NULL;
+                const int length = sprintf(data, "<?xml version=\"1.1\"?>");
+                const int written = sprintf(data + length, contexts[context], invalid[i]);
+                PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_INVALID_DOCUMENT == paradox_parse_xml1_document_with_options(data, (paradox_uint64_t)(length + written), &options, &document));
+            }
+        }
+    }
+
+    // Names are decoded as a whole, whatever the lengths of their sequences.
+    static paradox_test_buffer buffer;
+    const char* names = "<?xml version=\"1.1\"?><\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80 \xF0\x9F\x98\x80\xC3\xA9='v'></\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80>";
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_test_tree(names, strlen(names), NULL, &buffer));
+    PARADOX_TEST_EXPECT(0 == strcmp(buffer.data, "\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80 \xF0\x9F\x98\x80\xC3\xA9=\"v\"|\n"));
+    const char* mismatch = "<?xml version=\"1.1\"?><\xC3\xA9\xE2\x82\xAC></\xC3\xA9\xE2\x82\xAD>";
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_INVALID_DOCUMENT == paradox_test_tree(mismatch, strlen(mismatch), NULL, &buffer));
+}
+
+// Scanner Kernels
+
+// Whether every kernel set this CPU supports parses length bytes of data under options into the same tree, or
+// rejects it the same way, as the scalar one. Parses from a buffer of exactly length bytes, so that a vector
+// load past the end is caught by the address sanitizer.
+static paradox_bool8_t paradox_test_kernels_agree(const char* data, const paradox_uint64_t length, const paradox_xml1_parser_options* options)
+{
+    static paradox_test_buffer expected;
+    static paradox_test_buffer buffer;
+    const paradox_xml1_kernel_t selected = paradox_get_xml1_kernel();
+    char* copy = paradox_test_copy(data, length);
+    paradox_bool8_t agree = PARADOX_TRUE;
+    paradox_set_xml1_kernel(PARADOX_XML1_KERNEL_SCALAR);
+    const paradox_xml1_parser_errno_t result = paradox_test_tree(copy, length, options, &expected);
+    for(paradox_xml1_kernel_t kernel = PARADOX_XML1_KERNEL_SSE2; kernel <= PARADOX_XML1_KERNEL_AVX512BW; kernel++)
+    {
+        if(PARADOX_FALSE == paradox_set_xml1_kernel(kernel)) break;
+        if(result != paradox_test_tree(copy, length, options, &buffer) || 0 != strcmp(expected.data, buffer.data))
+        {
+            printf("kernel %s differs from scalar on %.*s\n", paradox_get_xml1_kernel_name(kernel), (int)length, data);
+            agree = PARADOX_FALSE;
+        }
+    }
+    paradox_set_xml1_kernel(selected);
+    free(copy);
+    return agree;
+}
+
+// Builds the prologue, the start-tag of the root, pad bytes of filler, inner and the end-tag of the root into data.
+static paradox_uint64_t paradox_test_padded(char* data, const char* inner, const paradox_uint64_t pad, const char filler)
+{
+    paradox_uint64_t length = (paradox_uint64_t)sprintf(data, "<?xml version=\"1.1\"?><r>");
+    memset(data + length, filler, pad);
+    length += pad;
+    return length + (paradox_uint64_t)sprintf(data + length, "%s</r>", inner);
+}
+
+// Filler for the content of markup, longer than any offset the kernels are tested at.
+static const char paradox_test_filler[] = "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx";
+
+static void paradox_test_char_data_kernels(void)
+{
+    // What CharData stops at or has to look closer at, placed around every offset of the first 64-byte blocks.
+    const char* specials[] = { "<c/>", "&amp;", "&#xE9;", "]]>", "]]", "]", "\xC3\xA9", "\xE2\x82\xAC", "\xF0\x9F\x98\x80", "\x7F", "\x01", "\xC2\x84", "\t\r\n", "" };
+    static char data[512];
+    for(int validate = 0; validate < 2; validate++)
+    {
+        paradox_xml1_parser_options options = { 0 };
+        options.validate_input = (paradox_bool8_t)validate;
+        for(paradox_uint64_t special = 0; special < sizeof(specials) / sizeof(specials[0]); special++)
+        {
+            for(paradox_uint64_t pad = 0; pad < 140; pad++)
+            {
+                char inner[64];
+                sprintf(inner, "%s%.*s", specials[special], (int)(pad % 5), "bbbb");
+                const paradox_uint64_t length = paradox_test_padded(data, inner, pad, 'a');
+                PARADOX_TEST_EXPECT(PARADOX_TRUE == paradox_test_kernels_agree(data, length, &options));
+            }
+        }
+    }
+}
+
+static void paradox_test_terminator_kernels(void)
+{
+    // The terminators and their near misses, placed around every offset of the first 64-byte blocks.
+    const char* comments[] = { "-", "- -", "--", "-->x", "\xC3\xA9", "\x01", "" };
+    const char* sections[] = { "]", "]]", "]>", "] ]>", "]]]", "<&", "\xE2\x82\xAC", "\x01", "" };
+    const char* instructions[] = { "?", "? >", ">", "??", "\xF0\x9F\x98\x80", "\x01", "" };
+    const char* ignored[] = { "<!", "<![", "<![x]]>", "]]", "] ]>", "\xC3\xA9", "\x01", "" };
+    static char data[512];
+    static char inner[256];
+    for(int validate = 0; validate < 2; validate++)
+    {
+        paradox_xml1_parser_options options = { 0 };
+        options.validate_input = (paradox_bool8_t)validate;
+        for(paradox_uint64_t pad = 0; pad < 140; pad++)
+        {
+            for(paradox_uint64_t i = 0; i < sizeof(comments) / sizeof(comments[0]); i++)
+            {
+                sprintf(inner, "<!--%.*s%s-->", (int)pad, paradox_test_filler, comments[i]);
+                PARADOX_TEST_EXPECT(PARADOX_TRUE == paradox_test_kernels_agree(data, paradox_test_padded(data, inner, pad % 7, 'a'), &options));
+            }
+            for(paradox_uint64_t i = 0; i < sizeof(sections) / sizeof(sections[0]); i++)
+            {
+                sprintf(inner, "<![CDATA[%.*s%s]]>", (int)pad, paradox_test_filler, sections[i]);
+                PARADOX_TEST_EXPECT(PARADOX_TRUE == paradox_test_kernels_agree(data, paradox_test_padded(data, inner, pad % 7, 'a'), &options));
+            }
+            for(paradox_uint64_t i = 0; i < sizeof(instructions) / sizeof(instructions[0]); i++)
+            {
+                sprintf(inner, "<?p %.*s%s?>", (int)pad, paradox_test_filler, instructions[i]);
+                PARADOX_TEST_EXPECT(PARADOX_TRUE == paradox_test_kernels_agree(data, paradox_test_padded(data, inner, pad % 7, 'a'), &options));
+            }
+        }
+    }
+
+    // Ignored sections are only read by the production, which takes terminated input.
+    const paradox_xml1_kernel_t selected = paradox_get_xml1_kernel();
+    for(paradox_uint64_t pad = 0; pad < 140; pad++)
+    {
+        for(paradox_uint64_t i = 0; i < sizeof(ignored) / sizeof(ignored[0]); i++)
+        {
+            sprintf(data, "<![IGNORE[%.*s%s]]>", (int)pad, paradox_test_filler, ignored[i]);
+            paradox_set_xml1_kernel(PARADOX_XML1_KERNEL_SCALAR);
+            paradox_uint64_t expected = 0;
+            const paradox_xml1_parser_errno_t result = paradox_parse_xml1_ignore_sect(data, &expected);
+            for(paradox_xml1_kernel_t kernel = PARADOX_XML1_KERNEL_SSE2; kernel <= PARADOX_XML1_KERNEL_AVX512BW && PARADOX_TRUE == paradox_set_xml1_kernel(kernel); kernel++)
+            {
+                paradox_uint64_t index = 0;
+                PARADOX_TEST_EXPECT(result == paradox_parse_xml1_ignore_sect(data, &index) && expected == index);
+            }
+        }
+    }
+    paradox_set_xml1_kernel(selected);
+}
+
+// Up-Front Validation
+
+static void paradox_test_validation(void)
+{
+    // Sequences that straddle every offset of the first 64-byte blocks, well-formed and not.
+    const char* valid[] = { "\xC3\xA9", "\xE2\x82\xAC", "\xEF\xBF\xBD", "\xF0\x9F\x98\x80", "\xF4\x8F\xBF\xBF", "\xC2\x85", "\t\n\r" };
+    const char* invalid[] = { "\x80", "\xBF", "\xC0\xAF", "\xC1\xBF", "\xE0\x9F\xBF", "\xED\xA0\x80", "\xED\xBF\xBF", "\xEF\xBF\xBE", "\xEF\xBF\xBF", "\xF0\x8F\xBF\xBF", "\xF4\x90\x80\x80", "\xF5\x80\x80\x80", "\xFF", "\xC3", "\xE2\x82", "\xF0\x9F\x98", "\xC3\xA9\x80", "\x01", "\x1F", "\x7F", "\xC2\x80", "\xC2\x9F" };
+    static char data[512];
+    paradox_xml1_parser_options options = { 0 };
+    options.validate_input = PARADOX_TRUE;
+    for(paradox_uint64_t pad = 0; pad < 140; pad++)
+    {
+        for(paradox_uint64_t i = 0; i < sizeof(valid) / sizeof(valid[0]); i++)
+        {
+            static paradox_test_buffer buffer;
+            const paradox_uint64_t length = paradox_test_padded(data, valid[i], pad, 'a');
+            PARADOX_TEST_EXPECT(PARADOX_TRUE == paradox_test_kernels_agree(data, length, &options));
+            PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_test_tree(data, length, &options, &buffer));
+        }
+        for(paradox_uint64_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++)
+        {
+            static paradox_test_buffer buffer;
+            paradox_uint64_t length = paradox_test_padded(data, invalid[i], pad, 'a');
+            PARADOX_TEST_EXPECT(PARADOX_TRUE == paradox_test_kernels_agree(data, length, &options));
+            PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_INVALID_DOCUMENT == paradox_test_tree(data, length, &options, &buffer));
+            // Markup the parse does not look into is validated all the same.
+            length = (paradox_uint64_t)sprintf(data, "<?xml version=\"1.1\"?><r/><!--%.*s%s-->", (int)pad, paradox_test_filler, invalid[i]);
+            PARADOX_TEST_EXPECT(PARADOX_TRUE == paradox_test_kernels_agree(data, length, &options));
+            PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_INVALID_DOCUMENT == paradox_test_tree(data, length, &options, &buffer));
+        }
+    }
+}
+
+// Kernel Selection
+
+static void paradox_test_kernel_selection(void)
+{
+    const paradox_xml1_kernel_t selected = paradox_get_xml1_kernel();
+    PARADOX_TEST_EXPECT(selected <= PARADOX_XML1_KERNEL_AVX512BW);
+    PARADOX_TEST_EXPECT(0 != strcmp(paradox_get_xml1_kernel_name(selected), "unknown"));
+    // The kernel set selected at load time is the best one the CPU supports.
+    PARADOX_TEST_EXPECT(selected == PARADOX_XML1_KERNEL_AVX512BW || PARADOX_FALSE == paradox_set_xml1_kernel((paradox_xml1_kernel_t)(selected + 1)));
+    PARADOX_TEST_EXPECT(selected == paradox_get_xml1_kernel());
+    PARADOX_TEST_EXPECT(PARADOX_FALSE == paradox_set_xml1_kernel((paradox_xml1_kernel_t)(PARADOX_XML1_KERNEL_AVX512BW + 1)));
+    PARADOX_TEST_EXPECT(selected == paradox_get_xml1_kernel());
+
+    static paradox_test_buffer buffer;
+    for(paradox_xml1_kernel_t kernel = PARADOX_XML1_KERNEL_SCALAR; kernel <= selected; kernel++)
+    {
+        PARADOX_TEST_EXPECT(PARADOX_TRUE == paradox_set_xml1_kernel(kernel));
+        PARADOX_TEST_EXPECT(kernel == paradox_get_xml1_kernel());
+        for(paradox_uint64_t i = 0; i < PARADOX_TEST_CORPUS_COUNT; i++)
+        {
+            PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_test_tree(paradox_test_corpus[i], strlen(paradox_test_corpus[i]), NULL, &buffer));
+            PARADOX_TEST_EXPECT(0 == strcmp(buffer.data, paradox_test_corpus_trees[i]));
+        }
+    }
+    paradox_set_xml1_kernel(selected);
+}
+
+// Dispatch
+
+// The result of parsing body behind the XML declaration, which the tree and the events agree on.
+static paradox_xml1_parser_errno_t paradox_test_parse_body(const char* body)
+{
+    static char data[1024];
+    static paradox_test_buffer buffer;
+    const paradox_uint64_t length = (paradox_uint64_t)sprintf(data, "<?xml version=\"1.1\"?>%s", body);
+    const paradox_xml1_parser_errno_t result = paradox_test_tree(data, length, NULL, &buffer);
+    PARADOX_TEST_EXPECT(result == paradox_test_events_of(data, length, NULL, &buffer));
+    return result;
+}
+
+static void paradox_test_dispatch(void)
+{
+    const char* accepted[] =
+    {
+        "<r><?p?><?p d?><!--c--><!----><![CDATA[x]]><![CDATA[]]>&amp;&#65;&#x41;<c/><c a='1'/><c></c>t</r>",
+        "<!--a--><?p?> <r/> <!--b--><?q?>",
+        "<!DOCTYPE r><r/>",
+        "<!DOCTYPE r SYSTEM 'u'><r/>",
+        "<!DOCTYPE r PUBLIC 'p' 'u'><r/>",
+        "<!DOCTYPE r [<!ELEMENT r ANY><!ATTLIST r a CDATA #IMPLIED><!ENTITY e 'x'><!ENTITY % p '<!ENTITY f \"y\">'><!NOTATION n SYSTEM 'u'><!NOTATION m PUBLIC 'p'><?pi x?><!-- c --> %p;]><r>&e;</r>"
+    };
+    const char* rejected[] =
+    {
+        "<r><!x></r>",
+        "<r><!-x--></r>",
+        "<r><!--x---></r>",
+        "<r><!--x--y--></r>",
+        "<r><![CDAT[x]]></r>",
+        "<r><![cdata[x]]></r>",
+        "<r><?xml version='1.1'?></r>",
+        "<r><?XmL?></r>",
+        "<r><? p?></r>",
+        "<r>&;</r>",
+        "<r>&#;</r>",
+        "<r>&#x;</r>",
+        "<r>&#xG;</r>",
+        "<r>&undeclared;</r>",
+        "<r></ r>",
+        "<r><1/></r>",
+        "<r>]]></r>",
+        "<r/><r/>",
+        "<!DOCTYPE r [<!ELEMENTr ANY>]><r/>",
+        "<!DOCTYPE r [<!FOO>]><r/>",
+        "<!DOCTYPE r [<!ENTITY e>]><r/>",
+        "<!DOCTYPE r SYSTEM><r/>",
+        "<r/><!DOCTYPE r>"
+    };
+    for(paradox_uint64_t i = 0; i < sizeof(accepted) / sizeof(accepted[0]); i++)
+    {
+        PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_test_parse_body(accepted[i]));
+    }
+    for(paradox_uint64_t i = 0; i < sizeof(rejected) / sizeof(rejected[0]); i++)
+    {
+        PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_INVALID_DOCUMENT == paradox_test_parse_body(rejected[i]));
+    }
+}
+
+typedef struct paradox_test_production
+{
+    paradox_xml1_parser_errno_t (*parse)(paradox_str_t xml_string, paradox_uint64_t* index);
+    const char* text;
+
+} paradox_test_production;
+
+static void paradox_test_productions(void)
+{
+    const paradox_test_production productions[] =
+    {
+        { paradox_parse_xml1_space, " \t\n" },
+        { paradox_parse_xml1_name, "a:b-c.d" },
+        { paradox_parse_xml1_names, "a b c" },
+        { paradox_parse_xml1_nm_token, "-1a" },
+        { paradox_parse_xml1_nm_tokens, "1 2" },
+        { paradox_parse_xml1_entity_value, "'a%p;&e;&#65;'" },
+        { paradox_parse_xml1_att_value, "'a&amp;b'" },
+        { paradox_parse_xml1_system_literal, "'u'" },
+        { paradox_parse_xml1_pubid_literal, "'p-id'" },
+        { paradox_parse_xml1_char_data, "abc" },
+        { paradox_parse_xml1_comment, "<!--c-->" },
+        { paradox_parse_xml1_pi, "<?p d?>" },
+        { paradox_parse_xml1_pi_target, "p" },
+        { paradox_parse_xml1_cd_sect, "<![CDATA[x]]>" },
+        { paradox_parse_xml1_cd_start, "<![CDATA[" },
+        { paradox_parse_xml1_c_data, "x" },
+        { paradox_parse_xml1_cd_end, "]]>" },
+        { paradox_parse_xml1_prolog, "<?xml version=\"1.1\"?><!--c-->" },
+        { paradox_parse_xml1_xml_decl, "<?xml version=\"1.1\" encoding=\"UTF-8\" standalone=\"yes\"?>" },
+        { paradox_parse_xml1_version_info, " version=\"1.1\"" },
+        { paradox_parse_xml1_eq, " = " },
+        { paradox_parse_xml1_version_num, "1.1" },
+        { paradox_parse_xml1_misc, "<!--c-->" },
+        { paradox_parse_xml1_doctypedecl, "<!DOCTYPE r [<!ELEMENT r ANY>]>" },
+        { paradox_parse_xml1_decl_sep, " " },
+        { paradox_parse_xml1_int_subset, "<!ELEMENT r ANY><!--c-->" },
+        { paradox_parse_xml1_markupdecl, "<!ELEMENT r ANY>" },
+        { paradox_parse_xml1_ext_subset_decl, "<![INCLUDE[<!ELEMENT r ANY>]]>" },
+        { paradox_parse_xml1_sd_decl, " standalone='no'" },
+        { paradox_parse_xml1_element, "<r a='1'>t<c/></r>" },
+        { paradox_parse_xml1_s_tag, "<r a='1'>" },
+        { paradox_parse_xml1_attribute, "a='1'" },
+        { paradox_parse_xml1_e_tag, "</r>" },
+        { paradox_parse_xml1_content, "t<c/>&amp;" },
+        { paradox_parse_xml1_empty_elem_tag, "<c a='1'/>" },
+        { paradox_parse_xml1_elementdecl, "<!ELEMENT r (a|b)*>" },
+        { paradox_parse_xml1_contentspec, "(#PCDATA|a)*" },
+        { paradox_parse_xml1_children, "(a,(b|c)+)?" },
+        { paradox_parse_xml1_cp, "a*" },
+        { paradox_parse_xml1_choice, "(a|b)" },
+        { paradox_parse_xml1_seq, "(a,b)" },
+        { paradox_parse_xml1_mixed, "(#PCDATA)" },
+        { paradox_parse_xml1_attlist_decl, "<!ATTLIST r a CDATA #IMPLIED>" },
+        { paradox_parse_xml1_att_def, " a CDATA #IMPLIED" },
+        { paradox_parse_xml1_att_type, "ID" },
+        { paradox_parse_xml1_string_type, "CDATA" },
+        { paradox_parse_xml1_tokenized_type, "NMTOKENS" },
+        { paradox_parse_xml1_enumerated_type, "(a|b)" },
+        { paradox_parse_xml1_notation_type, "NOTATION (n)" },
+        { paradox_parse_xml1_enumeration, "( a | b )" },
+        { paradox_parse_xml1_default_decl, "#FIXED 'v'" },
+        { paradox_parse_xml1_conditional_sect, "<![IGNORE[<![x[]]>]]>" },
+        { paradox_parse_xml1_include_sect, "<![INCLUDE[]]>" },
+        { paradox_parse_xml1_ignore_sect, "<![IGNORE[x]]>" },
+        { paradox_parse_xml1_ignore_sect_contents, "x<![y]]>z" },
+        { paradox_parse_xml1_ignore, "x" },
+        { paradox_parse_xml1_char_ref, "&#x41;" },
+        { paradox_parse_xml1_reference, "&e;" },
+        { paradox_parse_xml1_entity_ref, "&e;" },
+        { paradox_parse_xml1_pe_reference, "%p;" },
+        { paradox_parse_xml1_entity_decl, "<!ENTITY e 'x'>" },
+        { paradox_parse_xml1_ge_decl, "<!ENTITY e SYSTEM 'u' NDATA n>" },
+        { paradox_parse_xml1_pe_decl, "<!ENTITY % p 'x'>" },
+        { paradox_parse_xml1_entity_def, "'x'" },
+        { paradox_parse_xml1_pe_def, "SYSTEM 'u'" },
+        { paradox_parse_xml1_external_id, "PUBLIC 'p' 'u'" },
+        { paradox_parse_xml1_ndata_decl, " NDATA n" },
+        { paradox_parse_xml1_text_decl, "<?xml encoding='UTF-8'?>" },
+        { paradox_parse_xml1_ext_parsed_ent, "<?xml encoding='UTF-8'?>t<c/>" },
+        { paradox_parse_xml1_encoding_decl, " encoding='UTF-8'" },
+        { paradox_parse_xml1_enc_name, "UTF-8" },
+        { paradox_parse_xml1_notation_decl, "<!NOTATION n PUBLIC 'p'>" },
+        { paradox_parse_xml1_public_id, "PUBLIC 'p'" }
+    };
+    for(size_t i = 0; i < sizeof(productions) / sizeof(productions[0]); i++)
+    {
+        const paradox_test_production* production = &productions[i];
+        const paradox_uint64_t length = strlen(production->text);
+        paradox_uint64_t index = 0;
+        PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_NULL_DOCUMENT == production->parse(NULL, &index));
+        PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_NULL_INDEX == production->parse((paradox_str_t)production->text, NULL));
+
+        // The production runs from an index into the string and leaves it behind what it took.
+        char* data = malloc(length + 2);
+        data[0] = '@';
+        memcpy(data + 1, production->text, length + 1);
+        index = 1;
+        PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == production->parse(data, &index));
+        PARADOX_TEST_EXPECT(1 + length == index);
+        free(data);
+
+        // A mismatch leaves the index where it was, and no prefix reads past its end or fails to return.
+        for(paradox_uint64_t prefix = 0; prefix < length; prefix++)
+        {
+            data = malloc(prefix + 1);
+            memcpy(data, production->text, prefix);
+            data[prefix] = '\0';
+            index = 0;
+            const paradox_xml1_parser_errno_t result = production->parse(data, &index);
+            if(PARADOX_XML1_PARSER_SUCCESS == result) PARADOX_TEST_EXPECT(index <= prefix);
+            else PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_INVALID_DOCUMENT == result && 0 == index);
+            free(data);
+        }
+    }
+}
+
+// Indexed Engine
+
+static void paradox_test_indexed(void)
+{
+    static paradox_test_buffer expected;
+    static paradox_test_buffer buffer;
+    static char data[4096];
+    const char* documents[] =
+    {
+        "<?xml version=\"1.1\"?><r><a x='>' y=\"<&amp;\">1</a><!-- <a> --><?p <a>?><![CDATA[</a>]]><b/></r>",
+        "<?xml version=\"1.1\"?><r>\xC3\xA9<\xC3\xA9 \xC3\xA9='\xE2\x82\xAC'/>&#xE9;</r>",
+        "<?xml version=\"1.1\"?><r></s>",
+        "<?xml version=\"1.1\"?><r><a></r>",
+        "<?xml version=\"1.1\"?><r a='1' a='2'/>",
+        "<?xml version=\"1.1\"?><r>a]]>b</r>",
+        "<?xml version=\"1.1\"?><r><!-- x --- --></r>",
+        "<?xml version=\"1.1\"?><r>\x01</r>",
+        "<?xml version=\"1.1\"?><r>",
+        "<?xml version=\"1.1\"?><r/>t"
+    };
+    paradox_xml1_parser_options options = { 0 };
+    options.mode = PARADOX_XML1_PARSE_MODE_INDEXED;
+    for(paradox_uint64_t i = 0; i < PARADOX_TEST_CORPUS_COUNT + sizeof(documents) / sizeof(documents[0]); i++)
+    {
+        const char* document = i < PARADOX_TEST_CORPUS_COUNT ? paradox_test_corpus[i] : documents[i - PARADOX_TEST_CORPUS_COUNT];
+        const paradox_uint64_t length = strlen(document);
+        const paradox_xml1_parser_errno_t result = paradox_test_tree(document, length, NULL, &expected);
+        PARADOX_TEST_EXPECT(result == paradox_test_tree(document, length, &options, &buffer));
+        PARADOX_TEST_EXPECT(0 == strcmp(expected.data, buffer.data));
+        // Events before an error may differ, as the indexed engine validates the input up front.
+        paradox_test_events_of(document, length, NULL, &expected);
+        PARADOX_TEST_EXPECT(result == paradox_test_events_of(document, length, &options, &buffer));
+        if(PARADOX_XML1_PARSER_SUCCESS == result) PARADOX_TEST_EXPECT(0 == strcmp(expected.data, buffer.data));
+        PARADOX_TEST_EXPECT(PARADOX_TRUE == paradox_test_kernels_agree(document, length, &options));
+    }
+
+    // Markup the index has to find at every offset of the vector blocks.
+    for(paradox_uint64_t pad = 0; pad < 130; pad++)
+    {
+        const paradox_uint64_t length = paradox_test_padded(data, "<a b='&lt;'>c<!--d--><?e f?><![CDATA[<g>]]>&#x48;</a>", pad, ' ');
+        const paradox_xml1_parser_errno_t result = paradox_test_tree(data, length, NULL, &expected);
+        PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == result);
+        PARADOX_TEST_EXPECT(result == paradox_test_tree(data, length, &options, &buffer));
+        PARADOX_TEST_EXPECT(0 == strcmp(expected.data, buffer.data));
+        PARADOX_TEST_EXPECT(PARADOX_TRUE == paradox_test_kernels_agree(data, length, &options));
+    }
+}
+
+// Split Parse
+
+static paradox_bool8_t paradox_test_same_slice(const paradox_xml1_slice first, const paradox_xml1_slice second)
+{
+    return first.length == second.length && 0 == memcmp(first.data, second.data, first.length) ? PARADOX_TRUE : PARADOX_FALSE;
+}
+
+// Compares the siblings from first and second and their subtrees, parent pointers included, as the
+// canonical form of a document too large for a paradox_test_buffer would be cut short.
+static paradox_bool8_t paradox_test_same_tree(paradox_xml1_document* first_document, paradox_xml1_element* first, paradox_xml1_document* second_document, paradox_xml1_element* second)
+{
+    for(; NULL != first && NULL != second; first = first->next, second = second->next)
+    {
+        if(PARADOX_FALSE == paradox_test_same_slice(first->tag, second->tag)) return PARADOX_FALSE;
+        paradox_xml1_slice first_value;
+        paradox_xml1_slice second_value;
+        paradox_get_xml1_element_value(first_document, first, &first_value);
+        paradox_get_xml1_element_value(second_document, second, &second_value);
+        if(PARADOX_FALSE == paradox_test_same_slice(first_value, second_value)) return PARADOX_FALSE;
+        paradox_xml1_attribute* first_attribute = first->attributes;
+        paradox_xml1_attribute* second_attribute = second->attributes;
+        for(; NULL != first_attribute && NULL != second_attribute; first_attribute = first_attribute->next, second_attribute = second_attribute->next)
+        {
+            paradox_get_xml1_attribute_value(first_document, first_attribute, &first_value);
+            paradox_get_xml1_attribute_value(second_document, second_attribute, &second_value);
+            if(PARADOX_FALSE == paradox_test_same_slice(first_attribute->tag, second_attribute->tag)) return PARADOX_FALSE;
+            if(PARADOX_FALSE == paradox_test_same_slice(first_value, second_value)) return PARADOX_FALSE;
+            if(second_attribute != paradox_find_xml1_attribute(second, second_attribute->symbol)) return PARADOX_FALSE;
+        }
+        if(NULL != first_attribute || NULL != second_attribute) return PARADOX_FALSE;
+        for(paradox_xml1_element* child = second->children; NULL != child; child = child->next)
+        {
+            if(second != child->parent) return PARADOX_FALSE;
+        }
+        if(PARADOX_FALSE == paradox_test_same_tree(first_document, first->children, second_document, second->children)) return PARADOX_FALSE;
+    }
+    return NULL == first && NULL == second ? PARADOX_TRUE : PARADOX_FALSE;
+}
+
+// Builds a root of about length bytes of items, with the markup of an item hidden in comments and processing
+// instructions when variant is 1, and in CDATA sections when it is 2. Returns the length of the document.
+static paradox_uint64_t paradox_test_items(char* data, const paradox_uint64_t length, const int variant)
+{
+    paradox_uint64_t written = (paradox_uint64_t)sprintf(data, "<?xml version=\"1.1\"?><root a='1'>lead&amp;");
+    for(int i = 0; written + 600 < length; i++)
+    {
+        if(1 == variant && 7 == i % 50) written += (paradox_uint64_t)sprintf(data + written, "<!-- <item> in a comment --><?pi <item> ?>");
+        if(2 == variant && 3 == i % 40) written += (paradox_uint64_t)sprintf(data + written, "<![CDATA[ <item> ]]>");
+        written += (paradox_uint64_t)sprintf(data + written, "<item id='%d'%s>t%d&lt;<sub>s</sub><item>nested</item></item>tail%d\n", i,
+            0 == i % 9 ? " a1='1' a2='2' a3='3' a4='4' a5='5' a6='6' a7='7' a8='8' a9='9' a10='10'" : "", i, i);
+    }
+    return written + (paradox_uint64_t)sprintf(data + written, "</root>");
+}
+
+static void paradox_test_split(void)
+{
+    const paradox_uint64_t capacity = 3 << 20;
+    char* data = malloc(capacity + 1024);
+    for(int variant = 0; variant < 3; variant++)
+    {
+        const paradox_uint64_t length = paradox_test_items(data, capacity, variant);
+        for(int validate = 0; validate < 2; validate++)
+        {
+            paradox_xml1_parser_options single = { 0 };
+            single.validate_input = (paradox_bool8_t)validate;
+            paradox_xml1_parser_options split = single;
+            split.threads = 4;
+            paradox_xml1_document* expected = NULL;
+            paradox_xml1_document* document = NULL;
+            PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_parse_xml1_document_with_options(data, length, &single, &expected));
+            PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_parse_xml1_document_with_options(data, length, &split, &document));
+            if(NULL == expected || NULL == document) continue;
+            PARADOX_TEST_EXPECT(NULL == document->root->parent);
+            PARADOX_TEST_EXPECT(PARADOX_TRUE == paradox_test_same_tree(expected, expected->root, document, document->root));
+            paradox_free_xml1_document(expected);
+            paradox_free_xml1_document(document);
+        }
+
+        // An end-tag that does not match in the middle of the root fails the whole parse.
+        memcpy(strstr(data + length / 2, "</item>"), "</itex>", 7);
+        paradox_xml1_parser_options split = { 0 };
+        split.threads = 4;
+        paradox_xml1_document* document = NULL;
+        PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_INVALID_DOCUMENT == paradox_parse_xml1_document_with_options(data, length, &split, &document));
+    }
+
+    // Runs parse the input as validated only once every share of it is, so a UTF-8 sequence cut short at the very end
+    // of an input that is no longer than the document is never decoded without checks.
+    paradox_xml1_parser_options split = { 0 };
+    split.validate_input = PARADOX_TRUE;
+    split.threads = 4;
+    paradox_uint64_t length = (paradox_uint64_t)sprintf(data, "<?xml version=\"1.1\"?><root a='1'>");
+    for(int index = 0; length + 600 < (2 << 20); index++)
+    {
+        length += (paradox_uint64_t)sprintf(data + length, "<item id='%d'>t<sub>s</sub></item>tail\n", index);
+    }
+    length += (paradox_uint64_t)sprintf(data + length, "<c\xF0");
+    char* copy = paradox_test_copy(data, length);
+    paradox_xml1_document* document = NULL;
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_INVALID_DOCUMENT == paradox_parse_xml1_document_with_options(copy, length, &split, &document));
+    free(copy);
+
+    // A document type declaration keeps the root whole, and the input is still validated up front.
+    length = paradox_test_items(data, 2 << 20, 0);
+    const char* doctype = "<!DOCTYPE root [<!ENTITY e 'x'>]>";
+    const paradox_uint64_t prolog = strlen("<?xml version=\"1.1\"?>");
+    memmove(data + prolog + strlen(doctype), data + prolog, length - prolog);
+    memcpy(data + prolog, doctype, strlen(doctype));
+    length += strlen(doctype);
+    paradox_xml1_parser_options single = { 0 };
+    single.validate_input = PARADOX_TRUE;
+    paradox_xml1_document* expected = NULL;
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_parse_xml1_document_with_options(data, length, &single, &expected));
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_parse_xml1_document_with_options(data, length, &split, &document));
+    if(NULL != expected && NULL != document) PARADOX_TEST_EXPECT(PARADOX_TRUE == paradox_test_same_tree(expected, expected->root, document, document->root));
+    paradox_free_xml1_document(expected);
+    paradox_free_xml1_document(document);
+    data[length - 100] = '\x01';
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_INVALID_DOCUMENT == paradox_parse_xml1_document_with_options(data, length, &split, &document));
+    free(data);
+}
+
+// Batches
+
+static void paradox_test_batch(void)
+{
+    static paradox_test_buffer expected;
+    static paradox_test_buffer buffer;
+    static paradox_xml1_slice inputs[200];
+    static paradox_xml1_parser_output outputs[200];
+    const paradox_uint64_t count = sizeof(inputs) / sizeof(inputs[0]);
+    const char* laughs =
+        "<?xml version=\"1.1\"?><!DOCTYPE r [<!ENTITY a 'aaaaaaaaaa'><!ENTITY b '&a;&a;&a;&a;&a;&a;&a;&a;&a;&a;'>"
+        "<!ENTITY c '&b;&b;&b;&b;&b;&b;&b;&b;&b;&b;'><!ENTITY d '&c;&c;&c;&c;&c;&c;&c;&c;&c;&c;'>"
+        "<!ENTITY e '&d;&d;&d;&d;&d;&d;&d;&d;&d;&d;'><!ENTITY f '&e;&e;&e;&e;&e;&e;&e;&e;&e;&e;'>"
+        "<!ENTITY g '&f;&f;&f;&f;&f;&f;&f;&f;&f;&f;'><!ENTITY h '&g;&g;&g;&g;&g;&g;&g;&g;&g;&g;'>]><r>&h;</r>";
+    for(paradox_uint64_t i = 0; i < count; i++)
+    {
+        const char* document = 50 == i ? laughs : 120 == i ? "<?xml version=\"1.1\"?><r></s>" : paradox_test_corpus[i % PARADOX_TEST_CORPUS_COUNT];
+        inputs[i].data = document;
+        inputs[i].length = strlen(document);
+    }
+    paradox_xml1_parser_pool* pool = NULL;
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_create_xml1_parser_pool(3, &pool));
+
+    // On the calling thread, on threads started for the call, and twice on the same pool.
+    for(int run = 0; run < 4; run++)
+    {
+        paradox_xml1_parser_options options = { 0 };
+        options.threads = 1 == run ? 4 : 0;
+        options.pool = 2 <= run ? pool : NULL;
+        memset(outputs, 0, sizeof(outputs));
+        // The document at 50 is the first that fails, with the error of its own.
+        PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_ENTITY_LIMIT == paradox_parse_xml1_documents(inputs, count, outputs, &options));
+        for(paradox_uint64_t i = 0; i < count; i++)
+        {
+            const paradox_xml1_parser_errno_t result = paradox_test_tree(inputs[i].data, inputs[i].length, NULL, &expected);
+            PARADOX_TEST_EXPECT(result == outputs[i].result);
+            if(PARADOX_XML1_PARSER_SUCCESS != result)
+            {
+                PARADOX_TEST_EXPECT(NULL == outputs[i].document);
+                continue;
+            }
+            buffer.length = 0;
+            buffer.data[0] = '\0';
+            paradox_test_canonical_tree(outputs[i].document, outputs[i].document->root, &buffer);
+            PARADOX_TEST_EXPECT(0 == strcmp(expected.data, buffer.data));
+            paradox_free_xml1_document(outputs[i].document);
+        }
+    }
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_parse_xml1_documents(inputs, 50, outputs, NULL));
+    for(paradox_uint64_t i = 0; i < 50; i++)
+    {
+        paradox_free_xml1_document(outputs[i].document);
+    }
+    paradox_free_xml1_parser_pool(pool);
+}
+
+// Tape
+
+static void paradox_test_canonical_tape(const paradox_xml1_tape* tape, const paradox_uint32_t node, paradox_test_buffer* buffer)
+{
+    const paradox_xml1_tape_node* element = &tape->nodes[node];
+    for(paradox_uint32_t child = element->first_child; PARADOX_XML1_TAPE_NONE != child; child = tape->nodes[child].next_sibling)
+    {
+        paradox_test_canonical_tape(tape, child, buffer);
+    }
+    paradox_test_append_slice(buffer, element->tag);
+    for(paradox_uint32_t i = 0; i < element->attribute_count; i++)
+    {
+        const paradox_xml1_tape_attribute* attribute = &tape->attributes[element->attribute_start + i];
+        paradox_test_append_attribute(buffer, attribute->tag, attribute->value);
+    }
+    paradox_test_append_string(buffer, "|");
+    paradox_test_append_slice(buffer, element->value);
+    paradox_test_append_string(buffer, "\n");
+}
+
+// Checks that the links of the tape agree with each other and that every node follows its parent, and counts
+// the nodes reached from node through them.
+static paradox_bool8_t paradox_test_tape_links(const paradox_xml1_tape* tape, const paradox_uint32_t node, paradox_uint64_t* reached)
+{
+    const paradox_xml1_tape_node* element = &tape->nodes[node];
+    const paradox_xml1_slice name = paradox_get_xml1_symbol_name(tape->symbols, element->symbol);
+    if(name.length != element->tag.length || 0 != memcmp(name.data, element->tag.data, name.length)) return PARADOX_FALSE;
+    if(element->attribute_start + element->attribute_count > tape->attribute_count) return PARADOX_FALSE;
+    if(PARADOX_XML1_TAPE_NONE != element->first_child && node + 1 != element->first_child) return PARADOX_FALSE;
+    (*reached)++;
+    for(paradox_uint32_t child = element->first_child; PARADOX_XML1_TAPE_NONE != child; child = tape->nodes[child].next_sibling)
+    {
+        if(node != tape->nodes[child].parent || child <= node) return PARADOX_FALSE;
+        if(PARADOX_FALSE == paradox_test_tape_links(tape, child, reached)) return PARADOX_FALSE;
+    }
+    return PARADOX_TRUE;
+}
+
+static void paradox_test_tape(void)
+{
+    static paradox_test_buffer buffer;
+    for(int mode = 0; mode < 2; mode++)
+    {
+        paradox_xml1_parser_options options = { 0 };
+        options.mode = 0 == mode ? PARADOX_XML1_PARSE_MODE_RECURSIVE : PARADOX_XML1_PARSE_MODE_INDEXED;
+        for(paradox_uint64_t i = 0; i < PARADOX_TEST_CORPUS_COUNT; i++)
+        {
+            paradox_xml1_tape* tape = NULL;
+            PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_parse_xml1_tape_with_options(paradox_test_corpus[i], strlen(paradox_test_corpus[i]), &options, &tape));
+            if(NULL == tape) continue;
+            buffer.length = 0;
+            buffer.data[0] = '\0';
+            paradox_test_canonical_tape(tape, 0, &buffer);
+            PARADOX_TEST_EXPECT(0 == strcmp(buffer.data, paradox_test_corpus_trees[i]));
+            paradox_uint64_t reached = 0;
+            PARADOX_TEST_EXPECT(PARADOX_XML1_TAPE_NONE == tape->nodes[0].parent);
+            PARADOX_TEST_EXPECT(PARADOX_TRUE == paradox_test_tape_links(tape, 0, &reached));
+            PARADOX_TEST_EXPECT(tape->node_count == reached);
+            paradox_free_xml1_tape(tape);
+        }
+    }
+    const char* invalid = "<?xml version=\"1.1\"?><r><a></b></r>";
+    paradox_xml1_tape* tape = NULL;
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_INVALID_DOCUMENT == paradox_parse_xml1_tape_n(invalid, strlen(invalid), &tape));
+    PARADOX_TEST_EXPECT(NULL == tape);
+}
+
+// Symbols
+
+static void paradox_test_symbols(void)
+{
+    const char* data = "<?xml version=\"1.1\"?><r a='1'><x a='2' b='3'/><x/><a/><r/></r>";
+    paradox_xml1_document* document = NULL;
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_parse_xml1_document_n(data, strlen(data), &document));
+    if(NULL != document)
+    {
+        paradox_xml1_element* root = document->root;
+        paradox_xml1_element* x = root->children;
+        paradox_xml1_element* a = x->next->next;
+        // Elements and attributes of one name share its symbol.
+        PARADOX_TEST_EXPECT(x->symbol == x->next->symbol);
+        PARADOX_TEST_EXPECT(root->symbol == a->next->symbol);
+        PARADOX_TEST_EXPECT(root->attributes->symbol == x->attributes->symbol);
+        PARADOX_TEST_EXPECT(a->symbol == x->attributes->symbol);
+        PARADOX_TEST_EXPECT(root->symbol != x->symbol);
+        PARADOX_TEST_EXPECT(x->symbol == paradox_find_xml1_symbol(document->symbols, "x", 1));
+        PARADOX_TEST_EXPECT(PARADOX_XML1_SYMBOL_NONE == paradox_find_xml1_symbol(document->symbols, "y", 1));
+        PARADOX_TEST_EXPECT(PARADOX_XML1_SYMBOL_NONE == paradox_find_xml1_symbol(document->symbols, "xx", 2));
+        PARADOX_TEST_EXPECT(PARADOX_TRUE == paradox_test_equals(paradox_get_xml1_symbol_name(document->symbols, x->attributes->next->symbol), "b"));
+        PARADOX_TEST_EXPECT(0 == paradox_get_xml1_symbol_name(document->symbols, PARADOX_XML1_SYMBOL_NONE).length);
+        paradox_free_xml1_document(document);
+    }
+
+    // A shared table gives documents and tapes the same ids, and keeps the names after they and their inputs are gone.
+    paradox_xml1_symbol_table* symbols = NULL;
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_create_xml1_symbol_table(&symbols));
+    paradox_xml1_parser_options options = { 0 };
+    options.symbols = symbols;
+    const char* first = "<?xml version=\"1.1\"?><first><n\xC3\xA9 k='v'/></first>";
+    const char* second = "<?xml version=\"1.1\"?><second k='w'><n\xC3\xA9/></second>";
+    char* copy = paradox_test_copy(first, strlen(first));
+    paradox_xml1_document* document_first = NULL;
+    paradox_xml1_document* document_second = NULL;
+    paradox_xml1_tape* tape = NULL;
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_parse_xml1_document_with_options(copy, strlen(first), &options, &document_first));
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_parse_xml1_document_with_options(second, strlen(second), &options, &document_second));
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_parse_xml1_tape_with_options(second, strlen(second), &options, &tape));
+    if(NULL != document_first && NULL != document_second && NULL != tape)
+    {
+        const paradox_uint32_t name = document_first->root->children->symbol;
+        const paradox_uint32_t key = document_first->root->children->attributes->symbol;
+        PARADOX_TEST_EXPECT(symbols == document_first->symbols && symbols == document_second->symbols && symbols == tape->symbols);
+        PARADOX_TEST_EXPECT(name == document_second->root->children->symbol);
+        PARADOX_TEST_EXPECT(key == document_second->root->attributes->symbol);
+        PARADOX_TEST_EXPECT(name == tape->nodes[1].symbol);
+        PARADOX_TEST_EXPECT(key == tape->attributes[0].symbol);
+        PARADOX_TEST_EXPECT(document_second->root->symbol == tape->nodes[0].symbol);
+        paradox_free_xml1_document(document_first);
+        paradox_free_xml1_document(document_second);
+        paradox_free_xml1_tape(tape);
+        free(copy);
+        PARADOX_TEST_EXPECT(PARADOX_TRUE == paradox_test_equals(paradox_get_xml1_symbol_name(symbols, name), "n\xC3\xA9"));
+        PARADOX_TEST_EXPECT(name == paradox_find_xml1_symbol(symbols, "n\xC3\xA9", 3));
+    }
+
+    // Documents parsed into it from several threads at once get the same ids too.
+    static paradox_xml1_slice inputs[64];
+    static paradox_xml1_parser_output outputs[64];
+    for(size_t i = 0; i < 64; i++)
+    {
+        inputs[i].data = 0 == i % 2 ? first : second;
+        inputs[i].length = strlen(inputs[i].data);
+    }
+    options.threads = 4;
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_parse_xml1_documents(inputs, 64, outputs, &options));
+    const paradox_uint32_t name = paradox_find_xml1_symbol(symbols, "n\xC3\xA9", 3);
+    for(size_t i = 0; i < 64; i++)
+    {
+        if(NULL == outputs[i].document) continue;
+        PARADOX_TEST_EXPECT(name == outputs[i].document->root->children->symbol);
+        paradox_free_xml1_document(outputs[i].document);
+    }
+    paradox_free_xml1_symbol_table(symbols);
+
+    // End-tags are matched by their bytes, not only by their length or first byte.
+    const char* mismatched[] =
+    {
+        "<?xml version=\"1.1\"?><ab></ac>",
+        "<?xml version=\"1.1\"?><ab></a>",
+        "<?xml version=\"1.1\"?><a></ab>",
+        "<?xml version=\"1.1\"?><r><x></y></r>"
+    };
+    for(size_t i = 0; i < sizeof(mismatched) / sizeof(mismatched[0]); i++)
+    {
+        document = NULL;
+        PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_INVALID_DOCUMENT == paradox_parse_xml1_document_n(mismatched[i], strlen(mismatched[i]), &document));
+    }
+}
+
+// Attribute Index
+
+static void paradox_test_attribute_index(void)
+{
+    static char data[4096];
+    char name[16];
+    for(int count = 0; count <= 40; count++)
+    {
+        paradox_uint64_t length = (paradox_uint64_t)sprintf(data, "<?xml version=\"1.1\"?><r");
+        for(int i = 0; i < count; i++)
+        {
+            length += (paradox_uint64_t)sprintf(data + length, " a%d='%d'", i, i);
+        }
+        const paradox_uint64_t open = length;
+        length += (paradox_uint64_t)sprintf(data + length, "><missing/></r>");
+        paradox_xml1_document* document = NULL;
+        PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_parse_xml1_document_n(data, length, &document));
+        if(NULL == document) continue;
+        const paradox_xml1_element* root = document->root;
+        PARADOX_TEST_EXPECT((paradox_uint32_t)count == root->attribute_count);
+        PARADOX_TEST_EXPECT((count <= PARADOX_XML1_ATTRIBUTE_LINEAR_MAX) == (NULL == root->attribute_index));
+        if(NULL != root->attribute_index) PARADOX_TEST_EXPECT(0 == (root->attribute_index->mask & (root->attribute_index->mask + 1)) && root->attribute_index->mask + 1 >= 2 * (paradox_uint64_t)count);
+        const paradox_xml1_attribute* attribute = root->attributes;
+        for(int i = 0; i < count; i++, attribute = attribute->next)
+        {
+            const int written = sprintf(name, "a%d", i);
+            PARADOX_TEST_EXPECT(PARADOX_TRUE == paradox_test_equals(attribute->tag, name));
+            PARADOX_TEST_EXPECT(attribute == paradox_find_xml1_attribute(root, attribute->symbol));
+            PARADOX_TEST_EXPECT(attribute == paradox_find_xml1_attribute_by_name(document, root, name, (paradox_uint64_t)written));
+        }
+        // Names the document holds for other reasons, or not at all, find no attribute.
+        PARADOX_TEST_EXPECT(NULL == paradox_find_xml1_attribute(root, root->children->symbol));
+        PARADOX_TEST_EXPECT(NULL == paradox_find_xml1_attribute(root, PARADOX_XML1_SYMBOL_NONE));
+        PARADOX_TEST_EXPECT(NULL == paradox_find_xml1_attribute_by_name(document, root, "missing", 7));
+        PARADOX_TEST_EXPECT(NULL == paradox_find_xml1_attribute_by_name(document, root, "a", 1));
+        paradox_free_xml1_document(document);
+
+        // [WFC: Unique Att Spec] holds however many attributes come before the duplicate.
+        if(0 == count) continue;
+        length = open + (paradox_uint64_t)sprintf(data + open, " a0='x'/>");
+        document = NULL;
+        PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_INVALID_DOCUMENT == paradox_parse_xml1_document_n(data, length, &document));
+        PARADOX_TEST_EXPECT(NULL == document);
+    }
+}
+
+// Lazy Decoding
+
+static void paradox_test_lazy_values(void)
+{
+    const char* data = "<?xml version=\"1.1\"?><r a='x&amp;y&#x41;' b='plain'>t&lt;u&#66;<c>plain</c><d>a<![CDATA[&amp;]]>&amp;</d></r>";
+    paradox_xml1_document* document = NULL;
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_parse_xml1_document_n(data, strlen(data), &document));
+    if(NULL == document) return;
+    paradox_xml1_element* root = document->root;
+    paradox_xml1_attribute* a = root->attributes;
+    paradox_xml1_attribute* b = a->next;
+    paradox_xml1_element* c = root->children;
+    paradox_xml1_element* d = c->next;
+
+    // Until a value is read, it slices the input with its references as written.
+    PARADOX_TEST_EXPECT(PARADOX_TRUE == a->references && PARADOX_TRUE == paradox_test_equals(a->value, "x&amp;y&#x41;"));
+    PARADOX_TEST_EXPECT(a->value.data > data && a->value.data < data + strlen(data));
+    PARADOX_TEST_EXPECT(PARADOX_TRUE == root->references && PARADOX_TRUE == paradox_test_equals(root->value, "t&lt;u&#66;"));
+    PARADOX_TEST_EXPECT(PARADOX_FALSE == b->references && PARADOX_FALSE == c->references);
+
+    // Reading decodes it once; later reads return the same slice.
+    paradox_xml1_slice first;
+    paradox_xml1_slice second;
+    PARADOX_TEST_EXPECT(PARADOX_TRUE == paradox_get_xml1_attribute_value(document, a, &first));
+    PARADOX_TEST_EXPECT(PARADOX_TRUE == paradox_test_equals(first, "x&yA"));
+    PARADOX_TEST_EXPECT(PARADOX_TRUE == paradox_get_xml1_attribute_value(document, a, &second));
+    PARADOX_TEST_EXPECT(first.data == second.data && first.length == second.length);
+    PARADOX_TEST_EXPECT(PARADOX_TRUE == paradox_get_xml1_element_value(document, root, &first));
+    PARADOX_TEST_EXPECT(PARADOX_TRUE == paradox_test_equals(first, "t<uB"));
+    PARADOX_TEST_EXPECT(PARADOX_TRUE == paradox_get_xml1_element_value(document, root, &second));
+    PARADOX_TEST_EXPECT(first.data == second.data && first.length == second.length);
+
+    // Values without references are the input itself.
+    PARADOX_TEST_EXPECT(PARADOX_TRUE == paradox_get_xml1_attribute_value(document, b, &first));
+    PARADOX_TEST_EXPECT(b->value.data == first.data && PARADOX_TRUE == paradox_test_equals(first, "plain"));
+    PARADOX_TEST_EXPECT(PARADOX_TRUE == paradox_get_xml1_element_value(document, c, &first));
+    PARADOX_TEST_EXPECT(c->value.data == first.data && PARADOX_TRUE == paradox_test_equals(first, "plain"));
+
+    // A '&' out of a CDATA section stands for itself next to a reference that is decoded.
+    PARADOX_TEST_EXPECT(PARADOX_TRUE == paradox_get_xml1_element_value(document, d, &first));
+    PARADOX_TEST_EXPECT(PARADOX_TRUE == paradox_test_equals(first, "a&amp;&"));
+    paradox_free_xml1_document(document);
+}
+
+// Character References
+
+static void paradox_test_char_refs(void)
+{
+    static paradox_test_buffer buffer;
+    static char data[256];
+    static char expected[64];
+    const paradox_uint32_t codes[] = { 0x1, 0x9, 0x41, 0x7F, 0x80, 0x7FF, 0x800, 0xD7FF, 0xE000, 0xFFFD, 0x10000, 0x10FFFF };
+    for(size_t i = 0; i < sizeof(codes) / sizeof(codes[0]); i++)
+    {
+        // XML 1.1 allows a reference to a RestrictedChar. Hexadecimal in either case and decimal, with and without leading zeros, all decode to the same bytes.
+        const char* formats[] = { "&#x%X;", "&#x%x;", "&#%u;", "&#x0000%X;", "&#000%u;" };
+        char encoded[8] = { 0 };
+        paradox_test_encode(codes[i], encoded);
+        for(size_t j = 0; j < sizeof(formats) / sizeof(formats[0]); j++)
+        {
+            char reference[32];
+            sprintf(reference, formats[j], codes[i]);
+            paradox_uint64_t length = (paradox_uint64_t)sprintf(data, "<?xml version=\"1.1\"?><r>%s</r>", reference);
+            sprintf(expected, "r|%s\n", encoded);
+            PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_test_tree(data, length, NULL, &buffer));
+            PARADOX_TEST_EXPECT(0 == strcmp(expected, buffer.data));
+            length = (paradox_uint64_t)sprintf(data, "<?xml version=\"1.1\"?><r a='%s'/>", reference);
+            sprintf(expected, "r a=\"%s\"|\n", encoded);
+            PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_test_tree(data, length, NULL, &buffer));
+            PARADOX_TEST_EXPECT(0 == strcmp(expected, buffer.data));
+        }
+    }
+    const char* invalid[] =
+    {
+        "&#0;", "&#x0;", "&#xD800;", "&#xDFFF;", "&#xFFFE;", "&#xFFFF;", "&#x110000;", "&#1114112;",
+        "&#x100000000041;", "&#4294967361;", "&#99999999999999999999999;", "&#xFFFFFFFFFFFFFFFFFF41;", "&#-1;", "&#x;", "&#;"
+    };
+    for(size_t i = 0; i < sizeof(invalid) / sizeof(invalid[0]); i++)
+    {
+        paradox_uint64_t length = (paradox_uint64_t)sprintf(data, "<?xml version=\"1.1\"?><r>%s</r>", invalid[i]);
+        PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_INVALID_DOCUMENT == paradox_test_tree(data, length, NULL, &buffer));
+        length = (paradox_uint64_t)sprintf(data, "<?xml version=\"1.1\"?><r a='%s'/>", invalid[i]);
+        PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_INVALID_DOCUMENT == paradox_test_tree(data, length, NULL, &buffer));
+    }
+}
+
+// Entities
+
+static void paradox_test_entities(void)
+{
+    static paradox_test_buffer buffer;
+    const char* expanded[][2] =
+    {
+        {
+            "<?xml version=\"1.1\"?><!DOCTYPE r [<!ENTITY e \"<p>An ampersand (&#38;#38;) may be escaped numerically (&#38;#38;#38;) or with a general entity (&amp;amp;).</p>\">]><r>&e;</r>",
+            "p|An ampersand (&) may be escaped numerically (&#38;) or with a general entity (&amp;).\nr|\n"
+        },
+        { "<?xml version=\"1.1\"?><!DOCTYPE r [<!ENTITY a 'v&b;'><!ENTITY b 'w'>]><r x='&a;'>&a;&a;</r>", "r x=\"vw\"|vwvw\n" },
+        { "<?xml version=\"1.1\"?><!DOCTYPE r [<!ENTITY a 'one'><!ENTITY a 'two'>]><r>&a;</r>", "r|one\n" },
+        { "<?xml version=\"1.1\"?><!DOCTYPE r [<!ENTITY m '<b>&n;</b>t'><!ENTITY n '<c/>'>]><r>&m;&m;</r>", "c|\nb|\nc|\nb|\nr|tt\n" }
+    };
+    for(size_t i = 0; i < sizeof(expanded) / sizeof(expanded[0]); i++)
+    {
+        const paradox_uint64_t length = strlen(expanded[i][0]);
+        PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_test_tree(expanded[i][0], length, NULL, &buffer));
+        PARADOX_TEST_EXPECT(0 == strcmp(expanded[i][1], buffer.data));
+        PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_test_events_of(expanded[i][0], length, NULL, &buffer));
+        PARADOX_TEST_EXPECT(0 == strcmp(expanded[i][1], buffer.data));
+        PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_test_reader_of(expanded[i][0], length, &buffer));
+        PARADOX_TEST_EXPECT(0 == strcmp(expanded[i][1], buffer.data));
+    }
+    const char* rejected[] =
+    {
+        "<?xml version=\"1.1\"?><!DOCTYPE r [<!ENTITY a '&b;'><!ENTITY b '&a;'>]><r>&a;</r>",
+        "<?xml version=\"1.1\"?><!DOCTYPE r [<!ENTITY a 'x&a;'>]><r>&a;</r>",
+        "<?xml version=\"1.1\"?><!DOCTYPE r [<!ENTITY a '&#60;'>]><r x='&a;'/>",
+        "<?xml version=\"1.1\"?><!DOCTYPE r [<!ENTITY a 'x'>]><r>&b;</r>",
+        "<?xml version=\"1.1\"?><!DOCTYPE r [<!ENTITY a '<b>'>]><r>&a;</b></r>"
+    };
+    for(size_t i = 0; i < sizeof(rejected) / sizeof(rejected[0]); i++)
+    {
+        PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_INVALID_DOCUMENT == paradox_test_tree(rejected[i], strlen(rejected[i]), NULL, &buffer));
+    }
+
+    // An attribute value that refers to entities slices the input until it is first read, and is expanded from the
+    // entities of the document then.
+    const char* lazy = "<?xml version=\"1.1\"?><!DOCTYPE r [<!ENTITY a 'v&b;'><!ENTITY b 'w'>]><r x='&a;&#38;a;&lt;'/>";
+    paradox_xml1_document* document = NULL;
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_parse_xml1_document_n(lazy, strlen(lazy), &document));
+    if(NULL != document)
+    {
+        paradox_xml1_attribute* attribute = document->root->attributes;
+        paradox_xml1_slice value;
+        PARADOX_TEST_EXPECT(strstr(lazy, "&a;&#38;") == attribute->value.data && PARADOX_TRUE == attribute->references);
+        PARADOX_TEST_EXPECT(PARADOX_TRUE == paradox_get_xml1_attribute_value(document, attribute, &value));
+        PARADOX_TEST_EXPECT(6 == value.length && !memcmp("vw&a;<", value.data, 6));
+        paradox_free_xml1_document(document);
+    }
+
+    // Four entities nested in each other take a depth of 4, and ten references of ten bytes 100 bytes.
+    const char* chain = "<?xml version=\"1.1\"?><!DOCTYPE r [<!ENTITY a 'x'><!ENTITY b '&a;'><!ENTITY c '&b;'><!ENTITY d '&c;'>]><r>&d;</r>";
+    const char* ten = "<?xml version=\"1.1\"?><!DOCTYPE r [<!ENTITY a 'xxxxxxxxxx'>]><r>&a;&a;&a;&a;&a;&a;&a;&a;&a;&a;</r>";
+    paradox_xml1_parser_options options = { 0 };
+    options.entity_depth = 3;
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_ENTITY_LIMIT == paradox_test_tree(chain, strlen(chain), &options, &buffer));
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_ENTITY_LIMIT == paradox_test_events_of(chain, strlen(chain), &options, &buffer));
+    options.entity_depth = 4;
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_test_tree(chain, strlen(chain), &options, &buffer));
+    PARADOX_TEST_EXPECT(0 == strcmp("r|x\n", buffer.data));
+    options.entity_depth = 0;
+    options.entity_bytes = 99;
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_ENTITY_LIMIT == paradox_test_tree(ten, strlen(ten), &options, &buffer));
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_ENTITY_LIMIT == paradox_test_events_of(ten, strlen(ten), &options, &buffer));
+    options.entity_bytes = 100;
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_test_tree(ten, strlen(ten), &options, &buffer));
+
+    // A billion laughs stops at the default budget however it is parsed.
+    const char* laughs =
+        "<?xml version=\"1.1\"?><!DOCTYPE r [<!ENTITY a 'aaaaaaaaaa'><!ENTITY b '&a;&a;&a;&a;&a;&a;&a;&a;&a;&a;'>"
+        "<!ENTITY c '&b;&b;&b;&b;&b;&b;&b;&b;&b;&b;'><!ENTITY d '&c;&c;&c;&c;&c;&c;&c;&c;&c;&c;'>"
+        "<!ENTITY e '&d;&d;&d;&d;&d;&d;&d;&d;&d;&d;'><!ENTITY f '&e;&e;&e;&e;&e;&e;&e;&e;&e;&e;'>"
+        "<!ENTITY g '&f;&f;&f;&f;&f;&f;&f;&f;&f;&f;'><!ENTITY h '&g;&g;&g;&g;&g;&g;&g;&g;&g;&g;'>"
+        "<!ENTITY i '&h;&h;&h;&h;&h;&h;&h;&h;&h;&h;'>]><r x='&i;'>&i;</r>";
+    const paradox_uint64_t length = strlen(laughs);
+    paradox_xml1_tape* tape = NULL;
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_ENTITY_LIMIT == paradox_test_tree(laughs, length, NULL, &buffer));
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_ENTITY_LIMIT == paradox_test_events_of(laughs, length, NULL, &buffer));
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_ENTITY_LIMIT == paradox_test_reader_of(laughs, length, &buffer));
+    PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_ENTITY_LIMIT == paradox_parse_xml1_tape_n(laughs, length, &tape));
+    PARADOX_TEST_EXPECT(NULL == tape);
+}
+
+// Content Models
+
+static void paradox_test_content_models(void)
+{
+    static paradox_test_buffer buffer;
+    static char data[1024];
+    const char* sequence = "<!DOCTYPE r [<!ELEMENT r (a,b?,c*)><!ELEMENT a EMPTY><!ELEMENT b EMPTY><!ELEMENT c EMPTY>]>";
+    const char* choice = "<!DOCTYPE r [<!ELEMENT r ((a|b)+,c)><!ELEMENT a EMPTY><!ELEMENT b EMPTY><!ELEMENT c EMPTY>]>";
+    const char* mixed = "<!DOCTYPE r [<!ELEMENT r (#PCDATA|a)*><!ELEMENT a EMPTY><!ELEMENT b EMPTY>]>";
+    const char* ten = "<!DOCTYPE r [<!ELEMENT r (a,a,a,a,a,a,a,a,a,a)><!ELEMENT a EMPTY>]>";
+    const char* accepted[][2] =
+    {
+        { sequence, "<r><a/><c/><c/></r>" },
+        { sequence, "<r><a/><b/></r>" },
+        { sequence, "<r><a/> <!--x--> <?p?>\n</r>" },
+        { choice, "<r><b/><a/><b/><c/></r>" },
+        { mixed, "<r>x<a/>y<a/>&amp;</r>" },
+        { mixed, "<r/>" },
+        { "<!DOCTYPE r [<!ELEMENT r (#PCDATA)>]>", "<r>x&amp;<![CDATA[y]]></r>" },
+        { "<!DOCTYPE r [<!ELEMENT r EMPTY>]>", "<r></r>" },
+        { "<!DOCTYPE r [<!ELEMENT r ANY><!ELEMENT a ANY>]>", "<r>t<a>u<a/></a></r>" },
+        { "<!DOCTYPE r [<!ELEMENT r (a)><!ELEMENT a EMPTY><!ENTITY e '<a/>'>]>", "<r>&e;</r>" },
+        { "<!DOCTYPE r [<!ELEMENT r (a?)*><!ELEMENT a EMPTY>]>", "<r/>" },
+        { ten, "<r><a/><a/><a/><a/><a/><a/><a/><a/><a/><a/></r>" },
+        // Declarations that are not read may declare the elements that are not declared here.
+        { "<!DOCTYPE r [<!ELEMENT r ANY><!ENTITY % p SYSTEM 'x'>%p;]>", "<r><u/></r>" },
+        // Documents without a document type declaration are not checked.
+        { "", "<r><u/></r>" }
+    };
+    const char* rejected[][2] =
+    {
+        { sequence, "<r><b/></r>" },
+        { sequence, "<r><a/><c/><b/></r>" },
+        { sequence, "<r><a/>t</r>" },
+        { choice, "<r><c/></r>" },
+        { choice, "<r><a/></r>" },
+        { mixed, "<r>x<b/></r>" },
+        { "<!DOCTYPE r [<!ELEMENT r (#PCDATA)><!ELEMENT a EMPTY>]>", "<r><a/></r>" },
+        { "<!DOCTYPE r [<!ELEMENT r EMPTY>]>", "<r> </r>" },
+        { "<!DOCTYPE r [<!ELEMENT r EMPTY>]>", "<r><!--c--></r>" },
+        { "<!DOCTYPE r [<!ELEMENT r ANY>]>", "<r><u/></r>" },
+        { "<!DOCTYPE s [<!ELEMENT r ANY><!ELEMENT s ANY>]>", "<r/>" },
+        { "<!DOCTYPE r [<!ELEMENT r (a)><!ELEMENT a EMPTY>]>", "<r><![CDATA[]]><a/></r>" },
+        { "<!DOCTYPE r [<!ELEMENT r (a)><!ELEMENT a EMPTY>]>", "<r>&#32;<a/></r>" },
+        { "<!DOCTYPE r [<!ELEMENT r (a)><!ELEMENT a EMPTY><!ENTITY e '<a/><a/>'>]>", "<r>&e;</r>" },
+        { ten, "<r><a/><a/><a/><a/><a/><a/><a/><a/><a/></r>" }
+    };
+    paradox_xml1_parser_options options = { 0 };
+    options.validate = PARADOX_TRUE;
+    for(size_t i = 0; i < sizeof(accepted) / sizeof(accepted[0]); i++)
+    {
+        const paradox_uint64_t length = (paradox_uint64_t)sprintf(data, "<?xml version=\"1.1\"?>%s%s", accepted[i][0], accepted[i][1]);
+        PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_test_tree(data, length, &options, &buffer));
+        PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_test_events_of(data, length, &options, &buffer));
+    }
+    for(size_t i = 0; i < sizeof(rejected) / sizeof(rejected[0]); i++)
+    {
+        const paradox_uint64_t length = (paradox_uint64_t)sprintf(data, "<?xml version=\"1.1\"?>%s%s", rejected[i][0], rejected[i][1]);
+        PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_INVALID_DOCUMENT == paradox_test_tree(data, length, &options, &buffer));
+        PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_INVALID_DOCUMENT == paradox_test_events_of(data, length, &options, &buffer));
+        // They are well-formed all the same.
+        PARADOX_TEST_EXPECT(PARADOX_XML1_PARSER_SUCCESS == paradox_test_tree(data, length, NULL, &buffer));
+    }
+}
+
+int main(void)
+{
+    paradox_test_arena();
+    paradox_test_document_tree();
+
+    paradox_test_slices();
+    paradox_test_length_delimited();
+    paradox_test_file();
+    paradox_test_events_agree();
+    paradox_test_reader();
+    paradox_test_stream();
+    paradox_test_character_classes();
+    paradox_test_utf8();
+    paradox_test_char_data_kernels();
+    paradox_test_terminator_kernels();
+    paradox_test_validation();
+    paradox_test_kernel_selection();
+    paradox_test_dispatch();
+    paradox_test_productions();
+    paradox_test_indexed();
+    paradox_test_split();
+    paradox_test_batch();
+    paradox_test_tape();
+    paradox_test_symbols();
+    paradox_test_attribute_index();
+    paradox_test_lazy_values();
+    paradox_test_char_refs();
+    paradox_test_entities();
+    paradox_test_content_models();
+    printf("%d failures\n", paradox_test_failures);
+    return 0 == paradox_test_failures ? 0 : 1;
+}